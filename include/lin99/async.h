@@ -0,0 +1,113 @@
+/*
+ * async.h
+ *
+ * An asynchronous executor for overlapping lin99 calls with other work.
+ *
+ * Features:
+ * - Operations are queued onto lin99-owned executor threads and return a handle at once
+ * - Handles can be polled or waited on, and report the operation's 0/-1 result
+ * - Dependencies between queued operations: an operation starts only after every operation it depends on
+ *   has finished, without the caller having to wait in between
+ * - Independent operations run concurrently, one per executor thread
+ * - Synchronous fallback when lin99 is built without threads: the operation runs inside asyncsubmit
+ *
+ * An operation is any function taking one context pointer and returning 0 on success or -1 on failure,
+ * typically a small wrapper around one or more vct* or mtx* calls.  The context and everything it refers
+ * to must stay valid until the operation has finished.  When a dependency fails, its dependents are not
+ * run and finish with -1 as well.
+ *
+ * Operations that call parallel kernels share the parallel backend (see parallel.h): whichever operation
+ * gets to the worker pool first splits its kernel across it, while kernels of operations running alongside
+ * it fall back to running serially on their own executor thread.
+ *
+ * Hungarian Notation Key:
+ * - pa_  : pointer to asynctask_t
+ * - cpa_ : constant array of asynctask_t pointers
+ * - pfn_ : function pointer
+ * - csz_ : const size_t
+ *
+ */
+
+
+#ifndef ASYNC_H_
+#define ASYNC_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Handle to one submitted operation; only ever used through a pointer
+typedef struct __asynctask_t asynctask_t;
+
+/**
+ * asyncthreads - Set the number of executor threads.
+ *
+ * Parameters:
+ *  - csz_Threads: Number of executor threads, or 0 to use pargetthreads() (see parallel.h).
+ *
+ * Waits for every submitted operation to finish, then stops the running executor threads; they are
+ * restarted lazily with the new count.  Must not be called from inside an operation.
+ */
+void asyncthreads(const size_t csz_Threads);
+
+/**
+ * asyncsubmit - Queue an operation to run once its dependencies have finished.
+ *
+ * Parameters:
+ *  - pfn_Operation: Operation to run; its return value becomes the result of the handle.
+ *  - p_Context: Passed through to pfn_Operation untouched.
+ *  - cpa_Depends: Handles of the operations that must finish first, or NULL when csz_Depends is 0.
+ *  - csz_Depends: Number of handles in cpa_Depends.
+ *
+ * The dependency handles are only read during the call and may be released right after it.
+ *
+ * Returns:
+ *  - On success: Handle of the new operation, to be released with asyncrelease
+ *  - On failure: NULL, with nothing queued
+ */
+asynctask_t* asyncsubmit(int (*pfn_Operation)(void*), void* p_Context, asynctask_t* const* cpa_Depends, const size_t csz_Depends);
+
+/**
+ * asyncpoll - Check whether an operation has finished, without blocking.
+ *
+ * Parameters:
+ *  - pa_Task: Handle from asyncsubmit.
+ *
+ * Returns:
+ *  - 1 when the operation has finished, 0 while it is queued or running
+ *  - -1 on failure
+ */
+int asyncpoll(asynctask_t* pa_Task);
+
+/**
+ * asyncwait - Block until an operation has finished.
+ *
+ * Parameters:
+ *  - pa_Task: Handle from asyncsubmit.
+ *
+ * Must not be called from inside an operation; make the waiting operation depend on pa_Task instead.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1, when the operation failed, one of its dependencies failed, or pa_Task is NULL
+ */
+int asyncwait(asynctask_t* pa_Task);
+
+/**
+ * asyncdrain - Block until every submitted operation has finished.
+ */
+void asyncdrain(void);
+
+/**
+ * asyncrelease - Release a handle.
+ *
+ * Parameters:
+ *  - pa_Task: Handle from asyncsubmit.  NULL is ignored.
+ *
+ * The operation itself still runs to completion if it has not finished yet, and operations depending
+ * on it are unaffected.  The handle must not be used afterwards.
+ */
+void asyncrelease(asynctask_t* pa_Task);
+
+#endif // ASYNC_H_
@@ -0,0 +1,82 @@
+/*
+ * conv.h
+ *
+ * One-dimensional convolution and cross-correlation of TYPE_FP32/TYPE_FP64 vectors.
+ *
+ * Features:
+ * - Full, same and valid output ranges
+ * - A blocked direct kernel for short filters, written so the inner loop compiles to vector multiply-adds
+ * - Block FFT convolution for long filters, on an in-library radix-2 FFT with no external dependencies
+ * - Output split across the parallel backend (see parallel.h)
+ * - Scratch memory taken from the result vector's pfn_Allocate/pfn_Free
+ *
+ * The full convolution of a signal x of length N with a filter h of length K has N + K - 1 elements,
+ * y[n] = sum over j of x[n - j] * h[j].  The full cross-correlation has the same length and slides the
+ * template without flipping it, r[n] = sum over j of x[n + j - (K - 1)] * t[j], so r[K - 1] lines t up with
+ * the start of x.  The other modes return a contiguous part of the full result:
+ * - CONV_MODE_FULL: all N + K - 1 elements
+ * - CONV_MODE_SAME: N elements starting at (K - 1) / 2, centred on the signal
+ * - CONV_MODE_VALID: the max(N, K) - min(N, K) + 1 elements where one operand lies entirely inside the other
+ *
+ * The FFT path rounds differently from the direct one: results agree to within a few units of the type's
+ * precision relative to the magnitude of the operands, not bit for bit.
+ *
+ * Hungarian Notation Key:
+ * - pv_  : pointer to vector_t
+ * - cpv_ : const pointer to vector_t
+ * - cs32_: const 32-bit signed integer
+ *
+ */
+
+
+#ifndef CONV_H_
+#define CONV_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+
+// Output ranges accepted by vctconv and vctcorr
+#define CONV_MODE_FULL  	0
+#define CONV_MODE_SAME  	1
+#define CONV_MODE_VALID 	2
+
+/**
+ * vctconv - Convolve a signal with a filter.
+ *
+ * Parameters:
+ *  - pv_Result: Pointer to a vector_t of the same type holding exactly as many elements as the mode produces.
+ *  - cpv_Signal: Constant pointer to the signal x.
+ *  - cpv_Filter: Constant pointer to the filter h.
+ *  - cs32_Mode: CONV_MODE_FULL, CONV_MODE_SAME or CONV_MODE_VALID.
+ *
+ * The result must not share storage with either operand.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctconv(vector_t* pv_Result, const vector_t* cpv_Signal, const vector_t* cpv_Filter, const int cs32_Mode);
+
+/**
+ * vctcorr - Cross-correlate a signal with a template.
+ *
+ * Parameters:
+ *  - pv_Result: Pointer to a vector_t of the same type holding exactly as many elements as the mode produces.
+ *  - cpv_Signal: Constant pointer to the signal x.
+ *  - cpv_Template: Constant pointer to the template t.
+ *  - cs32_Mode: CONV_MODE_FULL, CONV_MODE_SAME or CONV_MODE_VALID.
+ *
+ * Element k of the valid range is the dot product of t with x[k, k + K) when the template is the shorter operand.
+ * The result must not share storage with either operand.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctcorr(vector_t* pv_Result, const vector_t* cpv_Signal, const vector_t* cpv_Template, const int cs32_Mode);
+
+#endif // CONV_H_
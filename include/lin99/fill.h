@@ -0,0 +1,168 @@
+/*
+ * fill.h
+ *
+ * Bulk initialisation of vectors and matrices.
+ *
+ * Features:
+ * - Constant fills for any element type, copied by width instead of element by element through vctwrite
+ * - Arithmetic sequences (iota) for every built-in type and linspace for TYPE_FP32/TYPE_FP64
+ * - Uniform, normal and raw-bit random fills from a counter-based generator (Philox4x32-10)
+ * - Large buffers split across the parallel backend (see parallel.h)
+ *
+ * Random fills are reproducible: element i always draws from the counters belonging to i under the
+ * given seed, so the result does not depend on the thread count or on how the range was split.  Matrix
+ * elements are numbered in logical column-major order (i + j * sz_Height), so the same seed produces the
+ * same matrix in either layout and with any leading dimension; padding between columns or rows is left
+ * untouched.  A vector filled with a seed matches a packed column-major matrix filled with the same seed.
+ *
+ * Hungarian Notation Key:
+ * - pv_   : pointer to vector_t
+ * - pm_   : pointer to matrix_t
+ * - cu64_ : const 64-bit unsigned integer
+ * - cf64_ : const 64-bit float
+ *
+ */
+
+
+#ifndef FILL_H_
+#define FILL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+#include "matrix.h"
+
+/**
+ * vctfill - Set every element of a vector to the same value.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.
+ *  - cp_Value: Constant pointer to one element of sz_ElementSize bytes.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctfill(vector_t* pv_Vector, const void* cp_Value);
+
+/**
+ * vctiota - Fill a vector with the arithmetic sequence start, start + step, start + 2 * step, ...
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.
+ *  - cp_Start: Constant pointer to the first element.
+ *  - cp_Step: Constant pointer to the difference between consecutive elements.
+ *
+ * Built-in types compute every element directly from its index (wrapping for integers), so the fill
+ * runs in parallel.  Other types are accumulated serially with pfn_ElementAdd.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctiota(vector_t* pv_Vector, const void* cp_Start, const void* cp_Step);
+
+/**
+ * vctlinspace - Fill a TYPE_FP32/TYPE_FP64 vector with evenly spaced values from cf64_Start to cf64_Stop.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.
+ *  - cf64_Start: First element.
+ *  - cf64_Stop: Last element, reproduced exactly.  Ignored for a vector of one element.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctlinspace(vector_t* pv_Vector, const double cf64_Start, const double cf64_Stop);
+
+/**
+ * vctuniform - Fill a TYPE_FP32/TYPE_FP64 vector with uniformly distributed random values.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.
+ *  - cu64_Seed: Generator key; equal seeds give equal vectors.
+ *  - cf64_Low/cf64_High: Bounds of the distribution.  Values lie in [cf64_Low, cf64_High), up to rounding.
+ *
+ * TYPE_FP32 elements take 24 random bits each and TYPE_FP64 elements 53.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctuniform(vector_t* pv_Vector, const uint64_t cu64_Seed, const double cf64_Low, const double cf64_High);
+
+/**
+ * vctnormal - Fill a TYPE_FP32/TYPE_FP64 vector with normally distributed random values.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.
+ *  - cu64_Seed: Generator key; equal seeds give equal vectors.
+ *  - cf64_Mean: Mean of the distribution.
+ *  - cf64_Deviation: Standard deviation of the distribution.
+ *
+ * Elements are produced in pairs by the Box-Muller transform.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctnormal(vector_t* pv_Vector, const uint64_t cu64_Seed, const double cf64_Mean, const double cf64_Deviation);
+
+/**
+ * vctrandom - Fill every byte of a vector's elements with random bits.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being filled.  Any element type is accepted.
+ *  - cu64_Seed: Generator key; equal seeds give equal vectors.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctrandom(vector_t* pv_Vector, const uint64_t cu64_Seed);
+
+/**
+ * mtxfill - Set every element of a matrix to the same value.
+ *
+ * Parameters:
+ *  - pm_Matrix: Pointer to the matrix_t being filled.
+ *  - cp_Value: Constant pointer to one element of sz_ElementSize bytes.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxfill(matrix_t* pm_Matrix, const void* cp_Value);
+
+/**
+ * mtxuniform - Fill a TYPE_FP32/TYPE_FP64 matrix with uniformly distributed random values (see vctuniform).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxuniform(matrix_t* pm_Matrix, const uint64_t cu64_Seed, const double cf64_Low, const double cf64_High);
+
+/**
+ * mtxnormal - Fill a TYPE_FP32/TYPE_FP64 matrix with normally distributed random values (see vctnormal).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxnormal(matrix_t* pm_Matrix, const uint64_t cu64_Seed, const double cf64_Mean, const double cf64_Deviation);
+
+/**
+ * mtxrandom - Fill every byte of a matrix's elements with random bits (see vctrandom).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxrandom(matrix_t* pm_Matrix, const uint64_t cu64_Seed);
+
+#endif // FILL_H_
@@ -12,6 +12,8 @@
  * - Type-generic matrix representation using void pointers
  * - Element-wise operations (addition, subtraction, multiplication, division)
  * - Determinants, inverses, and transposes
+ * - Unrolled 2x2, 3x3 and 4x4 kernels on plain arrays, single or batched
+ * - Column-major or row-major storage, with an optional leading dimension for padded or borrowed buffers
  * - Custom memory management and arithmetic logic via function pointers
  *
  * This design allows support for multiple numerical types (e.g., float, int, double)
@@ -69,6 +71,14 @@
  * For an example of how arithmetic callbacks should be written, please see the GENERAL_OP_DEFINITION macro
  */
 
+// Storage orders accepted in matrix_t.s32_Layout; zero-initialized matrices are column-major
+#define MATRIX_LAYOUT_COLUMN_MAJOR	0
+#define MATRIX_LAYOUT_ROW_MAJOR   	1
+
+// Triangles of a symmetric matrix selectable by mtxsyrk
+#define MATRIX_TRIANGLE_UPPER     	0
+#define MATRIX_TRIANGLE_LOWER     	1
+
 /**
  * matrix_t - Generic matrix-style container with generic element arithmetic and memory operations.
  *
@@ -80,8 +90,17 @@
  * - sz_Width: Width of matrix.
  * - sz_Height: Height of matrix.
  * - sz_ElementCount: Total number of elements in matrix, calculated as sz_Height * sz_Width;
- * - pfn_ElementAdd/pfn_ElementSubtract/pfn_ElementMultiply/pfn_ElementDivide: User-provided function callbacks for arithmetic operations (may be done easily with provided macros).
- * - pfn_Allocate/pfn_Free: User-provided memory allocation callbacks that may be either automatically filled by vctcreate or manually-set to use custom memory allocation tools.
+ * - s32_Layout: MATRIX_LAYOUT_COLUMN_MAJOR (element (row, col) at row + ld * col) or MATRIX_LAYOUT_ROW_MAJOR
+ *   (at row * ld + col).
+ * - sz_LeadingDim: Distance, in elements, between consecutive columns (column-major) or rows (row-major).
+ *   0 means packed.
+ * - s32_Borrowed: Non-zero when p_StorageBuffer was provided through mtxwrap and is not freed by mtxdstry.
+ * - psz_References: Count of the matrices sharing p_StorageBuffer after mtxclone, or NULL while this matrix
+ *   is its only owner.
+ * - pfn_ElementAdd/pfn_ElementSubtract/pfn_ElementMultiply/pfn_ElementDivide: User-provided function
+ *   callbacks for arithmetic operations (may be done easily with provided macros).
+ * - pfn_Allocate/pfn_Free: User-provided memory allocation callbacks that may be either automatically filled
+ *   by vctcreate or manually-set to use custom memory allocation tools.
  */
 typedef struct __matrix_t {
 	TYPE s32_Type;
@@ -93,6 +112,11 @@ typedef struct __matrix_t {
 	size_t sz_Height;
 	size_t sz_ElementCount;
 
+	int s32_Layout;
+	size_t sz_LeadingDim;
+	int s32_Borrowed;
+	size_t* psz_References;
+
 	void (*pfn_ElementAdd)(void*, const void*, const void*);
 	void (*pfn_ElementSubtract)(void*, const void*, const void*);
 	void (*pfn_ElementMultiply)(void*, const void*, const void*);
@@ -111,12 +135,61 @@ typedef struct __matrix_t {
  * - pfn_AllocateMemory: Callback function to memory allocation.
  * - pfn_FreeMemory: Callback function to memory deallocation.
  *
+ * s32_Layout and sz_LeadingDim are honoured if set beforehand; a zero sz_LeadingDim is replaced by the packed value.
+ *
  * Returns:
  * - On success: 0
  * - On failure: -1
  */
 int mtxcreate(matrix_t* pm_Matrix, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*));
 
+/**
+ * mtxwrap - Use an existing buffer as the storage of a matrix_t without copying it.
+ *
+ * Parameters:
+ * - pm_Matrix: Pointer to a matrix_t with its type, sizes, dimensions, layout and callbacks already set, as for mtxcreate.
+ * - p_Buffer: Address of the caller's data, laid out as described by s32_Layout and sz_LeadingDim.
+ * - pfn_AllocateMemory/pfn_FreeMemory: Callbacks used for scratch memory by operations on the matrix, or NULL
+ *   to keep the callbacks already set on pm_Matrix (calloc/free when those are NULL too).
+ *
+ * The buffer stays owned by the caller: mtxdstry leaves it alone and it must outlive the matrix.
+ * A row-major C array float a[h][w] is wrapped with s32_Layout = MATRIX_LAYOUT_ROW_MAJOR and no copy.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1
+ */
+int mtxwrap(matrix_t* pm_Matrix, void* p_Buffer, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*));
+
+/**
+ * mtxclone - Make a matrix sharing the storage of another until either of them is written to (see vctclone).
+ *
+ * Parameters:
+ * - pm_Clone: Pointer to the matrix_t receiving the clone.  Any previous contents are overwritten, not destroyed.
+ * - pm_Source: Pointer to the matrix_t being cloned.  Only its sharing bookkeeping is modified.
+ *
+ * The clone keeps the layout and leading dimension of the source.  A wrapped source (see mtxwrap) is copied
+ * into a buffer from pfn_Allocate right away, since its owner may change it behind the library's back.
+ * Each clone must be released with mtxdstry.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1
+ */
+int mtxclone(matrix_t* pm_Clone, matrix_t* pm_Source);
+
+/**
+ * mtxunique - Give a matrix its own copy of its storage if the buffer is shared with a clone (see vctunique).
+ *
+ * Parameters:
+ * - pm_Matrix: Pointer to the matrix_t about to be written to.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1, with the buffer still shared
+ */
+int mtxunique(matrix_t* pm_Matrix);
+
 /**
  * MAKE_MATRIX - Macro designed to streamline the process of creating matrix_t types.
  *
@@ -154,7 +227,8 @@ mtxcreate(&name, NULL, NULL);
  * Recommendations:
  *  - Use the associated USE_ARITHMETIC_OP_SET_* macro to avoid the need to type all operation implementations.
  */
-#define MAKE_MATRIX_FAST(name, type, width, height, abbr) MAKE_MATRIX(name, type, width, height, TYPE_##abbr, Add##abbr, Subtract##abbr, Multiply##abbr, Divide##abbr)
+#define MAKE_MATRIX_FAST(name, type, width, height, abbr) \
+	MAKE_MATRIX(name, type, width, height, TYPE_##abbr, Add##abbr, Subtract##abbr, Multiply##abbr, Divide##abbr)
 
 
 /**
@@ -170,6 +244,8 @@ mtxcreate(&name, NULL, NULL);
  *  - cpm_Matrix->sz_Height
  * 	- cpm_Matrix->sz_ElementCount
  *	- cpm_Matrix->sz_BufferSize
+ *	- cpm_Matrix->s32_Layout
+ *	- cpm_Matrix->sz_LeadingDim
  *	- cpm_Matrix->s32_Type
  * 	- cpm_Matrix->pfn_Allocate
  *	- cpm_Matrix->pfn_Free
@@ -188,6 +264,8 @@ int mtxmemchk(const matrix_t* cpm_Matrix);
  *  - p_Destination: Address of the read value is copied to.
  *  - cpm_Matrix: Constant pointer to a matrix_t type that vctread copies data from.
  *  - csz_RawIdx: Direct value of local address in memory, allows for easy iteration through all elements of matrix.
+ *
+ * Raw indices follow the storage order, so they include any padding introduced by sz_LeadingDim.
  */
 void mtxreadraw(void* p_Destination, const matrix_t* cpm_Matrix, const size_t csz_RawIdx);
 
@@ -202,10 +280,18 @@ void mtxreadraw(void* p_Destination, const matrix_t* cpm_Matrix, const size_t cs
  */
 void mtxread(void* p_Destination, const matrix_t* cpm_Matrix, const size_t csz_RowIdx, const size_t csz_ColIdx);
 
-// Add mtxwriteraw here
+/**
+ * mtxwriteraw - Copy data from a provided address to an element labeled by a raw index.
+ *
+ * Parameters:
+ *  - pm_Matrix: Pointer to the matrix_t that is written to by mtxwriteraw.
+ *  - csz_RawIdx: Storage-order index of the element, as accepted by mtxreadraw.
+ *  - p_Data: Address in memory that mtxwriteraw copies from.
+ */
+void mtxwriteraw(matrix_t* pm_Matrix, const size_t csz_RawIdx, void* p_Data);
 
 /**
- * vctwrite - Copy data from a provided address to an element in the vector.
+ * mtxwrite - Copy data from a provided address to an element in the matrix.
  *
  * Parameters:
  *  - pm_Matrix: Pointer to the matrix_t that is written to by mtxwrite.
@@ -217,11 +303,194 @@ void mtxwrite(matrix_t* pm_Matrix, const size_t csz_RowIdx, const size_t csz_Col
 
 // OPERATORS GO HERE //
 
+/**
+ * mtxmul - Matrix product C = A * B for any combination of storage layouts.
+ *
+ * Parameters:
+ *  - pm_Result: Pointer to a cpm_A->sz_Height x cpm_B->sz_Width matrix_t that receives the product.  Must not share storage with either operand.
+ *  - cpm_A/cpm_B: Constant pointers to the operands; cpm_A->sz_Width must equal cpm_B->sz_Height.
+ *
+ * TYPE_FP32 and TYPE_FP64 use the blocked native kernels, which read a row-major operand as the transpose
+ * of a column-major one, so no layout is ever copied.  Other types go through the element callbacks with the
+ * loop order chosen so the innermost loop walks contiguous memory of the result whenever possible.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxmul(matrix_t* pm_Result, const matrix_t* cpm_A, const matrix_t* cpm_B);
+
+/**
+ * mtxmulvct - Matrix-vector product y = A * x.
+ *
+ * Parameters:
+ *  - pv_Result: Pointer to a vector_t with cpm_Matrix->sz_Height elements that receives y.  Must not share storage with the operands.
+ *  - cpm_Matrix: Constant pointer to the matrix_t A, in either layout.
+ *  - cpv_Vector: Constant pointer to a vector_t x with cpm_Matrix->sz_Width elements.
+ *
+ * Column-major matrices are streamed one column at a time (axpy order) and row-major matrices one row at a time (dot order).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxmulvct(vector_t* pv_Result, const matrix_t* cpm_Matrix, const vector_t* cpv_Vector);
+
+/**
+ * mtxtrans - Copy the transpose of a matrix into another matrix.
+ *
+ * Parameters:
+ *  - pm_Result: Pointer to a cpm_Source->sz_Width x cpm_Source->sz_Height matrix_t of the same type, in either layout.
+ *  - cpm_Source: Constant pointer to the matrix_t being transposed.  Must not share storage with pm_Result.
+ *
+ * The copy is done in square tiles so both sides are touched a cache line at a time.  When a copy is not
+ * needed, a transposed view is free: swap sz_Width and sz_Height and flip s32_Layout, keeping sz_LeadingDim.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxtrans(matrix_t* pm_Result, const matrix_t* cpm_Source);
+
+/**
+ * vctouter - Outer product R = x * y^T.
+ *
+ * Parameters:
+ *  - pm_Result: Pointer to a cpv_X->sz_ElementCount x cpv_Y->sz_ElementCount matrix_t, in either layout, that receives the product.
+ *  - cpv_X/cpv_Y: Constant pointers to vectors of the matrix's type.  Neither may share storage with pm_Result.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctouter(matrix_t* pm_Result, const vector_t* cpv_X, const vector_t* cpv_Y);
+
+/**
+ * mtxger - In-place rank-1 update A += alpha * x * y^T.
+ *
+ * Parameters:
+ *  - pm_Matrix: Pointer to the sz_Height x sz_Width matrix_t A being updated, in either layout.
+ *  - cp_Alpha: Address of the scale, read as the matrix element type.
+ *  - cpv_X/cpv_Y: Constant pointers to vectors with sz_Height and sz_Width elements.  Neither may share storage with pm_Matrix.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxger(matrix_t* pm_Matrix, const void* cp_Alpha, const vector_t* cpv_X, const vector_t* cpv_Y);
+
+/**
+ * mtxsyrk - Symmetric rank-k update C += alpha * X * X^T, computed on one triangle only.
+ *
+ * Parameters:
+ *  - pm_Matrix: Pointer to the n x n matrix_t C being updated, in either layout.
+ *  - cs32_Triangle: MATRIX_TRIANGLE_UPPER or MATRIX_TRIANGLE_LOWER; the other triangle is left untouched.
+ *  - cp_Alpha: Address of the scale, read as the matrix element type.
+ *  - cpm_Samples: Constant pointer to the n x k matrix_t X holding one sample per column.  Must not share storage with pm_Matrix.
+ *
+ * Accumulating a batch of k samples this way builds a scatter (covariance) matrix at the speed of the native GEMM
+ * for TYPE_FP32 and TYPE_FP64: each block column of the triangle is a single GEMM, plus a small one for the diagonal
+ * block.  Other types fall back on the element callbacks.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxsyrk(matrix_t* pm_Matrix, const int cs32_Triangle, const void* cp_Alpha, const matrix_t* cpm_Samples);
+
+/**
+ * mtxqr - In-place Householder QR decomposition of a TYPE_FP32 or TYPE_FP64 matrix.
+ *
+ * Parameters:
+ *  - pm_Matrix: Pointer to the matrix_t being factored.
+ *  - p_Tau: Destination for min(sz_Height, sz_Width) reflector scales, read as the matrix element type.
+ *
+ * On return the upper triangle holds R and the entries below the diagonal hold the Householder vectors,
+ * with Q = H_0 * H_1 * ... and H_i = I - p_Tau[i] * v_i * v_i^T (v_i[i] = 1 implied), as in LAPACK's geqrf.
+ * Reflectors are applied in blocks using the compact WY representation.  The matrix must be column-major.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxqr(matrix_t* pm_Matrix, void* p_Tau);
+
+/**
+ * mtxtsqr - R factor of a tall TYPE_FP32 or TYPE_FP64 matrix using tall-skinny QR.
+ *
+ * Parameters:
+ *  - pm_R: Pointer to a sz_Width x sz_Width matrix_t of the same type that receives R (zero below the diagonal).
+ *  - cpm_A: Constant pointer to the matrix_t being factored; requires sz_Height >= sz_Width.  It is not modified.
+ *
+ * Blocks of rows are reduced independently on the parallel backend and their R factors are combined at the end.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxtsqr(matrix_t* pm_R, const matrix_t* cpm_A);
+
+/**
+ * mtxlstsq - Least-squares solution of an overdetermined system A X = B.
+ *
+ * Parameters:
+ *  - pm_X: Pointer to a cpm_A->sz_Width x cpm_B->sz_Width matrix_t that receives X.
+ *  - cpm_A: Constant pointer to a TYPE_FP32 or TYPE_FP64 matrix_t with sz_Height >= sz_Width and full column rank.
+ *  - cpm_B: Constant pointer to a matrix_t of the same type and height holding one right-hand side per column.
+ *
+ * Solved through the same TSQR reduction as mtxtsqr, applied to [A | B], followed by back substitution.
+ * Neither cpm_A nor cpm_B is modified.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure (including a rank-deficient cpm_A, i.e. some |R_ii| <= max(m, n) * eps * max|R_jj|): -1
+ */
+int mtxlstsq(matrix_t* pm_X, const matrix_t* cpm_A, const matrix_t* cpm_B);
+
+/**
+ * TINY_OP_DEC - Declares the fixed-size kernels for one order n (2, 3 or 4) and floating point type.
+ *
+ * These work on plain arrays instead of matrix_t: a matrix is n * n consecutive elements in column-major
+ * order (the layout of a packed column-major matrix_t) and a vector is n consecutive elements.  Every
+ * formula is fully unrolled, with no allocation, callbacks or index arithmetic.
+ *
+ * Single calls, which perform no checks and may use the same array for input and output:
+ *  - mtx<n>mul<abbr>(p_C, cp_A, cp_B): C = A * B.
+ *  - mtx<n>mulvct<abbr>(p_Y, cp_A, cp_X): y = A * x.
+ *  - mtx<n>det<abbr>(cp_A): Returns det(A).
+ *  - mtx<n>inv<abbr>(p_Inverse, cp_A): Inverse of A.  Returns 0, or -1 when A is singular, in which case
+ *    the inverse is written as zeros.
+ *
+ * Batched calls apply the same operation to csz_Count operands stored back to back and split large batches
+ * across the parallel backend.  Determinants and inverses are computed in groups of matrices so that their
+ * arithmetic vectorises across matrices.  Outputs may coincide with an input but must not partially overlap one.  They return
+ * 0, or -1 on a NULL argument, when the parallel backend fails or, for mtx<n>invbatch<abbr>, when any matrix was singular (its inverse is
+ * written as zeros and the others are still computed).
+ */
+#define TINY_OP_DEC(n, type, abbr) \
+void mtx##n##mul##abbr(type* p_C, const type* cp_A, const type* cp_B); \
+void mtx##n##mulvct##abbr(type* p_Y, const type* cp_A, const type* cp_X); \
+type mtx##n##det##abbr(const type* cp_A); \
+int mtx##n##inv##abbr(type* p_Inverse, const type* cp_A); \
+int mtx##n##mulbatch##abbr(type* p_C, const type* cp_A, const type* cp_B, const size_t csz_Count); \
+int mtx##n##mulvctbatch##abbr(type* p_Y, const type* cp_A, const type* cp_X, const size_t csz_Count); \
+int mtx##n##detbatch##abbr(type* p_Det, const type* cp_A, const size_t csz_Count); \
+int mtx##n##invbatch##abbr(type* p_Inverse, const type* cp_A, const size_t csz_Count);
+
+TINY_OP_DEC(2, float, FP32)
+TINY_OP_DEC(3, float, FP32)
+TINY_OP_DEC(4, float, FP32)
+TINY_OP_DEC(2, double, FP64)
+TINY_OP_DEC(3, double, FP64)
+TINY_OP_DEC(4, double, FP64)
+
 /**
  * mtxdstry - Deallocates a matrix and its internal buffer using its designated pfn_Free member.
  *
  * Parameters:
  * - pm_Matrix: pointer to matrix_t to be freed
+ *
+ * Buffers attached with mtxwrap are left to their owner.  A buffer shared through mtxclone only loses one reference.
  */
 void mtxdstry(matrix_t* pm_Matrix);
 
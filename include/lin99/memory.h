@@ -0,0 +1,159 @@
+/*
+ * memory.h
+ *
+ * Allocation callback sets for vector_t and matrix_t beyond the default calloc/free pair.
+ *
+ * Features:
+ * - A growable allocator whose large buffers are page mappings, so growing a buffer remaps its
+ *   pages (mremap on Linux) instead of copying them
+ * - Plain heap fallback for small buffers and for systems without mremap
+ * - NUMA placement policies for large buffers: interleaved across nodes, preferred on the allocating
+ *   thread's node, or first-touched by the parallel backend with the same partition the kernels use
+ *
+ * The functions form one family: memory from mapalloc, maprealloc or any numa* allocator must be released
+ * with mapfree and resized with maprealloc.  Every buffer is zero-filled when first handed out, as with zalloc.
+ *
+ * NUMA policies are applied with the mbind system call directly, so no libnuma is needed.  On systems with
+ * a single node, without NUMA support, or where the kernel refuses the policy (e.g. inside a restricted
+ * container), the numa* allocators behave like mapalloc and the memory is simply placed by the kernel.
+ *
+ * Hungarian Notation Key:
+ * - p_   : pointer to untyped memory
+ * - csz_ : const size_t
+ *
+ */
+
+
+#ifndef MEMORY_H_
+#define MEMORY_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Buffers at least this large are backed by their own page mapping
+#define MAP_THRESHOLD   	(256 * 1024)
+
+/**
+ * mapalloc - Allocate a zero-filled buffer, page-mapped when it is at least MAP_THRESHOLD bytes.
+ *
+ * Parameters:
+ *  - csz_Size: Size of the requested allocation in bytes.
+ *
+ * Returns:
+ *  - On success: Pointer to the beginning of the allocation
+ *  - On failure: NULL
+ */
+void* mapalloc(const size_t csz_Size);
+
+/**
+ * maprealloc - Resize a buffer from mapalloc/maprealloc, keeping its contents up to the smaller size.
+ *
+ * Parameters:
+ *  - p_Buffer: Buffer to resize, or NULL to allocate a new one.
+ *  - csz_OldSize: Size the buffer was requested with (ignored; kept for the vector_t pfn_Reallocate signature).
+ *  - csz_NewSize: Size of the resized buffer in bytes.
+ *
+ * Mapped buffers are grown with mremap where available, which moves page table entries rather than data.
+ *
+ * Returns:
+ *  - On success: Pointer to the resized buffer, which may have moved
+ *  - On failure: NULL, with p_Buffer left intact
+ */
+void* maprealloc(void* p_Buffer, const size_t csz_OldSize, const size_t csz_NewSize);
+
+/**
+ * mapfree - Release a buffer from mapalloc/maprealloc.
+ *
+ * Parameters:
+ *  - p_Buffer: Buffer to release.  NULL is ignored.
+ */
+void mapfree(void* p_Buffer);
+
+/**
+ * USE_MAP_ALLOCATOR - Attach the mapalloc/maprealloc/mapfree set to a vector_t before vctcreate.
+ *
+ * Parameters:
+ *  - vector: The vector_t variable (not a pointer).
+ */
+#define USE_MAP_ALLOCATOR(vector) \
+(vector).pfn_Allocate   	= mapalloc; \
+(vector).pfn_Free       	= mapfree; \
+(vector).pfn_Reallocate 	= maprealloc;
+
+/**
+ * numanodes - Number of online NUMA nodes.
+ *
+ * Returns:
+ *  - Node count, 1 when the system has no NUMA topology to report
+ */
+size_t numanodes(void);
+
+/**
+ * numainterleave - Allocate a zero-filled buffer whose pages are spread round-robin over every online node.
+ *
+ * Parameters:
+ *  - csz_Size: Size of the requested allocation in bytes.
+ *
+ * Suits buffers read by every thread, such as a shared right-hand side or lookup table.
+ *
+ * Returns:
+ *  - On success: Pointer to the beginning of the allocation
+ *  - On failure: NULL
+ */
+void* numainterleave(const size_t csz_Size);
+
+/**
+ * numalocal - Allocate a zero-filled buffer whose pages prefer the node of the calling thread.
+ *
+ * Parameters:
+ *  - csz_Size: Size of the requested allocation in bytes.
+ *
+ * Pages land on the calling thread's node whichever thread touches them first, falling back to other
+ * nodes only when that node runs out of memory.
+ *
+ * Returns:
+ *  - On success: Pointer to the beginning of the allocation
+ *  - On failure: NULL
+ */
+void* numalocal(const size_t csz_Size);
+
+/**
+ * numatouch - Allocate a zero-filled buffer faulted in by the parallel backend, chunk by chunk.
+ *
+ * Parameters:
+ *  - csz_Size: Size of the requested allocation in bytes.
+ *
+ * The buffer is split into the pargetthreads() chunks parfor gives any large element-wise kernel over
+ * it, and each chunk touches its own pages, so under the default first-touch policy every page lands on
+ * the node of the thread that will later process it.  Combine with parbind(PAR_BIND_NODES) so that thread stays on its
+ * node.  Must not be called from inside a parfor chunk, where the touch would run serially.
+ *
+ * Returns:
+ *  - On success: Pointer to the beginning of the allocation
+ *  - On failure: NULL
+ */
+void* numatouch(const size_t csz_Size);
+
+/**
+ * USE_NUMA_INTERLEAVE/USE_NUMA_LOCAL/USE_NUMA_TOUCH - Attach a NUMA allocator to a vector_t or matrix_t before creation.
+ *
+ * Parameters:
+ *  - object: The vector_t or matrix_t variable (not a pointer).
+ *
+ * Vectors that should also grow by remapping may additionally set pfn_Reallocate to maprealloc.
+ */
+#define USE_NUMA_INTERLEAVE(object) \
+(object).pfn_Allocate   	= numainterleave; \
+(object).pfn_Free       	= mapfree;
+
+#define USE_NUMA_LOCAL(object) \
+(object).pfn_Allocate   	= numalocal; \
+(object).pfn_Free       	= mapfree;
+
+#define USE_NUMA_TOUCH(object) \
+(object).pfn_Allocate   	= numatouch; \
+(object).pfn_Free       	= mapfree;
+
+#endif // MEMORY_H_
@@ -0,0 +1,114 @@
+/*
+ * parallel.h
+ *
+ * A small fork-join backend used by the threaded lin99 kernels.
+ *
+ * Features:
+ * - Persistent worker threads, started on first use and reused by every parallel call
+ * - Static, deterministic partitioning of an index range into contiguous chunks
+ * - Serial fallback when lin99 is built without threads, when only one thread is configured,
+ *   or when a parallel call is made while the workers are already busy (e.g. from inside a chunk)
+ *
+ * Chunk c of a range always covers the same indices for a given chunk count, whether it runs on
+ * a worker or serially, so kernels can rely on the partition for reproducibility and data placement.
+ * With parbind(PAR_BIND_NODES), the worker running chunk c is also pinned to a fixed NUMA node, so
+ * memory first touched by chunk c (see numatouch in memory.h) stays local to every later chunk c.
+ *
+ * Hungarian Notation Key:
+ * - psz_ : pointer to size_t
+ * - csz_ : const size_t
+ * - pfn_ : function pointer
+ * - cs32_: const 32-bit signed integer
+ *
+ */
+
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Upper bound on the number of chunks (and therefore threads) used by a single parallel call
+#define PAR_MAX_THREADS 	256
+
+// Worker placement modes accepted by parbind
+#define PAR_BIND_NONE   	0	// Workers run wherever the scheduler puts them
+#define PAR_BIND_NODES  	1	// Workers are pinned to NUMA nodes in chunk order
+
+/**
+ * parthreads - Set the number of threads used by parallel kernels.
+ *
+ * Parameters:
+ *  - csz_Threads: Thread count including the calling thread, or 0 to use every online processor.
+ *
+ * Running workers are stopped and restarted lazily with the new count.  Must not be called while a
+ * parallel call is in flight.
+ */
+void parthreads(const size_t csz_Threads);
+
+/**
+ * parbind - Choose how worker threads are placed on the machine.
+ *
+ * Parameters:
+ *  - cs32_Mode: PAR_BIND_NONE or PAR_BIND_NODES.
+ *
+ * With PAR_BIND_NODES, of T = pargetthreads() threads spread over N online nodes, the worker running
+ * chunk c is restricted to the CPUs of node c * N / T, so consecutive chunks share a node and every node
+ * gets an equal share.  The calling thread runs chunk 0 and is never moved; keep it on the first node.
+ * On systems without NUMA topology, or where affinity cannot be set, workers are left unbound.  Running
+ * workers are restarted lazily, as with parthreads, and the same restriction on in-flight calls applies.
+ */
+void parbind(const int cs32_Mode);
+
+/**
+ * pargetthreads - Get the number of threads parallel kernels will use.
+ *
+ * Returns:
+ *  - Thread count including the calling thread (always 1 when built without threads)
+ */
+size_t pargetthreads(void);
+
+/**
+ * parchunks - Number of chunks parfor splits a range into.
+ *
+ * Parameters:
+ *  - csz_Count: Length of the index range.
+ *  - csz_Grain: Minimum number of indices worth handing to one thread (0 is read as 1).
+ *
+ * Returns:
+ *  - A chunk count between 1 and pargetthreads(), or 0 for an empty range
+ */
+size_t parchunks(const size_t csz_Count, const size_t csz_Grain);
+
+/**
+ * parrange - Indices covered by one chunk of a range.
+ *
+ * Parameters:
+ *  - psz_Begin/psz_End: Destination for the half-open range [*psz_Begin, *psz_End).
+ *  - csz_Count: Length of the index range.
+ *  - csz_Chunks: Number of chunks the range is split into.
+ *  - csz_Chunk: Index of the chunk, less than csz_Chunks.
+ */
+void parrange(size_t* psz_Begin, size_t* psz_End, const size_t csz_Count, const size_t csz_Chunks, const size_t csz_Chunk);
+
+/**
+ * parfor - Run a callback over a range split into parchunks(csz_Count, csz_Grain) chunks.
+ *
+ * Parameters:
+ *  - csz_Count: Length of the index range.
+ *  - csz_Grain: Minimum number of indices worth handing to one thread.
+ *  - pfn_Body: Callback receiving the context, the chunk index and the chunk's half-open index range.
+ *  - p_Context: Passed through to pfn_Body untouched.
+ *
+ * The calling thread runs chunk 0 and returns once every chunk has finished.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int parfor(const size_t csz_Count, const size_t csz_Grain, void (*pfn_Body)(void*, size_t, size_t, size_t), void* p_Context);
+
+#endif // PARALLEL_H_
@@ -0,0 +1,113 @@
+/*
+ * plan.h
+ *
+ * Prepared element-wise operations for vector_t.
+ *
+ * Features:
+ * - Operand validation and kernel selection done once, at plan creation
+ * - Type-specialised kernels for the built-in TYPE_* values, saturating/checked integer kernels
+ *   for vectors using a non-wrapping s32_IntegerMode, and a callback kernel for everything else
+ * - Large operands split across the parallel backend (see parallel.h)
+ *
+ * A plan is a plain value: it owns no memory, may be copied freely and needs no destruction.  It can
+ * be executed on any vectors with the same type, length, callbacks and result integer mode as the ones
+ * it was created for.  vctplanexec performs no checks at all, so executing a plan on other operands
+ * is undefined.
+ *
+ * The built-in kernels assume the callbacks of a built-in TYPE_* vector perform the arithmetic of the
+ * matching USE_ARITHMETIC_OP_SET_* macro.  Vectors that reuse a built-in type enum for other
+ * arithmetic should pass PLAN_FLAG_CALLBACK.
+ *
+ * Hungarian Notation Key:
+ * - pv_   : pointer to vector_t
+ * - cpv_  : const pointer to vector_t
+ * - pvp_  : pointer to vctplan_t
+ * - cpvp_ : const pointer to vctplan_t
+ * - cs32_ : const 32-bit signed integer
+ *
+ */
+
+
+#ifndef PLAN_H_
+#define PLAN_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+
+// Operations a plan can prepare, matching vctadd/vctsub/vctelemul/vctelediv
+#define PLAN_OP_ADD     	0
+#define PLAN_OP_SUB     	1
+#define PLAN_OP_MUL     	2
+#define PLAN_OP_DIV     	3
+
+// Flags accepted by vctplancreate, combined with |
+#define PLAN_FLAG_NONE  	0
+#define PLAN_FLAG_CALLBACK	1	// Always use the element callbacks, even for built-in types
+#define PLAN_FLAG_SERIAL	2	// Never split the operation across threads
+
+// Kernels a plan can select
+#define PLAN_KERNEL_CALLBACK	0
+#define PLAN_KERNEL_NATIVE  	1
+#define PLAN_KERNEL_INTEGER 	2
+
+/**
+ * vctplan_t - A validated element-wise operation with its kernel already chosen.
+ *
+ * Members:
+ * - s32_Operation: One of the PLAN_OP_* values.
+ * - s32_Kernel: One of the PLAN_KERNEL_* values.
+ * - s32_Type: Element type of the operands.
+ * - s32_IntegerMode: Integer mode of the result vector at creation.
+ * - sz_ElementCount: Number of elements processed per execution.
+ * - sz_ElementSize: Size (in bytes) of each element.
+ * - sz_Chunks: Number of chunks each execution is split into (1 for serial execution).
+ * - pfn_Element: Element callback used by PLAN_KERNEL_CALLBACK.
+ * - pfn_Native: Type-specialised loop used by PLAN_KERNEL_NATIVE.
+ */
+typedef struct __vctplan_t {
+	int s32_Operation;
+	int s32_Kernel;
+	TYPE s32_Type;
+	int s32_IntegerMode;
+
+	size_t sz_ElementCount;
+	size_t sz_ElementSize;
+	size_t sz_Chunks;
+
+	void (*pfn_Element)(void*, const void*, const void*);
+	void (*pfn_Native)(void*, const void*, const void*, size_t);
+} vctplan_t;
+
+/**
+ * vctplancreate - Validate operands and choose the kernel for an element-wise operation.
+ *
+ * Parameters:
+ *  - pvp_Plan: Pointer to the vctplan_t that is filled in.
+ *  - cs32_Operation: One of the PLAN_OP_* values.
+ *  - cpv_A/cpv_B: Constant pointers to the operand vectors, with the same requirements as vctadd.
+ *  - cpv_Result: Constant pointer to the vector that will receive the result.
+ *  - cs32_Flags: PLAN_FLAG_* values combined with |.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctplancreate(vctplan_t* pvp_Plan, const int cs32_Operation, const vector_t* cpv_A, const vector_t* cpv_B, const vector_t* cpv_Result, const int cs32_Flags);
+
+/**
+ * vctplanexec - Execute a plan without re-validating its operands.
+ *
+ * Parameters:
+ *  - cpvp_Plan: Constant pointer to a plan created by vctplancreate.
+ *  - pv_Result: Pointer to the vector receiving the result.  May alias either operand.
+ *  - cpv_A/cpv_B: Constant pointers to the operand vectors.
+ *
+ * Overflow detected by a PLAN_KERNEL_INTEGER plan in INTEGER_MODE_CHECKED raises pv_Result->s32_OverflowFlag.
+ */
+void vctplanexec(const vctplan_t* cpvp_Plan, vector_t* pv_Result, const vector_t* cpv_A, const vector_t* cpv_B);
+
+#endif // PLAN_H_
@@ -0,0 +1,124 @@
+/*
+ * quant.h
+ *
+ * A pure C99 header for 8-bit quantized vectors and matrices.
+ *
+ * Features:
+ * - Per-vector/per-column quantization of TYPE_FP32 data into TYPE_S8 (symmetric) or TYPE_U8 (asymmetric)
+ * - Integer dot products that widen into 32-bit accumulators instead of the element type
+ * - Quantized GEMM producing dequantized TYPE_FP32 scores, with zero-point correction, blocked over columns of B
+ *   and split across the parallel backend (see parallel.h)
+ *
+ * A quantized value q represents the real value f32_Scale * (q - s32_ZeroPoint).  Matrices carry one
+ * scale and zero point per column, matching the column-per-embedding layout used by search.h, so the
+ * parameters are passed as arrays of sz_Width entries.  TYPE_S8 data is always quantized with a zero
+ * point of 0, and a NULL zero-point array is read as all zeros.  Matrices may use either storage
+ * layout; mtxqgemm packs row-major operands into contiguous columns once per call.
+ *
+ * Hungarian Notation Key:
+ * - pv_   : pointer to vector_t
+ * - cpv_  : const pointer to vector_t
+ * - pm_   : pointer to matrix_t
+ * - cpm_  : const pointer to matrix_t
+ * - pf32_ : pointer to 32-bit floats
+ * - ps32_ : pointer to 32-bit signed integers
+ * - cf32_ : const 32-bit float
+ * - cs32_ : const 32-bit signed integer
+ *
+ */
+
+
+#ifndef QUANT_H_
+#define QUANT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+#include "matrix.h"
+
+/**
+ * vctquantize - Quantize a TYPE_FP32 vector into an already-created TYPE_S8 or TYPE_U8 vector.
+ *
+ * Parameters:
+ *  - pv_Quantized: Pointer to a TYPE_S8/TYPE_U8 vector_t with the same length as cpv_Source.
+ *  - pf32_Scale: Destination for the chosen scale.
+ *  - ps32_ZeroPoint: Destination for the chosen zero point.  May be NULL for TYPE_S8.
+ *  - cpv_Source: Constant pointer to the TYPE_FP32 vector_t being quantized.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctquantize(vector_t* pv_Quantized, float* pf32_Scale, int32_t* ps32_ZeroPoint, const vector_t* cpv_Source);
+
+/**
+ * mtxquantize - Quantize every column of a TYPE_FP32 matrix into an already-created TYPE_S8 or TYPE_U8 matrix.
+ *
+ * Parameters:
+ *  - pm_Quantized: Pointer to a TYPE_S8/TYPE_U8 matrix_t with the same dimensions as cpm_Source.
+ *  - pf32_Scales: Destination for cpm_Source->sz_Width scales.
+ *  - ps32_ZeroPoints: Destination for cpm_Source->sz_Width zero points.  May be NULL for TYPE_S8.
+ *  - cpm_Source: Constant pointer to the TYPE_FP32 matrix_t being quantized.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxquantize(matrix_t* pm_Quantized, float* pf32_Scales, int32_t* ps32_ZeroPoints, const matrix_t* cpm_Source);
+
+/**
+ * vctdots32 - Raw integer dot product of two 8-bit vectors, accumulated in 32-bit integers.
+ *
+ * Parameters:
+ *  - ps32_Product: Destination for the sum of products.
+ *  - cpv_A: Constant pointer to a TYPE_S8 or TYPE_U8 vector_t.
+ *  - cpv_B: Constant pointer to a TYPE_S8 or TYPE_U8 vector_t of the same length.
+ *
+ * The element types may differ (e.g. TYPE_U8 activations against TYPE_S8 weights).  The sum saturates to
+ * the int32_t range instead of wrapping for extremely long vectors.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctdots32(int32_t* ps32_Product, const vector_t* cpv_A, const vector_t* cpv_B);
+
+/**
+ * vctqdot - Dequantized dot product of two quantized vectors.
+ *
+ * Parameters:
+ *  - pf32_Product: Destination for the dot product of the represented real values.
+ *  - cpv_A: Constant pointer to a TYPE_S8 or TYPE_U8 vector_t.
+ *  - cf32_ScaleA/cs32_ZeroPointA: Quantization parameters of cpv_A.
+ *  - cpv_B: Constant pointer to a TYPE_S8 or TYPE_U8 vector_t of the same length.
+ *  - cf32_ScaleB/cs32_ZeroPointB: Quantization parameters of cpv_B.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctqdot(float* pf32_Product, const vector_t* cpv_A, const float cf32_ScaleA, const int32_t cs32_ZeroPointA, const vector_t* cpv_B, const float cf32_ScaleB, const int32_t cs32_ZeroPointB);
+
+/**
+ * mtxqgemm - Dequantized product of the transpose of one quantized matrix with another.
+ *
+ * Parameters:
+ *  - pm_Result: Pointer to a TYPE_FP32 matrix_t with sz_Height == cpm_A->sz_Width and sz_Width == cpm_B->sz_Width.
+ *  - cpm_A: Constant pointer to a TYPE_S8 or TYPE_U8 matrix_t.
+ *  - cpf32_ScalesA/cps32_ZeroPointsA: Per-column quantization parameters of cpm_A (zero points may be NULL).
+ *  - cpm_B: Constant pointer to a TYPE_S8 or TYPE_U8 matrix_t with the same sz_Height as cpm_A.
+ *  - cpf32_ScalesB/cps32_ZeroPointsB: Per-column quantization parameters of cpm_B (zero points may be NULL).
+ *
+ * Element (i, j) of the result is the dot product of column i of cpm_A with column j of cpm_B, which
+ * scores every query column of cpm_B against every corpus column of cpm_A.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxqgemm(matrix_t* pm_Result, const matrix_t* cpm_A, const float* cpf32_ScalesA, const int32_t* cps32_ZeroPointsA, const matrix_t* cpm_B, const float* cpf32_ScalesB, const int32_t* cps32_ZeroPointsB);
+
+#endif // QUANT_H_
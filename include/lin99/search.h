@@ -0,0 +1,84 @@
+/*
+ * search.h
+ *
+ * A pure C99 nearest-neighbour search header for matrix_t embedding corpora.
+ *
+ * Features:
+ * - Batched k-nearest-neighbour queries against the columns of a matrix_t
+ * - Dot product, cosine similarity and squared Euclidean (L2) metrics
+ * - Blocked scoring so the corpus is streamed once per block of queries
+ * - Fused top-k selection so the full query-by-corpus score matrix is never stored
+ *
+ * Each column of a corpus or query matrix is one embedding, so sz_Height is the embedding
+ * dimension and sz_Width is the number of embeddings.  Since the nearest neighbours are
+ * decided by ordering scores, and the arithmetic callbacks do not provide an ordering, only
+ * TYPE_FP32 and TYPE_FP64 matrices are supported.  Scratch memory is requested through the
+ * corpus' pfn_Allocate/pfn_Free callbacks.  Either storage layout is accepted; a row-major corpus
+ * is scored a row at a time so that it is still read contiguously.
+ *
+ * Hungarian Notation Key:
+ * - pv_  : pointer to vector_t
+ * - cpv_ : const pointer to vector_t
+ * - pm_  : pointer to matrix_t
+ * - cpm_ : const pointer to matrix_t
+ * - psz_ : pointer to size_t
+ * - csz_ : const size_t
+ * - cs32_: const 32-bit signed integer
+ *
+ */
+
+
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+#include "matrix.h"
+
+// Higher scores are better for DOT and COSINE, lower distances are better for L2
+#define KNN_METRIC_DOT    	0
+#define KNN_METRIC_COSINE 	1
+#define KNN_METRIC_L2     	2
+
+/**
+ * mtxknn - Find the csz_K best-scoring corpus columns for every column of a query matrix.
+ *
+ * Parameters:
+ *  - psz_Indices: Destination for csz_K * cpm_Queries->sz_Width corpus column indices.
+ *  - p_Scores: Destination for csz_K * cpm_Queries->sz_Width scores, read as the corpus element type.  May be NULL.
+ *  - cpm_Corpus: Constant pointer to the matrix_t whose columns are searched.
+ *  - cpm_Queries: Constant pointer to the matrix_t whose columns are the queries.
+ *  - csz_K: Number of neighbours returned per query, must not exceed cpm_Corpus->sz_Width.
+ *  - cs32_Metric: One of the KNN_METRIC_* values.
+ *
+ * Results for query j occupy entries [j * csz_K, (j + 1) * csz_K) of both destinations, ordered
+ * best first.  KNN_METRIC_L2 reports squared distances.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxknn(size_t* psz_Indices, void* p_Scores, const matrix_t* cpm_Corpus, const matrix_t* cpm_Queries, const size_t csz_K, const int cs32_Metric);
+
+/**
+ * mtxknnvct - Single-query form of mtxknn.
+ *
+ * Parameters:
+ *  - psz_Indices: Destination for csz_K corpus column indices.
+ *  - p_Scores: Destination for csz_K scores, read as the corpus element type.  May be NULL.
+ *  - cpm_Corpus: Constant pointer to the matrix_t whose columns are searched.
+ *  - cpv_Query: Constant pointer to a vector_t whose length equals cpm_Corpus->sz_Height.
+ *  - csz_K: Number of neighbours returned, must not exceed cpm_Corpus->sz_Width.
+ *  - cs32_Metric: One of the KNN_METRIC_* values.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int mtxknnvct(size_t* psz_Indices, void* p_Scores, const matrix_t* cpm_Corpus, const vector_t* cpv_Query, const size_t csz_K, const int cs32_Metric);
+
+#endif // SEARCH_H_
@@ -0,0 +1,389 @@
+/*
+ * tensor.h
+ *
+ * A pure C99 header for type-generic N-dimensional tensors.
+ *
+ * Features:
+ * - Arbitrary rank (up to TENSOR_MAX_RANK), shape and element strides on the s32_Type, callback and allocator model of vector_t/matrix_t
+ * - Free views: broadcasts, permutations, slices and reshapes share storage with their source, as do views of vectors and matrices
+ * - Element-wise operations with NumPy-style broadcasting, done through zero strides so expanded operands are never materialised
+ * - Loops reordered and fused by stride so the innermost loop walks the longest contiguous run of the result
+ * - Tensor contractions and batched matrix products reduced to the native GEMM for TYPE_FP32/TYPE_FP64
+ * - Copy-on-write clones, as for vectors and matrices
+ *
+ * Element (i_0, ..., i_{r-1}) lives at element offset sum of i_k * a_Strides[k] from p_StorageBuffer.  A tensor
+ * created with all strides zero is packed in row-major (C) order, so its last axis is contiguous.
+ *
+ * Broadcasting follows NumPy: shapes are aligned at their last axis, and along each axis an operand must
+ * either match the result or have extent 1, in which case its single element is reused.  Missing leading
+ * axes count as extent 1.
+ *
+ * Hungarian Notation Key:
+ * - pt_  : pointer to tensor_t
+ * - cpt_ : const pointer to tensor_t
+ * - pv_  : pointer to vector_t
+ * - cpv_ : const pointer to vector_t
+ * - cpm_ : const pointer to matrix_t
+ * - csz_ : const size_t
+ * - pfn_ : function pointer
+ *
+ */
+
+
+#ifndef TENSOR_H_
+#define TENSOR_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vector.h"
+#include "matrix.h"
+
+// Largest rank a tensor_t can hold
+#define TENSOR_MAX_RANK 	8
+
+/**
+ * tensor_t - Generic N-dimensional container with generic element arithmetic and memory operations.
+ *
+ * Members:
+ * - s32_Type: Provided value specifying the type of element.  May be predefined or user provided.
+ * - p_StorageBuffer: Address of element (0, ..., 0).
+ * - sz_BufferSize: Size in bytes of the storage reachable from p_StorageBuffer, at least the extent spanned by the strides.
+ * - sz_ElementSize: Size (in bytes) of each element in the tensor.
+ * - sz_ElementCount: Number of elements, the product of the first sz_Rank entries of a_Shape.
+ * - sz_Rank: Number of axes, from 0 (a single element) to TENSOR_MAX_RANK.
+ * - a_Shape: Extent of each axis; every extent is at least 1.
+ * - a_Strides: Distance, in elements, between consecutive indices along each axis.  Broadcast views use 0.
+ * - s32_Borrowed: Non-zero when p_StorageBuffer belongs to someone else (tnswrap and every view) and is not freed by tnsdstry.
+ * - psz_References: Count of the tensors sharing p_StorageBuffer after tnsclone, or NULL while this tensor is its only owner.
+ * - pfn_ElementAdd/pfn_ElementSubtract/pfn_ElementMultiply/pfn_ElementDivide: User-provided function callbacks for arithmetic operations.
+ * - pfn_Allocate/pfn_Free: Memory allocation callbacks, also used for scratch memory by operations writing into the tensor.
+ */
+typedef struct __tensor_t {
+	TYPE s32_Type;
+
+	void* p_StorageBuffer;
+	size_t sz_BufferSize;
+	size_t sz_ElementSize;
+	size_t sz_ElementCount;
+
+	size_t sz_Rank;
+	size_t a_Shape[TENSOR_MAX_RANK];
+	size_t a_Strides[TENSOR_MAX_RANK];
+	int s32_Borrowed;
+	size_t* psz_References;
+
+	void (*pfn_ElementAdd)(void*, const void*, const void*);
+	void (*pfn_ElementSubtract)(void*, const void*, const void*);
+	void (*pfn_ElementMultiply)(void*, const void*, const void*);
+	void (*pfn_ElementDivide)(void*, const void*, const void*);
+
+	void* (*pfn_Allocate)(size_t);
+	void  (*pfn_Free)(void*);
+} tensor_t;
+
+
+/**
+ * tnscreate - Allocates the storage of a tensor_t.
+ *
+ * Parameters:
+ * - pt_Tensor: Pointer to a tensor_t with its type, element size, rank and shape already set.
+ * - pfn_AllocateMemory: Callback function to memory allocation.
+ * - pfn_FreeMemory: Callback function to memory deallocation.
+ *
+ * Strides set beforehand are honoured (for padded layouts); when they are all zero the packed row-major strides are filled in.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1
+ */
+int tnscreate(tensor_t* pt_Tensor, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*));
+
+/**
+ * tnswrap - Use an existing buffer as the storage of a tensor_t without copying it.
+ *
+ * Parameters:
+ * - pt_Tensor: Pointer to a tensor_t set up as for tnscreate.
+ * - p_Buffer: Address of the caller's data, laid out as described by a_Strides.
+ * - pfn_AllocateMemory/pfn_FreeMemory: Callbacks used for scratch memory by operations on the tensor.
+ *
+ * The buffer stays owned by the caller: tnsdstry leaves it alone and it must outlive the tensor.
+ * A C array float a[n][h][w] is wrapped with rank 3, shape { n, h, w } and zero strides.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1
+ */
+int tnswrap(tensor_t* pt_Tensor, void* p_Buffer, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*));
+
+/**
+ * tnsclone - Make a tensor sharing the storage of another until either of them is written to (see vctclone).
+ *
+ * Parameters:
+ * - pt_Clone: Pointer to the tensor_t receiving the clone.  Any previous contents are overwritten, not destroyed.
+ * - pt_Source: Pointer to the tensor_t being cloned.  Only its sharing bookkeeping is modified.
+ *
+ * A borrowed source (a wrapped buffer or a view) is copied into a buffer from pfn_Allocate right away, keeping its strides.
+ * Each clone must be released with tnsdstry.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1
+ */
+int tnsclone(tensor_t* pt_Clone, tensor_t* pt_Source);
+
+/**
+ * tnsunique - Give a tensor its own copy of its storage if the buffer is shared with a clone (see vctunique).
+ *
+ * Parameters:
+ * - pt_Tensor: Pointer to the tensor_t about to be written to.
+ *
+ * Returns:
+ * - On success: 0
+ * - On failure: -1, with the buffer still shared
+ */
+int tnsunique(tensor_t* pt_Tensor);
+
+/**
+ * MAKE_TENSOR - Macro designed to streamline the process of creating tensor_t types.
+ *
+ * Parameters:
+ *  - name: Name of tensor_t variable.
+ *  - type: Type used by each element in the tensor (uint8_t, float, int32_t, etc.).
+ *  - rank: Number of axes.
+ *  - shape: Array of rank extents.
+ *  - pfn_add/pfn_sub/pfn_mul/pfn_div: Callback functions that represent the operations between the elements' types.
+ */
+#define MAKE_TENSOR(name, type, rank, shape, type_enum, pfn_add, pfn_sub, pfn_mul, pfn_div) \
+tensor_t name              	= {}; \
+name.s32_Type              	= type_enum; \
+name.sz_ElementSize        	= sizeof(type); \
+name.sz_Rank               	= rank; \
+name.pfn_ElementAdd        	= pfn_add; \
+name.pfn_ElementSubtract   	= pfn_sub; \
+name.pfn_ElementMultiply   	= pfn_mul; \
+name.pfn_ElementDivide     	= pfn_div; \
+memcpy(name.a_Shape, shape, (rank) * sizeof(size_t)); \
+\
+tnscreate(&name, NULL, NULL);
+
+/**
+ * MAKE_TENSOR_FAST - The easiest and fastest way to create tensor_t types directly from tensor.h.
+ *
+ * Parameters:
+ *  - name: Name of the tensor_t variable.
+ *  - type: Type used by each element in the tensor (uint8_t, float, int32_t, etc.).
+ *  - rank: Number of axes.
+ *  - shape: Array of rank extents.
+ *  - abbr: Abbreviated notation for the provided type (FP32 for float, S8 for int8_t, etc.)
+ */
+#define MAKE_TENSOR_FAST(name, type, rank, shape, abbr) MAKE_TENSOR(name, type, rank, shape, TYPE_##abbr, Add##abbr, Subtract##abbr, Multiply##abbr, Divide##abbr)
+
+
+/**
+ * tnsmemchk - Check if internal memory is valid for use in operations.
+ *
+ * Parameters:
+ *  - cpt_Tensor: Constant pointer to a tensor_t variable.
+ *
+ * Examines the storage, element size and count, type, allocation callbacks, rank, shape, and that the strides stay inside the buffer.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsmemchk(const tensor_t* cpt_Tensor);
+
+/**
+ * tnsread - Copy one element of a tensor to a provided destination.
+ *
+ * Parameters:
+ *  - p_Destination: Address the element is copied to.
+ *  - cpt_Tensor: Constant pointer to the tensor_t read from.
+ *  - csz_Index: Array of sz_Rank indices, one per axis.
+ */
+void tnsread(void* p_Destination, const tensor_t* cpt_Tensor, const size_t* csz_Index);
+
+/**
+ * tnswrite - Copy data from a provided address to one element of a tensor.
+ *
+ * Parameters:
+ *  - pt_Tensor: Pointer to the tensor_t written to.
+ *  - csz_Index: Array of sz_Rank indices, one per axis.
+ *  - p_Data: Address in memory that tnswrite copies from.
+ */
+void tnswrite(tensor_t* pt_Tensor, const size_t* csz_Index, void* p_Data);
+
+/**
+ * tnsvctview/tnsmtxview - Describe a vector or matrix as a tensor sharing its storage.
+ *
+ * Parameters:
+ *  - pt_View: Pointer to the tensor_t receiving the view.
+ *  - cpv_Vector/cpm_Matrix: Constant pointer to the source.  A vector becomes rank 1; a matrix becomes rank 2 with
+ *    shape { sz_Height, sz_Width } and the strides of its layout and leading dimension.
+ *
+ * Views borrow the source's storage, must not outlive it, and need no tnsdstry.  Writing through a view of a
+ * clone reaches every holder of the buffer; call vctunique/mtxunique on the source first when that matters.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsvctview(tensor_t* pt_View, const vector_t* cpv_Vector);
+int tnsmtxview(tensor_t* pt_View, const matrix_t* cpm_Matrix);
+
+/**
+ * tnsbroadcast - View a tensor as a larger shape following the broadcasting rules, without copying.
+ *
+ * Parameters:
+ *  - pt_View: Pointer to the tensor_t receiving the view.
+ *  - cpt_Source: Constant pointer to the tensor_t being broadcast.
+ *  - csz_Rank/csz_Shape: Target rank, no less than the source's, and its extents.
+ *
+ * Broadcast axes get stride 0, so the view is read-only in practice: it cannot be the result of an operation.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsbroadcast(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Rank, const size_t* csz_Shape);
+
+/**
+ * tnspermute - View a tensor with its axes reordered, without copying.
+ *
+ * Parameters:
+ *  - pt_View: Pointer to the tensor_t receiving the view.
+ *  - cpt_Source: Constant pointer to the tensor_t being permuted.
+ *  - csz_Axes: Permutation of 0 .. sz_Rank - 1; axis k of the view is axis csz_Axes[k] of the source.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnspermute(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t* csz_Axes);
+
+/**
+ * tnsslice - View the indices [csz_Begin, csz_Begin + csz_Count) of one axis, without copying.
+ *
+ * Parameters:
+ *  - pt_View: Pointer to the tensor_t receiving the view.
+ *  - cpt_Source: Constant pointer to the tensor_t being sliced.
+ *  - csz_Axis: Axis to restrict.
+ *  - csz_Begin/csz_Count: First index kept and number of indices kept (at least 1).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsslice(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Axis, const size_t csz_Begin, const size_t csz_Count);
+
+/**
+ * tnsreshape - View a tensor with a different shape holding the same number of elements, without copying.
+ *
+ * Parameters:
+ *  - pt_View: Pointer to the tensor_t receiving the view.
+ *  - cpt_Source: Constant pointer to a tensor_t packed in row-major order.  Copy other views with tnscopy first.
+ *  - csz_Rank/csz_Shape: New rank and extents; elements keep their row-major order.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsreshape(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Rank, const size_t* csz_Shape);
+
+// OPERATORS GO HERE //
+
+/**
+ * tnscopy - Copy a tensor into another of the same element size, broadcasting the source to the result's shape.
+ *
+ * Parameters:
+ *  - pt_Result: Pointer to the tensor_t written to, in any layout.
+ *  - cpt_Source: Constant pointer to a tensor_t whose shape broadcasts to the result's.
+ *
+ * This is how a view is materialised into packed storage.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnscopy(tensor_t* pt_Result, const tensor_t* cpt_Source);
+
+/**
+ * tnsadd/tnssub/tnselemul/tnselediv - Element-wise arithmetic with broadcasting.
+ *
+ * Parameters:
+ *  - pt_Result: Pointer to a tensor_t with the broadcast shape of the operands.
+ *  - cpt_A/cpt_B: Constant pointers to tensors of the result's type whose shapes broadcast to it.
+ *
+ * Requirements:
+ * - The result has no stride-0 axes and shares storage with an operand only when it is that operand (same
+ *   address, shape and strides), for in-place updates.
+ * - TYPE_FP32 and TYPE_FP64 use native kernels; other types need the respective callback of cpt_A.
+ *
+ * The loops run over the result's axes sorted by stride, with axes that are contiguous in all three tensors fused,
+ * so a packed operation of any rank runs as a single vectorised loop and a broadcast one keeps a unit-stride inner loop.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+#define TENSOR_ELEMENTWISE_OP_DEC(fn_Name) \
+int fn_Name(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B);
+
+TENSOR_ELEMENTWISE_OP_DEC(tnsadd)
+TENSOR_ELEMENTWISE_OP_DEC(tnssub)
+TENSOR_ELEMENTWISE_OP_DEC(tnselemul)
+TENSOR_ELEMENTWISE_OP_DEC(tnselediv)
+
+/**
+ * tnscontract - Contract the last csz_Axes axes of A with the first csz_Axes axes of B (NumPy's tensordot).
+ *
+ * Parameters:
+ *  - pt_Result: Pointer to a tensor_t shaped as the remaining axes of A followed by the remaining axes of B.
+ *  - cpt_A/cpt_B: Constant pointers to the operands; the contracted extents must match pairwise.
+ *  - csz_Axes: Number of axes contracted, from 0 (outer product) up to the smaller rank.
+ *
+ * The free axes of A, the contracted axes and the free axes of B are each flattened into one dimension, which
+ * turns the contraction into a single matrix product.  Operands whose axes cannot be flattened in place (such as
+ * permuted or broadcast views) are packed into scratch memory first; packed tensors never are.  TYPE_FP32 and
+ * TYPE_FP64 then run on the native GEMM, other types on the multiply and add callbacks of cpt_A.
+ * Other axis orders are contracted by permuting the operands with tnspermute first.
+ * The result must not share storage with either operand.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnscontract(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B, const size_t csz_Axes);
+
+/**
+ * tnsmatmul - Batched matrix product over the last two axes, broadcasting the leading (batch) axes.
+ *
+ * Parameters:
+ *  - pt_Result: Pointer to a tensor_t of shape batch x M x N.
+ *  - cpt_A: Constant pointer to a tensor_t of shape batchA x M x K, rank at least 2.
+ *  - cpt_B: Constant pointer to a tensor_t of shape batchB x K x N, rank at least 2; batchA and batchB broadcast to batch.
+ *
+ * Each product reads its matrices in place in either orientation, so row-major, column-major and transposed
+ * (permuted) operands need no copy.  Batches are split across the parallel backend; a single large product is
+ * left to the GEMM's own parallelism.  The result must not share storage with either operand.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int tnsmatmul(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B);
+
+/**
+ * tnsdstry - Deallocates the storage of a tensor using its designated pfn_Free member.
+ *
+ * Parameters:
+ * - pt_Tensor: pointer to tensor_t to be freed
+ *
+ * Borrowed storage (tnswrap and views) is left to its owner.  A buffer shared through tnsclone only loses one reference.
+ */
+void tnsdstry(tensor_t* pt_Tensor);
+
+#endif // TENSOR_H_
@@ -1,5 +1,4 @@
 //TODO: Global zalloc use instead of calling zalloc every operation
-//TODO: Add overflow protection on pfn_*-based operations
 //TODO: Validate pfn_*'s in vctcreate (good luck)
 //TODO: Add cross products
 //TODO: Start matrix_t type in matrix.h
@@ -62,6 +61,11 @@ typedef int TYPE;
 
 #define CHECK_ALLOCATION(buffer) (buffer != NULL)
 
+// Integer semantics used by the element-wise operators when writing into a vector of a built-in integer type
+#define INTEGER_MODE_WRAP     	0	// Use the element callbacks, which wrap for the provided arithmetic op sets
+#define INTEGER_MODE_SATURATE 	1	// Clamp every result to the range of the element type
+#define INTEGER_MODE_CHECKED  	2	// Wrap, but raise s32_OverflowFlag on the result if any element overflowed
+
 // Create a generalized operation definition that allows the user to specify a custom name, type, operator, and allocation method.
 /**
  * Writing custom operation functions.
@@ -138,11 +142,19 @@ static void* zalloc(size_t sz_Size) {
  * Members:
  * - s32_Type: Provided value specifying the type of element.  May be predefined or user provided.
  * - p_StorageBuffer: Address to location of vector data in memory.
- * - sz_BufferSize: Total size of the buffer, calculated as sz_ElementSize * sz_ElementCount.
+ * - sz_BufferSize: Total size of the buffer, calculated as sz_ElementSize * sz_Capacity.
  * - sz_ElementSize: Size (in bytes) of each element in the vector.
  * - sz_ElementCount: Number of elements in vector.
+ * - sz_Capacity: Number of elements the buffer can hold before it has to grow; never less than sz_ElementCount.
  * - pfn_ElementAdd/pfn_ElementSubtract/pfn_ElementMultiply/pfn_ElementDivide: User-provided function callbacks for arithmetic operations (may be done easily with provided macros).
  * - pfn_Allocate/pfn_Free: User-provided memory allocation callbacks that may be either automatically filled by vctcreate or manually-set to use custom memory allocation tools.
+ * - s32_IntegerMode: One of the INTEGER_MODE_* values, honoured when this vector receives the result of an operation.
+ * - s32_OverflowFlag: Sticky flag raised by INTEGER_MODE_CHECKED operations, cleared only by vctovfclr.
+ * - pfn_Reallocate: Optional realloc-style callback (buffer, old size, new size) used when the buffer grows or shrinks.
+ *   It must keep the contents up to the smaller size and return NULL, leaving the buffer intact, on failure.
+ *   When NULL, the buffer is moved with pfn_Allocate, a copy and pfn_Free.
+ * - psz_References: Count of the vectors sharing p_StorageBuffer after vctclone, or NULL while this vector is its only owner.
+ *   Every operation writing into the vector first gives it a private copy (see vctunique).
  */
 typedef struct __vector_t {
 	TYPE s32_Type;
@@ -151,6 +163,7 @@ typedef struct __vector_t {
 	size_t sz_BufferSize;
 	size_t sz_ElementSize;
 	size_t sz_ElementCount;
+	size_t sz_Capacity;
 
 	void (*pfn_ElementAdd)(void*, const void*, const void*);
 	void (*pfn_ElementSubtract)(void*, const void*, const void*);
@@ -159,6 +172,11 @@ typedef struct __vector_t {
 
 	void* (*pfn_Allocate)(size_t);
 	void  (*pfn_Free)(void*);
+	void* (*pfn_Reallocate)(void*, size_t, size_t);
+	size_t* psz_References;
+
+	int s32_IntegerMode;
+	int s32_OverflowFlag;
 } vector_t;
 
 
@@ -170,6 +188,8 @@ typedef struct __vector_t {
  * - pfn_AllocateMemory: Callback function to memory allocation.
  * - pfn_FreeMemory: Callback function to memory deallocation.
  *
+ * A sz_Capacity larger than sz_ElementCount set beforehand is allocated up front, in which case sz_ElementCount may be 0.
+ *
  * Returns:
  * - On success: 0
  * - On failure: -1
@@ -234,6 +254,41 @@ vctcreate(&name, NULL, NULL);
 int vctmemchk(const vector_t* cpv_Vector);
 
 
+/**
+ * vctclone - Make a vector sharing the storage of another until either of them is written to.
+ *
+ * Parameters:
+ *  - pv_Clone: Pointer to the vector_t receiving the clone.  Any previous contents are overwritten, not destroyed.
+ *  - pv_Source: Pointer to the vector_t being cloned.  Only its sharing bookkeeping is modified.
+ *
+ * No element is copied: both vectors point at the same buffer and a shared reference count.  The first
+ * operation that writes into either one (vctwrite, the element-wise and scaling operators, fills, growth,
+ * and every other call taking the vector as a non-const output) copies the buffer for that vector alone.
+ * Each clone must be released with vctdstry, which frees the buffer together with its last holder.
+ *
+ * Clones may be handed to other threads, but a single vector_t must still not be used by two threads at once.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctclone(vector_t* pv_Clone, vector_t* pv_Source);
+
+/**
+ * vctunique - Give a vector its own copy of its storage if the buffer is shared with a clone.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t about to be written to.
+ *
+ * Called by every lin99 operation before it writes; call it before writing through p_StorageBuffer directly.
+ * The last holder of a shared buffer takes it over without copying.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1, with the buffer still shared
+ */
+int vctunique(vector_t* pv_Vector);
+
 /**
  * vctread - Copy data from one element in a vector to a provided destination.
  *
@@ -254,6 +309,78 @@ void vctread(void* p_Destination, const vector_t* cpv_Vector, const size_t csz_I
  */
 void vctwrite(vector_t* pv_Vector, const size_t csz_Idx, void* p_Data);
 
+/**
+ * vctreserve - Make room for at least csz_Capacity elements without changing the length.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being grown.
+ *  - csz_Capacity: Number of elements the buffer must be able to hold.
+ *
+ * Existing elements are kept; the buffer may move, so pointers into it are invalidated.  A vector that was never
+ * created only needs s32_Type and sz_ElementSize set, and receives the default allocation callbacks.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctreserve(vector_t* pv_Vector, const size_t csz_Capacity);
+
+/**
+ * vctpush - Append one element, growing the capacity geometrically when it runs out.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being appended to.
+ *  - cp_Element: Address of the sz_ElementSize bytes to append.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctpush(vector_t* pv_Vector, const void* cp_Element);
+
+/**
+ * vctappend - Append csz_Count consecutive elements in one step.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being appended to.
+ *  - cp_Elements: Address of csz_Count packed elements.  May point into pv_Vector itself.
+ *  - csz_Count: Number of elements to append.
+ *
+ * Growth is geometric, so a stream of appends costs amortised O(1) copies per element.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctappend(vector_t* pv_Vector, const void* cp_Elements, const size_t csz_Count);
+
+/**
+ * vctresize - Change the length of a vector, zero-filling any new elements.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being resized.
+ *  - csz_Count: New number of elements.
+ *
+ * Shrinking only changes the length; the capacity is kept for later growth (see vctshrink).
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctresize(vector_t* pv_Vector, const size_t csz_Count);
+
+/**
+ * vctshrink - Release unused capacity so the buffer holds exactly the current elements.
+ *
+ * Parameters:
+ *  - pv_Vector: Pointer to the vector_t being trimmed.  An empty vector keeps room for one element.
+ *
+ * Returns:
+ *  - Success: 0
+ *  - Failure: -1
+ */
+int vctshrink(vector_t* pv_Vector);
+
 
 /**
  * vctcmp - Check if two vectors are suitable for an operation
@@ -286,6 +413,12 @@ int vctcmp(const vector_t* cpv_A, const vector_t* cpv_B);
  * - Vectors must be the same length and element size.
  * - Respective arithmetic callback (e.g., pfn_ElementAdd for vctadd) must be set.
  * - Vectors must use the same arithmetic callbacks
+ *
+ * Integer semantics:
+ * - When pv_Result has a non-wrapping s32_IntegerMode and all three vectors share a built-in integer
+ *   type (TYPE_S8 through TYPE_U64, or TYPE_SZ), the callbacks are bypassed in favour of branch-free
+ *   saturating or overflow-checked kernels.
+ * - Division by zero produces 0 in both modes and counts as an overflow in INTEGER_MODE_CHECKED.
  */
 
 #define ELEMENTWISE_OP_DEC(fn_Name) \
@@ -320,6 +453,7 @@ void vctdot(void* p_Product, const vector_t* cpv_A, const vector_t* cpv_B);
  *  - cp_Scalar: Constant pointer to a space in memory that represents the scalar value of the operation.
  *
  * vctscaleinv will scale the vector by the inverse of the interpreted value of cp_Scalar.
+ * Both honour the s32_IntegerMode of the scaled vector in the same way as vctelemul/vctelediv.
  */
 #define SCALE_OP_DEC(fn_Name) \
 void fn_Name(void* pv_Scaled, const vector_t* cpv_Vector, const void* cp_Scalar);
@@ -352,11 +486,28 @@ void vctmagsq(void* p_Magnitude, const vector_t* cpv_Vector);
 void vctnorm(vector_t* pv_Normalized, const vector_t* cpv_Vector, void (*pfn_SquareRoot)(void*, const void*));
 
 
+/**
+ * vctovfchk/vctovfclr - Query or clear the sticky overflow flag of a vector.
+ *
+ * Parameters:
+ *  - cpv_Vector/pv_Vector: Pointer to the vector_t whose s32_OverflowFlag is examined or cleared.
+ *
+ * vctovfchk returns:
+ *  - Overflow recorded since the last vctovfclr: 1
+ *  - No overflow recorded: 0
+ *  - Failure: -1
+ */
+int vctovfchk(const vector_t* cpv_Vector);
+void vctovfclr(vector_t* pv_Vector);
+
+
 /**
  * vctdstry - Deallocates a vector and its internal buffer using its designated pfn_Free member.
  *
  * Parameters:
  * - pv_vector: pointer to vector_t to be freed
+ *
+ * A buffer shared through vctclone only loses one reference; it is freed along with its last holder.
  */
 void vctdstry(vector_t* pv_Vector);
 
@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/async.h"
+#include "lin99/parallel.h"
+
+#ifdef LIN99_THREADS
+#include <pthread.h>
+#endif
+
+// Upper bound on the number of executor threads
+#define ASYNC_MAX_THREADS   	PAR_MAX_THREADS
+
+/**
+ * __asynctask_t - One submitted operation.
+ *
+ * Members:
+ * - pfn_Operation/p_Context: The operation and its argument.
+ * - pa_Next: Link in the executor's ready queue.
+ * - ppa_Successors/sz_Successors/sz_Capacity: Operations waiting on this one, released when it finishes.
+ * - sz_Unmet: Dependencies that have not finished yet; the operation is queued when this reaches 0.
+ * - sz_References: Held by the caller's handle and by the executor until the operation has finished.
+ * - s32_Finished/s32_Result: Completion flag and the operation's return value.
+ * - s32_Failed: Set when a dependency failed, in which case the operation is skipped.
+ */
+struct __asynctask_t {
+	int (*pfn_Operation)(void*);
+	void* p_Context;
+	struct __asynctask_t* pa_Next;
+
+	struct __asynctask_t** ppa_Successors;
+	size_t sz_Successors;
+	size_t sz_Capacity;
+	size_t sz_Unmet;
+
+	size_t sz_References;
+	int s32_Finished;
+	int s32_Result;
+	int s32_Failed;
+};
+
+#ifdef LIN99_THREADS
+/**
+ * asyncpool_t - State shared between the submitting threads and the executor threads.
+ *
+ * Members:
+ * - mtx_Queue: Protects every field below and every task's bookkeeping fields.
+ * - cnd_Ready: Signalled when a task is queued or the executor is shutting down.
+ * - cnd_Done: Broadcast whenever a task finishes.
+ * - a_Workers/sz_Workers: Executor threads.
+ * - sz_Threads: Requested executor thread count, 0 for pargetthreads().
+ * - pa_Head/pa_Tail: Ready queue, run in submission order.
+ * - sz_Outstanding: Submitted tasks that have not finished yet.
+ * - s32_Shutdown: Tells the executor threads to exit.
+ */
+typedef struct __asyncpool_t {
+	pthread_mutex_t mtx_Queue;
+	pthread_cond_t cnd_Ready;
+	pthread_cond_t cnd_Done;
+
+	pthread_t a_Workers[ASYNC_MAX_THREADS];
+	size_t sz_Workers;
+	size_t sz_Threads;
+
+	asynctask_t* pa_Head;
+	asynctask_t* pa_Tail;
+	size_t sz_Outstanding;
+	int s32_Shutdown;
+} asyncpool_t;
+
+static asyncpool_t g_Async = {
+	.mtx_Queue = PTHREAD_MUTEX_INITIALIZER,
+	.cnd_Ready = PTHREAD_COND_INITIALIZER,
+	.cnd_Done = PTHREAD_COND_INITIALIZER
+};
+#endif // LIN99_THREADS
+
+static void asynclock(void) {
+#ifdef LIN99_THREADS
+	pthread_mutex_lock(&g_Async.mtx_Queue);
+#endif
+	return;
+}
+
+static void asyncunlock(void) {
+#ifdef LIN99_THREADS
+	pthread_mutex_unlock(&g_Async.mtx_Queue);
+#endif
+	return;
+}
+
+#ifdef LIN99_THREADS
+// Caller must hold the lock.  Appends a task whose dependencies have all finished to the ready queue.
+static void asyncqueue(asynctask_t* pa_Task) {
+	pa_Task->pa_Next = NULL;
+	if (g_Async.pa_Tail != NULL) {
+		g_Async.pa_Tail->pa_Next = pa_Task;
+	}
+	else {
+		g_Async.pa_Head = pa_Task;
+	}
+	g_Async.pa_Tail = pa_Task;
+	pthread_cond_signal(&g_Async.cnd_Ready);
+	return;
+}
+#endif
+
+// Caller must hold the lock.  Frees the task once the last reference is gone.
+static void asyncdrop(asynctask_t* pa_Task) {
+	if (--pa_Task->sz_References == 0) {
+		free(pa_Task->ppa_Successors);
+		free(pa_Task);
+	}
+	return;
+}
+
+// Caller must hold the lock.  Records the result and queues every successor whose last dependency this was.
+static void asyncfinish(asynctask_t* pa_Task, const int cs32_Result) {
+	pa_Task->s32_Result = cs32_Result;
+	pa_Task->s32_Finished = 1;
+
+	for (size_t sz_Successor = 0; sz_Successor < pa_Task->sz_Successors; ++sz_Successor) {
+		asynctask_t* pa_Successor = pa_Task->ppa_Successors[sz_Successor];
+
+		if (cs32_Result != 0) {
+			pa_Successor->s32_Failed = 1;
+		}
+#ifdef LIN99_THREADS
+		if (--pa_Successor->sz_Unmet == 0) {
+			asyncqueue(pa_Successor);
+		}
+#endif
+	}
+
+	free(pa_Task->ppa_Successors);
+	pa_Task->ppa_Successors = NULL;
+	pa_Task->sz_Successors = 0;
+	pa_Task->sz_Capacity = 0;
+
+#ifdef LIN99_THREADS
+	--g_Async.sz_Outstanding;
+	pthread_cond_broadcast(&g_Async.cnd_Done);
+#endif
+	asyncdrop(pa_Task);
+	return;
+}
+
+// Runs one task outside the lock and finishes it under the lock
+static void asyncrun(asynctask_t* pa_Task) {
+	const int cs32_Result = pa_Task->s32_Failed ? -1 : ((pa_Task->pfn_Operation(pa_Task->p_Context) == 0) ? 0 : -1);
+
+	asynclock();
+	asyncfinish(pa_Task, cs32_Result);
+	asyncunlock();
+	return;
+}
+
+#ifdef LIN99_THREADS
+static void* asyncworker(void* p_Argument) {
+	(void)p_Argument;
+
+	pthread_mutex_lock(&g_Async.mtx_Queue);
+	for (;;) {
+		while (g_Async.pa_Head == NULL && !g_Async.s32_Shutdown) {
+			pthread_cond_wait(&g_Async.cnd_Ready, &g_Async.mtx_Queue);
+		}
+		if (g_Async.pa_Head == NULL) {
+			break;
+		}
+
+		asynctask_t* pa_Task = g_Async.pa_Head;
+		g_Async.pa_Head = pa_Task->pa_Next;
+		if (g_Async.pa_Head == NULL) {
+			g_Async.pa_Tail = NULL;
+		}
+
+		pthread_mutex_unlock(&g_Async.mtx_Queue);
+		asyncrun(pa_Task);
+		pthread_mutex_lock(&g_Async.mtx_Queue);
+	}
+	pthread_mutex_unlock(&g_Async.mtx_Queue);
+
+	return NULL;
+}
+
+// Caller must hold the lock.  Returns the number of running executor threads, which may be fewer than requested.
+static size_t asyncstart(void) {
+	size_t sz_Threads = (g_Async.sz_Threads != 0) ? g_Async.sz_Threads : pargetthreads();
+
+	if (sz_Threads > ASYNC_MAX_THREADS) {
+		sz_Threads = ASYNC_MAX_THREADS;
+	}
+	while (g_Async.sz_Workers < sz_Threads) {
+		if (pthread_create(&g_Async.a_Workers[g_Async.sz_Workers], NULL, asyncworker, NULL) != 0) {
+			break;
+		}
+		++g_Async.sz_Workers;
+	}
+	return g_Async.sz_Workers;
+}
+#endif // LIN99_THREADS
+
+void asyncthreads(const size_t csz_Threads) {
+#ifdef LIN99_THREADS
+	asyncdrain();
+
+	pthread_mutex_lock(&g_Async.mtx_Queue);
+	g_Async.s32_Shutdown = 1;
+	pthread_cond_broadcast(&g_Async.cnd_Ready);
+	pthread_mutex_unlock(&g_Async.mtx_Queue);
+
+	for (size_t sz_Worker = 0; sz_Worker < g_Async.sz_Workers; ++sz_Worker) {
+		pthread_join(g_Async.a_Workers[sz_Worker], NULL);
+	}
+
+	pthread_mutex_lock(&g_Async.mtx_Queue);
+	g_Async.sz_Workers = 0;
+	g_Async.s32_Shutdown = 0;
+	g_Async.sz_Threads = (csz_Threads > ASYNC_MAX_THREADS) ? ASYNC_MAX_THREADS : csz_Threads;
+	pthread_mutex_unlock(&g_Async.mtx_Queue);
+#else
+	(void)csz_Threads;
+#endif
+	return;
+}
+
+asynctask_t* asyncsubmit(int (*pfn_Operation)(void*), void* p_Context, asynctask_t* const* cpa_Depends, const size_t csz_Depends) {
+	if (pfn_Operation == NULL || (cpa_Depends == NULL && csz_Depends != 0)) {
+		printf("NULL REFERENCE PASSED!\n");
+		return NULL;
+	}
+	for (size_t sz_Depend = 0; sz_Depend < csz_Depends; ++sz_Depend) {
+		if (cpa_Depends[sz_Depend] == NULL) {
+			printf("NULL REFERENCE PASSED!\n");
+			return NULL;
+		}
+	}
+
+	asynctask_t* pa_Task = calloc(1, sizeof(asynctask_t));
+	if (pa_Task == NULL) {
+		printf("MEMORY NOT FOUND!\n");
+		return NULL;
+	}
+	pa_Task->pfn_Operation = pfn_Operation;
+	pa_Task->p_Context = p_Context;
+	pa_Task->sz_References = 2;
+
+	asynclock();
+
+	// Make room in every unfinished dependency first, so a failed allocation leaves nothing linked
+	for (size_t sz_Depend = 0; sz_Depend < csz_Depends; ++sz_Depend) {
+		asynctask_t* pa_Depend = cpa_Depends[sz_Depend];
+
+		if (!pa_Depend->s32_Finished && pa_Depend->sz_Successors + csz_Depends > pa_Depend->sz_Capacity) {
+			const size_t csz_Capacity = 2 * pa_Depend->sz_Capacity + csz_Depends;
+			asynctask_t** ppa_Successors = realloc(pa_Depend->ppa_Successors, csz_Capacity * sizeof(asynctask_t*));
+
+			if (ppa_Successors == NULL) {
+				asyncunlock();
+				free(pa_Task);
+				printf("MEMORY NOT FOUND!\n");
+				return NULL;
+			}
+			pa_Depend->ppa_Successors = ppa_Successors;
+			pa_Depend->sz_Capacity = csz_Capacity;
+		}
+	}
+
+	for (size_t sz_Depend = 0; sz_Depend < csz_Depends; ++sz_Depend) {
+		asynctask_t* pa_Depend = cpa_Depends[sz_Depend];
+
+		if (pa_Depend->s32_Finished) {
+			if (pa_Depend->s32_Result != 0) {
+				pa_Task->s32_Failed = 1;
+			}
+			continue;
+		}
+		pa_Depend->ppa_Successors[pa_Depend->sz_Successors++] = pa_Task;
+		++pa_Task->sz_Unmet;
+	}
+
+#ifdef LIN99_THREADS
+	++g_Async.sz_Outstanding;
+
+	// Without any executor thread every earlier task has already finished, so this one runs inline below
+	if (asyncstart() != 0) {
+		if (pa_Task->sz_Unmet == 0) {
+			asyncqueue(pa_Task);
+		}
+		pthread_mutex_unlock(&g_Async.mtx_Queue);
+		return pa_Task;
+	}
+#endif
+
+	asyncunlock();
+	asyncrun(pa_Task);
+	return pa_Task;
+}
+
+int asyncpoll(asynctask_t* pa_Task) {
+	if (pa_Task == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	asynclock();
+	const int cs32_Finished = pa_Task->s32_Finished;
+	asyncunlock();
+
+	return cs32_Finished;
+}
+
+int asyncwait(asynctask_t* pa_Task) {
+	if (pa_Task == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	asynclock();
+#ifdef LIN99_THREADS
+	while (!pa_Task->s32_Finished) {
+		pthread_cond_wait(&g_Async.cnd_Done, &g_Async.mtx_Queue);
+	}
+#endif
+	const int cs32_Result = pa_Task->s32_Result;
+	asyncunlock();
+
+	return cs32_Result;
+}
+
+void asyncdrain(void) {
+#ifdef LIN99_THREADS
+	pthread_mutex_lock(&g_Async.mtx_Queue);
+	while (g_Async.sz_Outstanding != 0) {
+		pthread_cond_wait(&g_Async.cnd_Done, &g_Async.mtx_Queue);
+	}
+	pthread_mutex_unlock(&g_Async.mtx_Queue);
+#endif
+	return;
+}
+
+void asyncrelease(asynctask_t* pa_Task) {
+	if (pa_Task == NULL) {
+		return;
+	}
+
+	asynclock();
+	asyncdrop(pa_Task);
+	asyncunlock();
+	return;
+}
@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "lin99/vector.h"
+#include "lin99/parallel.h"
+#include "lin99/conv.h"
+#include "internal.h"
+
+// Filters at least this long are convolved through the FFT
+#define CONV_FFT_THRESHOLD  	48
+// Outputs the direct kernel accumulates at once, kept in L1 while the filter streams past
+#define CONV_BLOCK          	256
+// Multiply-adds worth handing to one thread
+#define CONV_PARALLEL_WORK  	65536
+// Butterflies and spectrum products handled per vectorised step; also the shortest FFT length
+#define CONV_LANES          	16
+// Longest transform considered when choosing the FFT block length
+#define CONV_MAX_FFT        	((size_t)1 << 20)
+
+#define CONV_PI             	3.14159265358979323846
+
+/**
+ * convargs_t - One convolution y = x * h restricted to the outputs [sz_Begin, sz_Begin + sz_Count), shared by every chunk.
+ *
+ * Members:
+ * - p_Out: Destination of output sz_Begin.
+ * - cp_X/sz_N: Signal.
+ * - cp_H/sz_K: Filter, never longer than the signal.
+ * - sz_L/sz_Block: FFT length and the number of outputs one transform yields (sz_L - sz_K + 1).
+ * - p_TwRe/p_TwIm: Twiddle factors; those of the stage with half-length h start at offset h - 1.
+ * - p_HRe/p_HIm: Transform of the zero-padded filter in bit-reversed order, scaled by 1 / sz_L.
+ * - p_Scratch: Two sz_L element blocks per chunk.
+ */
+typedef struct __convargs_t {
+	void* p_Out;
+	size_t sz_Begin;
+	size_t sz_Count;
+	const void* cp_X;
+	size_t sz_N;
+	const void* cp_H;
+	size_t sz_K;
+	size_t sz_L;
+	size_t sz_Block;
+	void* p_TwRe;
+	void* p_TwIm;
+	void* p_HRe;
+	void* p_HIm;
+	void* p_Scratch;
+} convargs_t;
+
+// Power of two FFT length with the least transform work per output, at least twice the filter length and CONV_LANES
+static size_t convfftsize(const size_t csz_K, const size_t csz_Count) {
+	size_t sz_Best = 0;
+	double f64_Best = 0.0;
+	size_t sz_Log = 0;
+	size_t sz_L = 1;
+
+	while (sz_L < 2 * csz_K || sz_L < CONV_LANES) {
+		sz_L *= 2;
+		++sz_Log;
+	}
+
+	for (;;) {
+		const double cf64_Cost = (double)(sz_L * sz_Log) / (double)(sz_L - csz_K + 1);
+		if (sz_Best == 0 || cf64_Cost < f64_Best) {
+			sz_Best = sz_L;
+			f64_Best = cf64_Cost;
+		}
+		// A block covering every requested output cannot be beaten by a longer one
+		if (sz_L - csz_K + 1 >= csz_Count || sz_L >= CONV_MAX_FFT) {
+			break;
+		}
+		sz_L *= 2;
+		++sz_Log;
+	}
+	return sz_Best;
+}
+
+/**
+ * CONV_KERNEL_DEF - Generates the direct and FFT convolution paths for one floating point type.
+ *
+ * The direct kernel accumulates CONV_BLOCK outputs at a time, four filter taps per pass away from the ends of
+ * the signal.  The FFT path cuts the requested outputs into blocks of sz_Block; block b needs the sz_L signal
+ * elements ending at its last output, and the last sz_Block elements of their circular convolution with the
+ * filter are exactly its outputs.  Blocks therefore write disjoint outputs and are independent, so they are
+ * split across threads without any reduction.  Two blocks share each complex transform as its real and
+ * imaginary parts, which is exact because the filter is real.  The forward transform is decimation-in-frequency
+ * and the inverse decimation-in-time, so the spectrum stays in bit-reversed order and no permutation pass is
+ * needed.
+ *
+ * The inner loops live in small helpers over restrict-qualified pointers with a trip count of CONV_LANES or
+ * CONV_BLOCK, which is what lets the compiler turn them into vector code at -O2.
+ */
+#define CONV_KERNEL_DEF(type, abbr) \
+static inline void convquad##abbr(type* restrict p_Y, const type* restrict cp_S, const type* cp_H, const size_t csz_Count) { \
+	const type ct_H0 = cp_H[0]; \
+	const type ct_H1 = cp_H[1]; \
+	const type ct_H2 = cp_H[2]; \
+	const type ct_H3 = cp_H[3]; \
+	for (size_t sz_I = 0; sz_I < csz_Count; ++sz_I) { \
+		p_Y[sz_I] += ct_H0 * cp_S[sz_I + 3] + ct_H1 * cp_S[sz_I + 2] + ct_H2 * cp_S[sz_I + 1] + ct_H3 * cp_S[sz_I]; \
+	} \
+	return; \
+} \
+\
+/* y[n] += h[j] * x[n - j] for the outputs n in [sz_Lo, sz_Hi) of the block with 0 <= n - j < N */ \
+static void convtap##abbr(type* p_Block, const size_t csz_Lo, const size_t csz_Hi, const convargs_t* cp_Args, const size_t csz_J) { \
+	const size_t csz_First = (csz_Lo > csz_J) ? csz_Lo : csz_J; \
+	const size_t csz_Last = (csz_Hi < cp_Args->sz_N + csz_J) ? csz_Hi : cp_Args->sz_N + csz_J; \
+	if (csz_First >= csz_Last) { \
+		return; \
+	} \
+	\
+	type* restrict p_Y = p_Block + (csz_First - csz_Lo); \
+	const type* restrict cp_S = (const type*)cp_Args->cp_X + (csz_First - csz_J); \
+	const type ct_H = ((const type*)cp_Args->cp_H)[csz_J]; \
+	for (size_t sz_I = 0; sz_I < csz_Last - csz_First; ++sz_I) { \
+		p_Y[sz_I] += ct_H * cp_S[sz_I]; \
+	} \
+	return; \
+} \
+\
+static void convdirect##abbr(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) { \
+	const convargs_t* cp_Args = (const convargs_t*)p_Context; \
+	const type* cp_X = (const type*)cp_Args->cp_X; \
+	const type* cp_H = (const type*)cp_Args->cp_H; \
+	const size_t csz_End = cp_Args->sz_Begin + sz_End; \
+	(void)sz_Chunk; \
+	\
+	for (size_t sz_Lo = cp_Args->sz_Begin + sz_Begin; sz_Lo < csz_End; sz_Lo += CONV_BLOCK) { \
+		const size_t csz_Hi = (csz_End - sz_Lo < CONV_BLOCK) ? csz_End : sz_Lo + CONV_BLOCK; \
+		type* p_Block = (type*)cp_Args->p_Out + (sz_Lo - cp_Args->sz_Begin); \
+		size_t sz_J = 0; \
+		\
+		memset(p_Block, 0, (csz_Hi - sz_Lo) * sizeof(type)); \
+		for (; sz_J + 4 <= cp_Args->sz_K; sz_J += 4) { \
+			if (sz_Lo < sz_J + 3 || csz_Hi > cp_Args->sz_N + sz_J) { \
+				/* Near the ends of the signal the four taps cover different outputs */ \
+				for (size_t sz_Tap = sz_J; sz_Tap < sz_J + 4; ++sz_Tap) { \
+					convtap##abbr(p_Block, sz_Lo, csz_Hi, cp_Args, sz_Tap); \
+				} \
+			} else if (csz_Hi - sz_Lo == CONV_BLOCK) { \
+				convquad##abbr(p_Block, cp_X + (sz_Lo - sz_J - 3), cp_H + sz_J, CONV_BLOCK); \
+			} else { \
+				convquad##abbr(p_Block, cp_X + (sz_Lo - sz_J - 3), cp_H + sz_J, csz_Hi - sz_Lo); \
+			} \
+		} \
+		for (; sz_J < cp_Args->sz_K; ++sz_J) { \
+			convtap##abbr(p_Block, sz_Lo, csz_Hi, cp_Args, sz_J); \
+		} \
+	} \
+	return; \
+} \
+\
+/* CONV_LANES forward butterflies: (a, b) becomes (a + b, (a - b) * w) */ \
+static inline void convdif##abbr(type* restrict p_ARe, type* restrict p_AIm, type* restrict p_BRe, type* restrict p_BIm, \
+	const type* restrict cp_WRe, const type* restrict cp_WIm) { \
+	for (size_t sz_J = 0; sz_J < CONV_LANES; ++sz_J) { \
+		const type ct_DRe = p_ARe[sz_J] - p_BRe[sz_J]; \
+		const type ct_DIm = p_AIm[sz_J] - p_BIm[sz_J]; \
+		p_ARe[sz_J] += p_BRe[sz_J]; \
+		p_AIm[sz_J] += p_BIm[sz_J]; \
+		p_BRe[sz_J] = ct_DRe * cp_WRe[sz_J] - ct_DIm * cp_WIm[sz_J]; \
+		p_BIm[sz_J] = ct_DRe * cp_WIm[sz_J] + ct_DIm * cp_WRe[sz_J]; \
+	} \
+	return; \
+} \
+\
+/* CONV_LANES inverse butterflies: (a, b) becomes (a + b * conj(w), a - b * conj(w)) */ \
+static inline void convdit##abbr(type* restrict p_ARe, type* restrict p_AIm, type* restrict p_BRe, type* restrict p_BIm, \
+	const type* restrict cp_WRe, const type* restrict cp_WIm) { \
+	for (size_t sz_J = 0; sz_J < CONV_LANES; ++sz_J) { \
+		const type ct_TRe = p_BRe[sz_J] * cp_WRe[sz_J] + p_BIm[sz_J] * cp_WIm[sz_J]; \
+		const type ct_TIm = p_BIm[sz_J] * cp_WRe[sz_J] - p_BRe[sz_J] * cp_WIm[sz_J]; \
+		p_BRe[sz_J] = p_ARe[sz_J] - ct_TRe; \
+		p_BIm[sz_J] = p_AIm[sz_J] - ct_TIm; \
+		p_ARe[sz_J] += ct_TRe; \
+		p_AIm[sz_J] += ct_TIm; \
+	} \
+	return; \
+} \
+\
+/* CONV_LANES complex products x * y, stored back into x */ \
+static inline void convproduct##abbr(type* restrict p_Re, type* restrict p_Im, const type* restrict cp_YRe, const type* restrict cp_YIm) { \
+	for (size_t sz_J = 0; sz_J < CONV_LANES; ++sz_J) { \
+		const type ct_Re = p_Re[sz_J] * cp_YRe[sz_J] - p_Im[sz_J] * cp_YIm[sz_J]; \
+		const type ct_Im = p_Re[sz_J] * cp_YIm[sz_J] + p_Im[sz_J] * cp_YRe[sz_J]; \
+		p_Re[sz_J] = ct_Re; \
+		p_Im[sz_J] = ct_Im; \
+	} \
+	return; \
+} \
+\
+/* Stages shorter than CONV_LANES run scalar, the rest CONV_LANES butterflies at a time */ \
+static void convfft##abbr(type* p_Re, type* p_Im, const type* cp_TwRe, const type* cp_TwIm, const size_t csz_L) { \
+	for (size_t sz_Half = csz_L / 2; sz_Half != 0; sz_Half /= 2) { \
+		const type* cp_WRe = cp_TwRe + sz_Half - 1; \
+		const type* cp_WIm = cp_TwIm + sz_Half - 1; \
+		for (size_t sz_Start = 0; sz_Start < csz_L; sz_Start += 2 * sz_Half) { \
+			type* p_ARe = p_Re + sz_Start; \
+			type* p_AIm = p_Im + sz_Start; \
+			if (sz_Half >= CONV_LANES) { \
+				for (size_t sz_J = 0; sz_J < sz_Half; sz_J += CONV_LANES) { \
+					convdif##abbr(p_ARe + sz_J, p_AIm + sz_J, p_ARe + sz_Half + sz_J, p_AIm + sz_Half + sz_J, cp_WRe + sz_J, cp_WIm + sz_J); \
+				} \
+				continue; \
+			} \
+			for (size_t sz_J = 0; sz_J < sz_Half; ++sz_J) { \
+				const type ct_DRe = p_ARe[sz_J] - p_ARe[sz_Half + sz_J]; \
+				const type ct_DIm = p_AIm[sz_J] - p_AIm[sz_Half + sz_J]; \
+				p_ARe[sz_J] += p_ARe[sz_Half + sz_J]; \
+				p_AIm[sz_J] += p_AIm[sz_Half + sz_J]; \
+				p_ARe[sz_Half + sz_J] = ct_DRe * cp_WRe[sz_J] - ct_DIm * cp_WIm[sz_J]; \
+				p_AIm[sz_Half + sz_J] = ct_DRe * cp_WIm[sz_J] + ct_DIm * cp_WRe[sz_J]; \
+			} \
+		} \
+	} \
+	return; \
+} \
+\
+static void convifft##abbr(type* p_Re, type* p_Im, const type* cp_TwRe, const type* cp_TwIm, const size_t csz_L) { \
+	for (size_t sz_Half = 1; sz_Half < csz_L; sz_Half *= 2) { \
+		const type* cp_WRe = cp_TwRe + sz_Half - 1; \
+		const type* cp_WIm = cp_TwIm + sz_Half - 1; \
+		for (size_t sz_Start = 0; sz_Start < csz_L; sz_Start += 2 * sz_Half) { \
+			type* p_ARe = p_Re + sz_Start; \
+			type* p_AIm = p_Im + sz_Start; \
+			if (sz_Half >= CONV_LANES) { \
+				for (size_t sz_J = 0; sz_J < sz_Half; sz_J += CONV_LANES) { \
+					convdit##abbr(p_ARe + sz_J, p_AIm + sz_J, p_ARe + sz_Half + sz_J, p_AIm + sz_Half + sz_J, cp_WRe + sz_J, cp_WIm + sz_J); \
+				} \
+				continue; \
+			} \
+			for (size_t sz_J = 0; sz_J < sz_Half; ++sz_J) { \
+				const type ct_TRe = p_ARe[sz_Half + sz_J] * cp_WRe[sz_J] + p_AIm[sz_Half + sz_J] * cp_WIm[sz_J]; \
+				const type ct_TIm = p_AIm[sz_Half + sz_J] * cp_WRe[sz_J] - p_ARe[sz_Half + sz_J] * cp_WIm[sz_J]; \
+				p_ARe[sz_Half + sz_J] = p_ARe[sz_J] - ct_TRe; \
+				p_AIm[sz_Half + sz_J] = p_AIm[sz_J] - ct_TIm; \
+				p_ARe[sz_J] += ct_TRe; \
+				p_AIm[sz_J] += ct_TIm; \
+			} \
+		} \
+	} \
+	return; \
+} \
+\
+/* Signal elements x[n + m - (K - 1)] for m in [0, L) feeding the block whose first output is n, zero outside x */ \
+static void convsegment##abbr(type* p_Segment, const convargs_t* cp_Args, const size_t csz_First) { \
+	const size_t csz_Lead = cp_Args->sz_K - 1; \
+	const size_t csz_Lo = (csz_First < csz_Lead) ? csz_Lead - csz_First : 0; \
+	size_t sz_Hi = (cp_Args->sz_N + csz_Lead > csz_First) ? cp_Args->sz_N + csz_Lead - csz_First : 0; \
+	\
+	sz_Hi = (sz_Hi < cp_Args->sz_L) ? sz_Hi : cp_Args->sz_L; \
+	sz_Hi = (sz_Hi > csz_Lo) ? sz_Hi : csz_Lo; \
+	memset(p_Segment, 0, csz_Lo * sizeof(type)); \
+	memcpy(p_Segment + csz_Lo, (const type*)cp_Args->cp_X + (csz_First + csz_Lo - csz_Lead), (sz_Hi - csz_Lo) * sizeof(type)); \
+	memset(p_Segment + sz_Hi, 0, (cp_Args->sz_L - sz_Hi) * sizeof(type)); \
+	return; \
+} \
+\
+/* FFT chunk: pairs of blocks [sz_Begin, sz_End), each pair sharing one transform */ \
+static void convblocks##abbr(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) { \
+	const convargs_t* cp_Args = (const convargs_t*)p_Context; \
+	const size_t csz_L = cp_Args->sz_L; \
+	const size_t csz_Lead = cp_Args->sz_K - 1; \
+	const size_t csz_End = cp_Args->sz_Begin + cp_Args->sz_Count; \
+	const type* cp_HRe = (const type*)cp_Args->p_HRe; \
+	const type* cp_HIm = (const type*)cp_Args->p_HIm; \
+	type* p_Re = (type*)cp_Args->p_Scratch + sz_Chunk * 2 * csz_L; \
+	type* p_Im = p_Re + csz_L; \
+	\
+	for (size_t sz_Pair = sz_Begin; sz_Pair < sz_End; ++sz_Pair) { \
+		const size_t csz_First0 = cp_Args->sz_Begin + 2 * sz_Pair * cp_Args->sz_Block; \
+		const size_t csz_First1 = csz_First0 + cp_Args->sz_Block; \
+		\
+		convsegment##abbr(p_Re, cp_Args, csz_First0); \
+		if (csz_First1 < csz_End) { \
+			convsegment##abbr(p_Im, cp_Args, csz_First1); \
+		} else { \
+			memset(p_Im, 0, csz_L * sizeof(type)); \
+		} \
+		\
+		convfft##abbr(p_Re, p_Im, (const type*)cp_Args->p_TwRe, (const type*)cp_Args->p_TwIm, csz_L); \
+		for (size_t sz_K = 0; sz_K < csz_L; sz_K += CONV_LANES) { \
+			convproduct##abbr(p_Re + sz_K, p_Im + sz_K, cp_HRe + sz_K, cp_HIm + sz_K); \
+		} \
+		convifft##abbr(p_Re, p_Im, (const type*)cp_Args->p_TwRe, (const type*)cp_Args->p_TwIm, csz_L); \
+		\
+		type* p_Out = (type*)cp_Args->p_Out + (csz_First0 - cp_Args->sz_Begin); \
+		memcpy(p_Out, p_Re + csz_Lead, ((csz_End - csz_First0 < cp_Args->sz_Block) ? csz_End - csz_First0 : cp_Args->sz_Block) * sizeof(type)); \
+		if (csz_First1 < csz_End) { \
+			memcpy(p_Out + cp_Args->sz_Block, p_Im + csz_Lead, ((csz_End - csz_First1 < cp_Args->sz_Block) ? csz_End - csz_First1 : cp_Args->sz_Block) * sizeof(type)); \
+		} \
+	} \
+	return; \
+} \
+\
+static int convrun##abbr(const vector_t* cpv_Result, type* p_Out, const size_t csz_Begin, const size_t csz_Count, \
+	const type* cp_X, const size_t csz_N, const type* cp_H, const size_t csz_K) { \
+	convargs_t s_Args = { 0 }; \
+	s_Args.p_Out = p_Out; \
+	s_Args.sz_Begin = csz_Begin; \
+	s_Args.sz_Count = csz_Count; \
+	s_Args.cp_X = cp_X; \
+	s_Args.sz_N = csz_N; \
+	s_Args.cp_H = cp_H; \
+	s_Args.sz_K = csz_K; \
+	\
+	if (csz_K < CONV_FFT_THRESHOLD) { \
+		return parfor(csz_Count, CONV_PARALLEL_WORK / csz_K, convdirect##abbr, &s_Args); \
+	} \
+	\
+	const size_t csz_L = convfftsize(csz_K, csz_Count); \
+	s_Args.sz_L = csz_L; \
+	s_Args.sz_Block = csz_L - csz_K + 1; \
+	\
+	const size_t csz_Blocks = (csz_Count + s_Args.sz_Block - 1) / s_Args.sz_Block; \
+	const size_t csz_Pairs = (csz_Blocks + 1) / 2; \
+	const size_t csz_Chunks = parchunks(csz_Pairs, 1); \
+	type* p_Work = (type*)cpv_Result->pfn_Allocate((4 + 2 * csz_Chunks) * csz_L * sizeof(type)); \
+	if (!CHECK_ALLOCATION(p_Work)) { \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	\
+	type* p_TwRe = p_Work; \
+	type* p_TwIm = p_TwRe + csz_L; \
+	type* p_HRe = p_TwIm + csz_L; \
+	type* p_HIm = p_HRe + csz_L; \
+	for (size_t sz_Half = 1; sz_Half < csz_L; sz_Half *= 2) { \
+		for (size_t sz_J = 0; sz_J < sz_Half; ++sz_J) { \
+			p_TwRe[sz_Half - 1 + sz_J] = (type)cos(CONV_PI * (double)sz_J / (double)sz_Half); \
+			p_TwIm[sz_Half - 1 + sz_J] = (type)-sin(CONV_PI * (double)sz_J / (double)sz_Half); \
+		} \
+	} \
+	\
+	memcpy(p_HRe, cp_H, csz_K * sizeof(type)); \
+	memset(p_HRe + csz_K, 0, (csz_L - csz_K) * sizeof(type)); \
+	memset(p_HIm, 0, csz_L * sizeof(type)); \
+	convfft##abbr(p_HRe, p_HIm, p_TwRe, p_TwIm, csz_L); \
+	for (size_t sz_K = 0; sz_K < csz_L; ++sz_K) { \
+		p_HRe[sz_K] /= (type)csz_L; \
+		p_HIm[sz_K] /= (type)csz_L; \
+	} \
+	\
+	s_Args.p_TwRe = p_TwRe; \
+	s_Args.p_TwIm = p_TwIm; \
+	s_Args.p_HRe = p_HRe; \
+	s_Args.p_HIm = p_HIm; \
+	s_Args.p_Scratch = p_HIm + csz_L; \
+	\
+	const int cs32_Status = parfor(csz_Pairs, 1, convblocks##abbr, &s_Args); \
+	cpv_Result->pfn_Free(p_Work); \
+	return cs32_Status; \
+}
+
+CONV_KERNEL_DEF(float, FP32)
+CONV_KERNEL_DEF(double, FP64)
+
+// Validates the operands and works out which part of the full result the mode asks for
+static int convcheck(vector_t* pv_Result, const vector_t* cpv_Signal, const vector_t* cpv_Other, const int cs32_Mode, size_t* psz_Begin) {
+	if (vctunique(pv_Result) != 0) {
+		return -1;
+	}
+
+	if (vctmemchk(pv_Result) != 0                               ||
+	vctmemchk(cpv_Signal) != 0                                  ||
+	vctmemchk(cpv_Other) != 0                                   ||
+	cpv_Signal->s32_Type != cpv_Other->s32_Type                 ||
+	pv_Result->s32_Type != cpv_Signal->s32_Type                 ||
+	cpv_Signal->sz_ElementSize != cpv_Other->sz_ElementSize     ||
+	pv_Result->sz_ElementSize != cpv_Signal->sz_ElementSize     ||
+	mtxoverlap(pv_Result->p_StorageBuffer, pv_Result->sz_BufferSize, cpv_Signal->p_StorageBuffer, cpv_Signal->sz_BufferSize) ||
+	mtxoverlap(pv_Result->p_StorageBuffer, pv_Result->sz_BufferSize, cpv_Other->p_StorageBuffer, cpv_Other->sz_BufferSize)) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!(cpv_Signal->s32_Type == TYPE_FP32 && cpv_Signal->sz_ElementSize == sizeof(float)) &&
+	!(cpv_Signal->s32_Type == TYPE_FP64 && cpv_Signal->sz_ElementSize == sizeof(double))) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	const size_t csz_N = cpv_Signal->sz_ElementCount;
+	const size_t csz_K = cpv_Other->sz_ElementCount;
+	const size_t csz_Short = (csz_N < csz_K) ? csz_N : csz_K;
+	size_t sz_Count;
+
+	switch (cs32_Mode) {
+		case CONV_MODE_FULL:
+			*psz_Begin = 0;
+			sz_Count = csz_N + csz_K - 1;
+			break;
+		case CONV_MODE_SAME:
+			*psz_Begin = (csz_K - 1) / 2;
+			sz_Count = csz_N;
+			break;
+		case CONV_MODE_VALID:
+			*psz_Begin = csz_Short - 1;
+			sz_Count = csz_N + csz_K - 2 * csz_Short + 1;
+			break;
+		default:
+			printf("UNKNOWN MODE!\n");
+			return -1;
+	}
+
+	if (pv_Result->sz_ElementCount != sz_Count) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+	return 0;
+}
+
+// Convolution commutes, so the shorter operand always plays the filter
+static int convdispatch(vector_t* pv_Result, const size_t csz_Begin, const void* cp_A, const size_t csz_A, const void* cp_B, const size_t csz_B) {
+	const void* cp_X = (csz_A >= csz_B) ? cp_A : cp_B;
+	const void* cp_H = (csz_A >= csz_B) ? cp_B : cp_A;
+	const size_t csz_N = (csz_A >= csz_B) ? csz_A : csz_B;
+	const size_t csz_K = (csz_A >= csz_B) ? csz_B : csz_A;
+
+	if (pv_Result->s32_Type == TYPE_FP32) {
+		return convrunFP32(pv_Result, (float*)pv_Result->p_StorageBuffer, csz_Begin, pv_Result->sz_ElementCount, (const float*)cp_X, csz_N, (const float*)cp_H, csz_K);
+	}
+	return convrunFP64(pv_Result, (double*)pv_Result->p_StorageBuffer, csz_Begin, pv_Result->sz_ElementCount, (const double*)cp_X, csz_N, (const double*)cp_H, csz_K);
+}
+
+int vctconv(vector_t* pv_Result, const vector_t* cpv_Signal, const vector_t* cpv_Filter, const int cs32_Mode) {
+	if (pv_Result == NULL || cpv_Signal == NULL || cpv_Filter == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	size_t sz_Begin;
+	if (convcheck(pv_Result, cpv_Signal, cpv_Filter, cs32_Mode, &sz_Begin) != 0) {
+		return -1;
+	}
+
+	return convdispatch(pv_Result, sz_Begin, cpv_Signal->p_StorageBuffer, cpv_Signal->sz_ElementCount, cpv_Filter->p_StorageBuffer, cpv_Filter->sz_ElementCount);
+}
+
+int vctcorr(vector_t* pv_Result, const vector_t* cpv_Signal, const vector_t* cpv_Template, const int cs32_Mode) {
+	if (pv_Result == NULL || cpv_Signal == NULL || cpv_Template == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	size_t sz_Begin;
+	if (convcheck(pv_Result, cpv_Signal, cpv_Template, cs32_Mode, &sz_Begin) != 0) {
+		return -1;
+	}
+
+	// Correlating with t is convolving with t reversed
+	const size_t csz_Size = cpv_Template->sz_ElementSize;
+	const size_t csz_K = cpv_Template->sz_ElementCount;
+	uint8_t* pu8_Reversed = (uint8_t*)pv_Result->pfn_Allocate(csz_K * csz_Size);
+	if (!CHECK_ALLOCATION(pu8_Reversed)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	for (size_t sz_Idx = 0; sz_Idx < csz_K; ++sz_Idx) {
+		memcpy(pu8_Reversed + sz_Idx * csz_Size, (const uint8_t*)cpv_Template->p_StorageBuffer + (csz_K - 1 - sz_Idx) * csz_Size, csz_Size);
+	}
+
+	const int cs32_Status = convdispatch(pv_Result, sz_Begin, cpv_Signal->p_StorageBuffer, cpv_Signal->sz_ElementCount, pu8_Reversed, csz_K);
+	pv_Result->pfn_Free(pu8_Reversed);
+	return cs32_Status;
+}
@@ -0,0 +1,433 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "internal.h"
+
+// Rows of A and columns of the inner dimension kept hot in cache by the non-transposed kernel
+#define GEMM_ROW_BLOCK  	256
+#define GEMM_DEPTH_BLOCK	128
+// Independent partial sums for the transposed (dot product) kernel
+#define GEMM_LANES      	8
+// Columns of B whose depth slices the transposed kernel keeps in cache while sweeping the rows of A^T
+#define GEMM_COLUMN_BLOCK	16
+// Multiply-adds worth handing to another thread
+#define GEMM_PARALLEL_GRAIN	(1 << 20)
+// Square tile copied at once by mtxtrans so source and destination are both touched a cache line at a time
+#define TRANSPOSE_TILE  	32
+
+/**
+ * GEMM_KERNEL_DEF - Generates the serial and parallel column-major GEMM for one floating point type.
+ *
+ * C = alpha * op(A) * op(B) + beta * C, with op(X) = X or X^T as selected by GEMM_NORMAL/GEMM_TRANSPOSE.
+ * The non-transposed form streams columns of A into columns of C (axpy order), so the innermost loop is
+ * always unit-stride.  The transposed-A form computes dot products of columns instead, blocked over K and N
+ * the same way so a slice of B is reused by every column of A before it leaves cache.
+ */
+#define GEMM_KERNEL_DEF(type, abbr) \
+static void gemmserial##abbr(const int cs32_TransA, const int cs32_TransB, const size_t csz_M, const size_t csz_N, const size_t csz_K, \
+	const type ct_Alpha, const type* cp_A, const size_t csz_LdA, const type* cp_B, const size_t csz_LdB, \
+	const type ct_Beta, type* p_C, const size_t csz_LdC) { \
+	for (size_t sz_J = 0; sz_J < csz_N; ++sz_J) { \
+		type* p_Column = p_C + sz_J * csz_LdC; \
+		for (size_t sz_I = 0; sz_I < csz_M; ++sz_I) { \
+			p_Column[sz_I] = (ct_Beta == 0) ? 0 : ct_Beta * p_Column[sz_I]; \
+		} \
+	} \
+	\
+	if (ct_Alpha == 0 || csz_K == 0) { \
+		return; \
+	} \
+	\
+	if (cs32_TransA == GEMM_NORMAL) { \
+		for (size_t sz_I0 = 0; sz_I0 < csz_M; sz_I0 += GEMM_ROW_BLOCK) { \
+			const size_t csz_Rows = (csz_M - sz_I0 < GEMM_ROW_BLOCK) ? csz_M - sz_I0 : GEMM_ROW_BLOCK; \
+			for (size_t sz_P0 = 0; sz_P0 < csz_K; sz_P0 += GEMM_DEPTH_BLOCK) { \
+				const size_t csz_Depth = (csz_K - sz_P0 < GEMM_DEPTH_BLOCK) ? csz_K - sz_P0 : GEMM_DEPTH_BLOCK; \
+				for (size_t sz_J = 0; sz_J < csz_N; ++sz_J) { \
+					type* p_Column = p_C + sz_J * csz_LdC + sz_I0; \
+					for (size_t sz_P = sz_P0; sz_P < sz_P0 + csz_Depth; ++sz_P) { \
+						const type ct_Factor = ct_Alpha * ((cs32_TransB == GEMM_NORMAL) ? cp_B[sz_P + sz_J * csz_LdB] : cp_B[sz_J + sz_P * csz_LdB]); \
+						const type* cp_Column = cp_A + sz_P * csz_LdA + sz_I0; \
+						if (ct_Factor == 0) { \
+							continue; \
+						} \
+						for (size_t sz_I = 0; sz_I < csz_Rows; ++sz_I) { \
+							p_Column[sz_I] += ct_Factor * cp_Column[sz_I]; \
+						} \
+					} \
+				} \
+			} \
+		} \
+		return; \
+	} \
+	\
+	/* A slice of csz_Depth entries of each row of A^T is reused by a block of columns of B, and that block stays in cache over all of M */ \
+	for (size_t sz_P0 = 0; sz_P0 < csz_K; sz_P0 += GEMM_DEPTH_BLOCK) { \
+		const size_t csz_Depth = (csz_K - sz_P0 < GEMM_DEPTH_BLOCK) ? csz_K - sz_P0 : GEMM_DEPTH_BLOCK; \
+		for (size_t sz_J0 = 0; sz_J0 < csz_N; sz_J0 += GEMM_COLUMN_BLOCK) { \
+			const size_t csz_Cols = (csz_N - sz_J0 < GEMM_COLUMN_BLOCK) ? csz_N - sz_J0 : GEMM_COLUMN_BLOCK; \
+			for (size_t sz_I = 0; sz_I < csz_M; ++sz_I) { \
+				const type* cp_Row = cp_A + sz_I * csz_LdA + sz_P0; \
+				for (size_t sz_J = sz_J0; sz_J < sz_J0 + csz_Cols; ++sz_J) { \
+					type t_Sum = 0; \
+					\
+					if (cs32_TransB == GEMM_NORMAL) { \
+						const type* cp_Column = cp_B + sz_J * csz_LdB + sz_P0; \
+						type a_Lanes[GEMM_LANES] = {0}; \
+						size_t sz_P = 0; \
+						for (; sz_P + GEMM_LANES <= csz_Depth; sz_P += GEMM_LANES) { \
+							for (size_t sz_Lane = 0; sz_Lane < GEMM_LANES; ++sz_Lane) { \
+								a_Lanes[sz_Lane] += cp_Row[sz_P + sz_Lane] * cp_Column[sz_P + sz_Lane]; \
+							} \
+						} \
+						for (size_t sz_Lane = 0; sz_Lane < GEMM_LANES; ++sz_Lane) { \
+							t_Sum += a_Lanes[sz_Lane]; \
+						} \
+						for (; sz_P < csz_Depth; ++sz_P) { \
+							t_Sum += cp_Row[sz_P] * cp_Column[sz_P]; \
+						} \
+					} else { \
+						for (size_t sz_P = 0; sz_P < csz_Depth; ++sz_P) { \
+							t_Sum += cp_Row[sz_P] * cp_B[sz_J + (sz_P0 + sz_P) * csz_LdB]; \
+						} \
+					} \
+					\
+					p_C[sz_I + sz_J * csz_LdC] += ct_Alpha * t_Sum; \
+				} \
+			} \
+		} \
+	} \
+} \
+\
+typedef struct __gemmargs##abbr##_t { \
+	int s32_TransA; \
+	int s32_TransB; \
+	size_t sz_M; \
+	size_t sz_K; \
+	type t_Alpha; \
+	const type* cp_A; \
+	size_t sz_LdA; \
+	const type* cp_B; \
+	size_t sz_LdB; \
+	type t_Beta; \
+	type* p_C; \
+	size_t sz_LdC; \
+} gemmargs##abbr##_t; \
+\
+static void gemmchunk##abbr(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) { \
+	const gemmargs##abbr##_t* cp_Args = (const gemmargs##abbr##_t*)p_Context; \
+	const type* cp_B = cp_Args->cp_B + ((cp_Args->s32_TransB == GEMM_NORMAL) ? sz_Begin * cp_Args->sz_LdB : sz_Begin); \
+	(void)sz_Chunk; \
+	\
+	gemmserial##abbr(cp_Args->s32_TransA, cp_Args->s32_TransB, cp_Args->sz_M, sz_End - sz_Begin, cp_Args->sz_K, \
+		cp_Args->t_Alpha, cp_Args->cp_A, cp_Args->sz_LdA, cp_B, cp_Args->sz_LdB, \
+		cp_Args->t_Beta, cp_Args->p_C + sz_Begin * cp_Args->sz_LdC, cp_Args->sz_LdC); \
+} \
+\
+void gemm##abbr(const int cs32_TransA, const int cs32_TransB, const size_t csz_M, const size_t csz_N, const size_t csz_K, \
+	const type ct_Alpha, const type* cp_A, const size_t csz_LdA, const type* cp_B, const size_t csz_LdB, \
+	const type ct_Beta, type* p_C, const size_t csz_LdC) { \
+	const size_t csz_ColumnWork = (csz_M * csz_K != 0) ? csz_M * csz_K : 1; \
+	\
+	/* Columns of C are independent, so they are split across threads with no synchronisation */ \
+	if (csz_N > 1 && csz_N * csz_ColumnWork >= 2 * GEMM_PARALLEL_GRAIN) { \
+		gemmargs##abbr##_t s_Args = { cs32_TransA, cs32_TransB, csz_M, csz_K, ct_Alpha, cp_A, csz_LdA, cp_B, csz_LdB, ct_Beta, p_C, csz_LdC }; \
+		parfor(csz_N, (GEMM_PARALLEL_GRAIN + csz_ColumnWork - 1) / csz_ColumnWork, gemmchunk##abbr, &s_Args); \
+		return; \
+	} \
+	\
+	gemmserial##abbr(cs32_TransA, cs32_TransB, csz_M, csz_N, csz_K, ct_Alpha, cp_A, csz_LdA, cp_B, csz_LdB, ct_Beta, p_C, csz_LdC); \
+}
+
+GEMM_KERNEL_DEF(float, FP32)
+GEMM_KERNEL_DEF(double, FP64)
+
+/**
+ * TRANSPOSE_KERNEL_DEF - Generates a tiled strided transpose for one element width.
+ *
+ * Strides are in elements: (i, j) of the source lives at i * csz_RowStrideS + j * csz_ColStrideS and
+ * is copied to (j, i) of the result.
+ */
+#define TRANSPOSE_KERNEL_DEF(type, abbr) \
+static void transtile##abbr(void* p_R, const size_t csz_RowStrideR, const size_t csz_ColStrideR, \
+	const void* cp_S, const size_t csz_RowStrideS, const size_t csz_ColStrideS, const size_t csz_Rows, const size_t csz_Cols) { \
+	type* p_Result = (type*)p_R; \
+	const type* cp_Source = (const type*)cp_S; \
+	\
+	for (size_t sz_I0 = 0; sz_I0 < csz_Rows; sz_I0 += TRANSPOSE_TILE) { \
+		const size_t csz_IEnd = (csz_Rows - sz_I0 < TRANSPOSE_TILE) ? csz_Rows : sz_I0 + TRANSPOSE_TILE; \
+		for (size_t sz_J0 = 0; sz_J0 < csz_Cols; sz_J0 += TRANSPOSE_TILE) { \
+			const size_t csz_JEnd = (csz_Cols - sz_J0 < TRANSPOSE_TILE) ? csz_Cols : sz_J0 + TRANSPOSE_TILE; \
+			for (size_t sz_I = sz_I0; sz_I < csz_IEnd; ++sz_I) { \
+				for (size_t sz_J = sz_J0; sz_J < csz_JEnd; ++sz_J) { \
+					p_Result[sz_J * csz_RowStrideR + sz_I * csz_ColStrideR] = cp_Source[sz_I * csz_RowStrideS + sz_J * csz_ColStrideS]; \
+				} \
+			} \
+		} \
+	} \
+}
+
+TRANSPOSE_KERNEL_DEF(uint8_t, U8)
+TRANSPOSE_KERNEL_DEF(uint16_t, U16)
+TRANSPOSE_KERNEL_DEF(uint32_t, U32)
+TRANSPOSE_KERNEL_DEF(uint64_t, U64)
+
+// Storage ranges are compared as integers since the buffers may belong to unrelated allocations
+int mtxoverlap(const void* cp_A, const size_t csz_SizeA, const void* cp_B, const size_t csz_SizeB) {
+	const uintptr_t cu_A = (uintptr_t)cp_A;
+	const uintptr_t cu_B = (uintptr_t)cp_B;
+
+	return cu_A < cu_B + csz_SizeB && cu_B < cu_A + csz_SizeA;
+}
+
+void mtxcolumnview(matrix_t* pm_View, const vector_t* cpv_Vector) {
+	memset(pm_View, 0, sizeof(*pm_View));
+	pm_View->s32_Type            = cpv_Vector->s32_Type;
+	pm_View->p_StorageBuffer     = cpv_Vector->p_StorageBuffer;
+	pm_View->sz_BufferSize       = cpv_Vector->sz_BufferSize;
+	pm_View->sz_ElementSize      = cpv_Vector->sz_ElementSize;
+	pm_View->sz_Width            = 1;
+	pm_View->sz_Height           = cpv_Vector->sz_ElementCount;
+	pm_View->sz_ElementCount     = cpv_Vector->sz_ElementCount;
+	pm_View->pfn_ElementAdd      = cpv_Vector->pfn_ElementAdd;
+	pm_View->pfn_ElementSubtract = cpv_Vector->pfn_ElementSubtract;
+	pm_View->pfn_ElementMultiply = cpv_Vector->pfn_ElementMultiply;
+	pm_View->pfn_ElementDivide   = cpv_Vector->pfn_ElementDivide;
+	pm_View->pfn_Allocate        = cpv_Vector->pfn_Allocate;
+	pm_View->pfn_Free            = cpv_Vector->pfn_Free;
+	pm_View->s32_Borrowed        = 1;
+	return;
+}
+
+/**
+ * mtxproduct - C = A * B on already validated operands.
+ *
+ * A row-major matrix is exactly the column-major storage of its transpose, so the native kernels only
+ * ever need transpose flags: a column-major C is computed as op(A) op(B), a row-major C as C^T = op(B^T) op(A^T).
+ */
+static int mtxproduct(matrix_t* pm_C, const matrix_t* cpm_A, const matrix_t* cpm_B) {
+	const size_t csz_Depth = cpm_A->sz_Width;
+	const int cs32_NativeFP32 = cpm_A->s32_Type == TYPE_FP32 && cpm_A->sz_ElementSize == sizeof(float);
+	const int cs32_NativeFP64 = cpm_A->s32_Type == TYPE_FP64 && cpm_A->sz_ElementSize == sizeof(double);
+
+	if (cs32_NativeFP32 || cs32_NativeFP64) {
+		const size_t csz_LdA = MATRIX_LEADING_DIM(cpm_A);
+		const size_t csz_LdB = MATRIX_LEADING_DIM(cpm_B);
+		const size_t csz_LdC = MATRIX_LEADING_DIM(pm_C);
+
+		if (!MATRIX_IS_ROW_MAJOR(pm_C)) {
+			const int cs32_TransA = MATRIX_IS_ROW_MAJOR(cpm_A) ? GEMM_TRANSPOSE : GEMM_NORMAL;
+			const int cs32_TransB = MATRIX_IS_ROW_MAJOR(cpm_B) ? GEMM_TRANSPOSE : GEMM_NORMAL;
+
+			if (cs32_NativeFP32) {
+				gemmFP32(cs32_TransA, cs32_TransB, pm_C->sz_Height, pm_C->sz_Width, csz_Depth, 1.0f, (const float*)cpm_A->p_StorageBuffer, csz_LdA,
+					(const float*)cpm_B->p_StorageBuffer, csz_LdB, 0.0f, (float*)pm_C->p_StorageBuffer, csz_LdC);
+			} else {
+				gemmFP64(cs32_TransA, cs32_TransB, pm_C->sz_Height, pm_C->sz_Width, csz_Depth, 1.0, (const double*)cpm_A->p_StorageBuffer, csz_LdA,
+					(const double*)cpm_B->p_StorageBuffer, csz_LdB, 0.0, (double*)pm_C->p_StorageBuffer, csz_LdC);
+			}
+			return 0;
+		}
+
+		const int cs32_TransA = MATRIX_IS_ROW_MAJOR(cpm_A) ? GEMM_NORMAL : GEMM_TRANSPOSE;
+		const int cs32_TransB = MATRIX_IS_ROW_MAJOR(cpm_B) ? GEMM_NORMAL : GEMM_TRANSPOSE;
+
+		if (cs32_NativeFP32) {
+			gemmFP32(cs32_TransB, cs32_TransA, pm_C->sz_Width, pm_C->sz_Height, csz_Depth, 1.0f, (const float*)cpm_B->p_StorageBuffer, csz_LdB,
+				(const float*)cpm_A->p_StorageBuffer, csz_LdA, 0.0f, (float*)pm_C->p_StorageBuffer, csz_LdC);
+		} else {
+			gemmFP64(cs32_TransB, cs32_TransA, pm_C->sz_Width, pm_C->sz_Height, csz_Depth, 1.0, (const double*)cpm_B->p_StorageBuffer, csz_LdB,
+				(const double*)cpm_A->p_StorageBuffer, csz_LdA, 0.0, (double*)pm_C->p_StorageBuffer, csz_LdC);
+		}
+		return 0;
+	}
+
+	if (cpm_A->pfn_ElementAdd == NULL || cpm_A->pfn_ElementMultiply == NULL) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	uint8_t* pu8_Product = (uint8_t*)pm_C->pfn_Allocate(pm_C->sz_ElementSize);
+	if (!CHECK_ALLOCATION(pu8_Product)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+
+	const size_t csz_Size = pm_C->sz_ElementSize;
+	const uint8_t* cpu8_A = (const uint8_t*)cpm_A->p_StorageBuffer;
+	const uint8_t* cpu8_B = (const uint8_t*)cpm_B->p_StorageBuffer;
+	uint8_t* pu8_C = (uint8_t*)pm_C->p_StorageBuffer;
+	const size_t csz_RowA = MATRIX_ROW_STRIDE(cpm_A) * csz_Size, csz_ColA = MATRIX_COL_STRIDE(cpm_A) * csz_Size;
+	const size_t csz_RowB = MATRIX_ROW_STRIDE(cpm_B) * csz_Size, csz_ColB = MATRIX_COL_STRIDE(cpm_B) * csz_Size;
+	const size_t csz_RowC = MATRIX_ROW_STRIDE(pm_C) * csz_Size, csz_ColC = MATRIX_COL_STRIDE(pm_C) * csz_Size;
+
+	// The innermost loop runs along the contiguous dimension of C: rows of C (and B) or columns of C (and A)
+	if (MATRIX_IS_ROW_MAJOR(pm_C)) {
+		for (size_t sz_I = 0; sz_I < pm_C->sz_Height; ++sz_I) {
+			for (size_t sz_P = 0; sz_P < csz_Depth; ++sz_P) {
+				const uint8_t* cpu8_Left = cpu8_A + sz_I * csz_RowA + sz_P * csz_ColA;
+				for (size_t sz_J = 0; sz_J < pm_C->sz_Width; ++sz_J) {
+					uint8_t* pu8_Out = pu8_C + sz_I * csz_RowC + sz_J * csz_ColC;
+					cpm_A->pfn_ElementMultiply((sz_P == 0) ? pu8_Out : pu8_Product, cpu8_Left, cpu8_B + sz_P * csz_RowB + sz_J * csz_ColB);
+					if (sz_P != 0) {
+						cpm_A->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Product);
+					}
+				}
+			}
+		}
+	} else {
+		for (size_t sz_J = 0; sz_J < pm_C->sz_Width; ++sz_J) {
+			for (size_t sz_P = 0; sz_P < csz_Depth; ++sz_P) {
+				const uint8_t* cpu8_Right = cpu8_B + sz_P * csz_RowB + sz_J * csz_ColB;
+				for (size_t sz_I = 0; sz_I < pm_C->sz_Height; ++sz_I) {
+					uint8_t* pu8_Out = pu8_C + sz_I * csz_RowC + sz_J * csz_ColC;
+					cpm_A->pfn_ElementMultiply((sz_P == 0) ? pu8_Out : pu8_Product, cpu8_A + sz_I * csz_RowA + sz_P * csz_ColA, cpu8_Right);
+					if (sz_P != 0) {
+						cpm_A->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Product);
+					}
+				}
+			}
+		}
+	}
+
+	pm_C->pfn_Free(pu8_Product);
+	return 0;
+}
+
+int mtxmul(matrix_t* pm_Result, const matrix_t* cpm_A, const matrix_t* cpm_B) {
+	if (pm_Result == NULL || cpm_A == NULL || cpm_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	// A result cloned from an operand gets its own buffer first, so the two no longer count as overlapping
+	if (mtxunique(pm_Result) != 0) {
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Result) != 0                           ||
+	mtxmemchk(cpm_A) != 0                                   ||
+	mtxmemchk(cpm_B) != 0                                   ||
+	cpm_A->s32_Type != cpm_B->s32_Type                      ||
+	pm_Result->s32_Type != cpm_A->s32_Type                  ||
+	cpm_A->sz_ElementSize != cpm_B->sz_ElementSize          ||
+	pm_Result->sz_ElementSize != cpm_A->sz_ElementSize      ||
+	cpm_A->sz_Width != cpm_B->sz_Height                     ||
+	pm_Result->sz_Height != cpm_A->sz_Height                ||
+	pm_Result->sz_Width != cpm_B->sz_Width                  ||
+	mtxoverlap(pm_Result->p_StorageBuffer, pm_Result->sz_BufferSize, cpm_A->p_StorageBuffer, cpm_A->sz_BufferSize) ||
+	mtxoverlap(pm_Result->p_StorageBuffer, pm_Result->sz_BufferSize, cpm_B->p_StorageBuffer, cpm_B->sz_BufferSize)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	return mtxproduct(pm_Result, cpm_A, cpm_B);
+}
+
+int mtxmulvct(vector_t* pv_Result, const matrix_t* cpm_Matrix, const vector_t* cpv_Vector) {
+	if (pv_Result == NULL || cpm_Matrix == NULL || cpv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctunique(pv_Result) != 0) {
+		return -1;
+	}
+
+	if (vctmemchk(pv_Result) != 0                               ||
+	mtxmemchk(cpm_Matrix) != 0                                  ||
+	vctmemchk(cpv_Vector) != 0                                  ||
+	cpv_Vector->s32_Type != cpm_Matrix->s32_Type                ||
+	pv_Result->s32_Type != cpm_Matrix->s32_Type                 ||
+	cpv_Vector->sz_ElementSize != cpm_Matrix->sz_ElementSize    ||
+	pv_Result->sz_ElementSize != cpm_Matrix->sz_ElementSize     ||
+	cpv_Vector->sz_ElementCount != cpm_Matrix->sz_Width         ||
+	pv_Result->sz_ElementCount != cpm_Matrix->sz_Height         ||
+	mtxoverlap(pv_Result->p_StorageBuffer, pv_Result->sz_BufferSize, cpm_Matrix->p_StorageBuffer, cpm_Matrix->sz_BufferSize) ||
+	mtxoverlap(pv_Result->p_StorageBuffer, pv_Result->sz_BufferSize, cpv_Vector->p_StorageBuffer, cpv_Vector->sz_BufferSize)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	// As one-column matrices, a column-major A takes the axpy path of the kernels and a row-major A the dot product path
+	matrix_t m_Result, m_Vector;
+	mtxcolumnview(&m_Result, pv_Result);
+	mtxcolumnview(&m_Vector, cpv_Vector);
+
+	return mtxproduct(&m_Result, cpm_Matrix, &m_Vector);
+}
+
+int mtxtrans(matrix_t* pm_Result, const matrix_t* cpm_Source) {
+	if (pm_Result == NULL || cpm_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Result) != 0) {
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Result) != 0                               ||
+	mtxmemchk(cpm_Source) != 0                                  ||
+	pm_Result->s32_Type != cpm_Source->s32_Type                 ||
+	pm_Result->sz_ElementSize != cpm_Source->sz_ElementSize     ||
+	pm_Result->sz_Height != cpm_Source->sz_Width                ||
+	pm_Result->sz_Width != cpm_Source->sz_Height                ||
+	mtxoverlap(pm_Result->p_StorageBuffer, pm_Result->sz_BufferSize, cpm_Source->p_StorageBuffer, cpm_Source->sz_BufferSize)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_Size = cpm_Source->sz_ElementSize;
+	const size_t csz_RowStrideR = MATRIX_ROW_STRIDE(pm_Result), csz_ColStrideR = MATRIX_COL_STRIDE(pm_Result);
+	const size_t csz_RowStrideS = MATRIX_ROW_STRIDE(cpm_Source), csz_ColStrideS = MATRIX_COL_STRIDE(cpm_Source);
+	uint8_t* pu8_Result = (uint8_t*)pm_Result->p_StorageBuffer;
+	const uint8_t* cpu8_Source = (const uint8_t*)cpm_Source->p_StorageBuffer;
+
+	// Opposite layouts store the transpose in the same order, so each contiguous run is copied as is
+	if (MATRIX_IS_ROW_MAJOR(pm_Result) != MATRIX_IS_ROW_MAJOR(cpm_Source)) {
+		const size_t csz_Inner = MATRIX_INNER_DIM(cpm_Source);
+		for (size_t sz_Outer = 0; sz_Outer < MATRIX_OUTER_DIM(cpm_Source); ++sz_Outer) {
+			memcpy(pu8_Result + sz_Outer * MATRIX_LEADING_DIM(pm_Result) * csz_Size,
+				cpu8_Source + sz_Outer * MATRIX_LEADING_DIM(cpm_Source) * csz_Size, csz_Inner * csz_Size);
+		}
+		return 0;
+	}
+
+	switch (csz_Size) {
+		case sizeof(uint8_t):
+			transtileU8(pu8_Result, csz_RowStrideR, csz_ColStrideR, cpu8_Source, csz_RowStrideS, csz_ColStrideS, cpm_Source->sz_Height, cpm_Source->sz_Width);
+			return 0;
+		case sizeof(uint16_t):
+			transtileU16(pu8_Result, csz_RowStrideR, csz_ColStrideR, cpu8_Source, csz_RowStrideS, csz_ColStrideS, cpm_Source->sz_Height, cpm_Source->sz_Width);
+			return 0;
+		case sizeof(uint32_t):
+			transtileU32(pu8_Result, csz_RowStrideR, csz_ColStrideR, cpu8_Source, csz_RowStrideS, csz_ColStrideS, cpm_Source->sz_Height, cpm_Source->sz_Width);
+			return 0;
+		case sizeof(uint64_t):
+			transtileU64(pu8_Result, csz_RowStrideR, csz_ColStrideR, cpu8_Source, csz_RowStrideS, csz_ColStrideS, cpm_Source->sz_Height, cpm_Source->sz_Width);
+			return 0;
+		default:
+			break;
+	}
+
+	for (size_t sz_I0 = 0; sz_I0 < cpm_Source->sz_Height; sz_I0 += TRANSPOSE_TILE) {
+		const size_t csz_IEnd = (cpm_Source->sz_Height - sz_I0 < TRANSPOSE_TILE) ? cpm_Source->sz_Height : sz_I0 + TRANSPOSE_TILE;
+		for (size_t sz_J0 = 0; sz_J0 < cpm_Source->sz_Width; sz_J0 += TRANSPOSE_TILE) {
+			const size_t csz_JEnd = (cpm_Source->sz_Width - sz_J0 < TRANSPOSE_TILE) ? cpm_Source->sz_Width : sz_J0 + TRANSPOSE_TILE;
+			for (size_t sz_I = sz_I0; sz_I < csz_IEnd; ++sz_I) {
+				for (size_t sz_J = sz_J0; sz_J < csz_JEnd; ++sz_J) {
+					memcpy(pu8_Result + (sz_J * csz_RowStrideR + sz_I * csz_ColStrideR) * csz_Size,
+						cpu8_Source + (sz_I * csz_RowStrideS + sz_J * csz_ColStrideS) * csz_Size, csz_Size);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,714 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "lin99/fill.h"
+#include "internal.h"
+
+// Fewest elements worth handing to another thread; below this the wake-up costs more than the work
+#define FILL_PARALLEL_GRAIN 	65536
+// Random words generated per tile; a tile is converted while it is still in L1
+#define FILL_TILE_WORDS     	1024
+// Rows of a row-major matrix filled together, so their cache lines are completed column by column
+#define FILL_PANEL          	64
+
+// Philox4x32-10 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+#define PHILOX_M0       	0xD2511F53u
+#define PHILOX_M1       	0xCD9E8D57u
+#define PHILOX_W0       	0x9E3779B9u
+#define PHILOX_W1       	0xBB67AE85u
+#define PHILOX_ROUNDS   	10
+// Counters run side by side in fixed-length loops so the rounds compile to vector multiplies
+#define PHILOX_LANES    	8
+
+#define FILL_TWO_PI     	6.28318530717958647692
+
+// What a fill writes
+#define FILL_CONSTANT   	0
+#define FILL_UNIFORM    	1
+#define FILL_NORMAL     	2
+#define FILL_RANDOM     	3
+
+/**
+ * philoxblocks - Run Philox4x32-10 on csz_Count (at most PHILOX_LANES) consecutive counters.
+ *
+ * Block b of the stream keyed by cu64_Seed holds words 4b to 4b + 3; blocks cu64_Block onwards are
+ * written to pu32_Out in stream order.
+ */
+static void philoxblocks(uint32_t* pu32_Out, const uint64_t cu64_Seed, const uint64_t cu64_Block, const size_t csz_Count) {
+	uint32_t a_C0[PHILOX_LANES], a_C1[PHILOX_LANES], a_C2[PHILOX_LANES], a_C3[PHILOX_LANES];
+	uint32_t u32_K0 = (uint32_t)cu64_Seed;
+	uint32_t u32_K1 = (uint32_t)(cu64_Seed >> 32);
+
+	for (size_t sz_Lane = 0; sz_Lane < PHILOX_LANES; ++sz_Lane) {
+		a_C0[sz_Lane] = (uint32_t)(cu64_Block + sz_Lane);
+		a_C1[sz_Lane] = (uint32_t)((cu64_Block + sz_Lane) >> 32);
+		a_C2[sz_Lane] = 0;
+		a_C3[sz_Lane] = 0;
+	}
+
+	for (int s32_Round = 0; s32_Round < PHILOX_ROUNDS; ++s32_Round) {
+		for (size_t sz_Lane = 0; sz_Lane < PHILOX_LANES; ++sz_Lane) {
+			const uint64_t cu64_P0 = (uint64_t)PHILOX_M0 * a_C0[sz_Lane];
+			const uint64_t cu64_P1 = (uint64_t)PHILOX_M1 * a_C2[sz_Lane];
+
+			a_C0[sz_Lane] = (uint32_t)(cu64_P1 >> 32) ^ a_C1[sz_Lane] ^ u32_K0;
+			a_C2[sz_Lane] = (uint32_t)(cu64_P0 >> 32) ^ a_C3[sz_Lane] ^ u32_K1;
+			a_C1[sz_Lane] = (uint32_t)cu64_P1;
+			a_C3[sz_Lane] = (uint32_t)cu64_P0;
+		}
+		u32_K0 += PHILOX_W0;
+		u32_K1 += PHILOX_W1;
+	}
+
+	for (size_t sz_Lane = 0; sz_Lane < csz_Count; ++sz_Lane) {
+		pu32_Out[4 * sz_Lane + 0] = a_C0[sz_Lane];
+		pu32_Out[4 * sz_Lane + 1] = a_C1[sz_Lane];
+		pu32_Out[4 * sz_Lane + 2] = a_C2[sz_Lane];
+		pu32_Out[4 * sz_Lane + 3] = a_C3[sz_Lane];
+	}
+	return;
+}
+
+// Words [cu64_First, cu64_First + csz_Count) of the stream keyed by cu64_Seed
+static void philoxwords(uint32_t* pu32_Out, const uint64_t cu64_Seed, const uint64_t cu64_First, const size_t csz_Count) {
+	uint32_t a_Blocks[4 * PHILOX_LANES];
+	uint64_t u64_Word = cu64_First;
+	size_t sz_Done = 0;
+
+	while (sz_Done < csz_Count) {
+		const size_t csz_Skip = (size_t)(u64_Word % 4);
+		size_t sz_Blocks = (csz_Skip + (csz_Count - sz_Done) + 3) / 4;
+		sz_Blocks = (sz_Blocks < PHILOX_LANES) ? sz_Blocks : PHILOX_LANES;
+
+		philoxblocks(a_Blocks, cu64_Seed, u64_Word / 4, sz_Blocks);
+
+		size_t sz_Take = 4 * sz_Blocks - csz_Skip;
+		sz_Take = (sz_Take < csz_Count - sz_Done) ? sz_Take : csz_Count - sz_Done;
+		memcpy(pu32_Out + sz_Done, a_Blocks + csz_Skip, sizeof(uint32_t) * sz_Take);
+
+		sz_Done += sz_Take;
+		u64_Word += sz_Take;
+	}
+	return;
+}
+
+// Bytes [cu64_Offset, cu64_Offset + csz_Count) of the stream keyed by cu64_Seed, words in host byte order
+static void philoxbytes(uint8_t* pu8_Out, const uint64_t cu64_Seed, const uint64_t cu64_Offset, const size_t csz_Count) {
+	uint32_t a_Words[FILL_TILE_WORDS];
+	uint64_t u64_Offset = cu64_Offset;
+	size_t sz_Done = 0;
+
+	while (sz_Done < csz_Count) {
+		const size_t csz_Skip = (size_t)(u64_Offset % 4);
+		size_t sz_Words = (csz_Skip + (csz_Count - sz_Done) + 3) / 4;
+		sz_Words = (sz_Words < FILL_TILE_WORDS) ? sz_Words : FILL_TILE_WORDS;
+
+		philoxwords(a_Words, cu64_Seed, u64_Offset / 4, sz_Words);
+
+		size_t sz_Take = 4 * sz_Words - csz_Skip;
+		sz_Take = (sz_Take < csz_Count - sz_Done) ? sz_Take : csz_Count - sz_Done;
+		memcpy(pu8_Out + sz_Done, (const uint8_t*)a_Words + csz_Skip, sz_Take);
+
+		sz_Done += sz_Take;
+		u64_Offset += sz_Take;
+	}
+	return;
+}
+
+// Uniform value in [0, 1) from the words of one element
+static double unitFP32(const uint32_t* cpu32_Words) {
+	return (double)(cpu32_Words[0] >> 8) * 0x1p-24;
+}
+
+static double unitFP64(const uint32_t* cpu32_Words) {
+	return (double)((((uint64_t)cpu32_Words[0] << 32) | cpu32_Words[1]) >> 11) * 0x1p-53;
+}
+
+/**
+ * fillargs_t - One fill operation and the storage it writes, shared by every chunk.
+ *
+ * Members:
+ * - s32_Kind: FILL_CONSTANT, FILL_UNIFORM, FILL_NORMAL or FILL_RANDOM.
+ * - cp_Value: Element copied by FILL_CONSTANT.
+ * - u64_Seed: Generator key of the random kinds.
+ * - f64_Offset/f64_Scale: Affine map applied to uniform [0, 1) or standard normal draws.
+ * - pu8_Buffer: Storage buffer of the vector or matrix.
+ * - sz_Rows/sz_Cols/sz_Ld: Logical matrix geometry and leading dimension (a vector is a single column).
+ */
+typedef struct __fillargs_t {
+	int s32_Kind;
+	TYPE s32_Type;
+	size_t sz_ElementSize;
+	const void* cp_Value;
+	uint64_t u64_Seed;
+	double f64_Offset;
+	double f64_Scale;
+	uint8_t* pu8_Buffer;
+	size_t sz_Rows;
+	size_t sz_Cols;
+	size_t sz_Ld;
+} fillargs_t;
+
+/**
+ * FILL_RANDOM_KERNEL_DEF - Generates the uniform and normal converters for one floating point type.
+ *
+ * Element e of a uniform fill consumes stream words [e * words, (e + 1) * words).  Normal fills draw in pairs:
+ * elements 2p and 2p + 1 are the cosine and sine halves of the Box-Muller transform of the two uniforms of
+ * pair p, so a run starting or ending mid-pair regenerates the pair and keeps only its own half.
+ */
+#define FILL_RANDOM_KERNEL_DEF(type, words, abbr) \
+static void filluniform##abbr(const fillargs_t* cp_Args, const uint64_t cu64_First, const size_t csz_Count, uint8_t* pu8_Dst, const size_t csz_Stride) { \
+	uint32_t a_Words[FILL_TILE_WORDS]; \
+	const size_t csz_Tile = FILL_TILE_WORDS / (words); \
+	\
+	for (size_t sz_Base = 0; sz_Base < csz_Count; sz_Base += csz_Tile) { \
+		const size_t csz_Length = (csz_Count - sz_Base < csz_Tile) ? csz_Count - sz_Base : csz_Tile; \
+		philoxwords(a_Words, cp_Args->u64_Seed, (cu64_First + sz_Base) * (words), csz_Length * (words)); \
+		\
+		for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) { \
+			*(type*)(pu8_Dst + (sz_Base + sz_Idx) * csz_Stride) = (type)(cp_Args->f64_Offset + cp_Args->f64_Scale * unit##abbr(a_Words + sz_Idx * (words))); \
+		} \
+	} \
+	return; \
+} \
+\
+static void fillnormal##abbr(const fillargs_t* cp_Args, const uint64_t cu64_First, const size_t csz_Count, uint8_t* pu8_Dst, const size_t csz_Stride) { \
+	uint32_t a_Words[FILL_TILE_WORDS]; \
+	const size_t csz_Tile = FILL_TILE_WORDS / (2 * (words)); \
+	const uint64_t cu64_End = cu64_First + csz_Count; \
+	const uint64_t cu64_LastPair = (cu64_End + 1) / 2; \
+	\
+	for (uint64_t u64_Pair = cu64_First / 2; u64_Pair < cu64_LastPair; u64_Pair += csz_Tile) { \
+		const size_t csz_Pairs = (cu64_LastPair - u64_Pair < csz_Tile) ? (size_t)(cu64_LastPair - u64_Pair) : csz_Tile; \
+		philoxwords(a_Words, cp_Args->u64_Seed, u64_Pair * 2 * (words), csz_Pairs * 2 * (words)); \
+		\
+		for (size_t sz_Idx = 0; sz_Idx < csz_Pairs; ++sz_Idx) { \
+			/* 1 - u lies in (0, 1], keeping the logarithm finite */ \
+			const double cf64_Radius = cp_Args->f64_Scale * sqrt(-2.0 * log(1.0 - unit##abbr(a_Words + 2 * sz_Idx * (words)))); \
+			const double cf64_Angle = FILL_TWO_PI * unit##abbr(a_Words + (2 * sz_Idx + 1) * (words)); \
+			const uint64_t cu64_Even = 2 * (u64_Pair + sz_Idx); \
+			\
+			if (cu64_Even >= cu64_First) { \
+				*(type*)(pu8_Dst + (size_t)(cu64_Even - cu64_First) * csz_Stride) = (type)(cp_Args->f64_Offset + cf64_Radius * cos(cf64_Angle)); \
+			} \
+			if (cu64_Even + 1 < cu64_End) { \
+				*(type*)(pu8_Dst + (size_t)(cu64_Even + 1 - cu64_First) * csz_Stride) = (type)(cp_Args->f64_Offset + cf64_Radius * sin(cf64_Angle)); \
+			} \
+		} \
+	} \
+	return; \
+}
+
+FILL_RANDOM_KERNEL_DEF(float, 1, FP32)
+FILL_RANDOM_KERNEL_DEF(double, 2, FP64)
+
+#define FILL_CONSTANT_CASE(bytes, type) \
+	case bytes: { \
+		type Value; \
+		memcpy(&Value, cp_Value, sizeof(type)); \
+		for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) { \
+			*(type*)(pu8_Dst + sz_Idx * csz_Stride) = Value; \
+		} \
+		return; \
+	}
+
+static void fillconstant(uint8_t* pu8_Dst, const size_t csz_Stride, const size_t csz_Count, const void* cp_Value, const size_t csz_Size) {
+	if (csz_Size == 1 && csz_Stride == 1) {
+		memset(pu8_Dst, *(const uint8_t*)cp_Value, csz_Count);
+		return;
+	}
+
+	// Element buffers are aligned for their type, so the common widths are stored as one integer each
+	switch (csz_Size) {
+		FILL_CONSTANT_CASE(1, uint8_t)
+		FILL_CONSTANT_CASE(2, uint16_t)
+		FILL_CONSTANT_CASE(4, uint32_t)
+		FILL_CONSTANT_CASE(8, uint64_t)
+		default:
+			for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+				memcpy(pu8_Dst + sz_Idx * csz_Stride, cp_Value, csz_Size);
+			}
+			return;
+	}
+}
+
+static void fillrandom(const fillargs_t* cp_Args, const uint64_t cu64_First, const size_t csz_Count, uint8_t* pu8_Dst, const size_t csz_Stride) {
+	const size_t csz_Size = cp_Args->sz_ElementSize;
+
+	if (csz_Stride == csz_Size) {
+		philoxbytes(pu8_Dst, cp_Args->u64_Seed, cu64_First * csz_Size, csz_Count * csz_Size);
+		return;
+	}
+
+	// Strided runs are generated contiguously into a tile and scattered, rather than one block per element
+	uint8_t a_Tile[4 * FILL_TILE_WORDS];
+	const size_t csz_Tile = sizeof(a_Tile) / csz_Size;
+
+	if (csz_Tile == 0) {
+		for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+			philoxbytes(pu8_Dst + sz_Idx * csz_Stride, cp_Args->u64_Seed, (cu64_First + sz_Idx) * csz_Size, csz_Size);
+		}
+		return;
+	}
+
+	for (size_t sz_Base = 0; sz_Base < csz_Count; sz_Base += csz_Tile) {
+		const size_t csz_Length = (csz_Count - sz_Base < csz_Tile) ? csz_Count - sz_Base : csz_Tile;
+		philoxbytes(a_Tile, cp_Args->u64_Seed, (cu64_First + sz_Base) * csz_Size, csz_Length * csz_Size);
+
+		for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) {
+			memcpy(pu8_Dst + (sz_Base + sz_Idx) * csz_Stride, a_Tile + sz_Idx * csz_Size, csz_Size);
+		}
+	}
+	return;
+}
+
+// Fill csz_Count elements numbered cu64_First onwards, stored csz_Stride bytes apart from pu8_Dst
+static void fillrun(const fillargs_t* cp_Args, const uint64_t cu64_First, const size_t csz_Count, uint8_t* pu8_Dst, const size_t csz_Stride) {
+	switch (cp_Args->s32_Kind) {
+		case FILL_CONSTANT:
+			fillconstant(pu8_Dst, csz_Stride, csz_Count, cp_Args->cp_Value, cp_Args->sz_ElementSize);
+			break;
+		case FILL_UNIFORM:
+			if (cp_Args->s32_Type == TYPE_FP32) {
+				filluniformFP32(cp_Args, cu64_First, csz_Count, pu8_Dst, csz_Stride);
+			} else {
+				filluniformFP64(cp_Args, cu64_First, csz_Count, pu8_Dst, csz_Stride);
+			}
+			break;
+		case FILL_NORMAL:
+			if (cp_Args->s32_Type == TYPE_FP32) {
+				fillnormalFP32(cp_Args, cu64_First, csz_Count, pu8_Dst, csz_Stride);
+			} else {
+				fillnormalFP64(cp_Args, cu64_First, csz_Count, pu8_Dst, csz_Stride);
+			}
+			break;
+		default:
+			fillrandom(cp_Args, cu64_First, csz_Count, pu8_Dst, csz_Stride);
+			break;
+	}
+	return;
+}
+
+// Chunk of a packed buffer: elements [sz_Begin, sz_End)
+static void fillpacked(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const fillargs_t* cp_Args = (const fillargs_t*)p_Context;
+	(void)sz_Chunk;
+
+	fillrun(cp_Args, sz_Begin, sz_End - sz_Begin, cp_Args->pu8_Buffer + sz_Begin * cp_Args->sz_ElementSize, cp_Args->sz_ElementSize);
+	return;
+}
+
+// Chunk of a padded column-major matrix: columns [sz_Begin, sz_End)
+static void fillcolumns(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const fillargs_t* cp_Args = (const fillargs_t*)p_Context;
+	(void)sz_Chunk;
+
+	for (size_t sz_Col = sz_Begin; sz_Col < sz_End; ++sz_Col) {
+		fillrun(cp_Args, (uint64_t)sz_Col * cp_Args->sz_Rows, cp_Args->sz_Rows,
+			cp_Args->pu8_Buffer + sz_Col * cp_Args->sz_Ld * cp_Args->sz_ElementSize, cp_Args->sz_ElementSize);
+	}
+	return;
+}
+
+// Chunk of a row-major matrix: panels of FILL_PANEL rows [sz_Begin, sz_End), each swept column by column
+static void fillpanels(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const fillargs_t* cp_Args = (const fillargs_t*)p_Context;
+	const size_t csz_Size = cp_Args->sz_ElementSize;
+	(void)sz_Chunk;
+
+	for (size_t sz_Panel = sz_Begin; sz_Panel < sz_End; ++sz_Panel) {
+		const size_t csz_Row = sz_Panel * FILL_PANEL;
+		const size_t csz_Rows = (cp_Args->sz_Rows - csz_Row < FILL_PANEL) ? cp_Args->sz_Rows - csz_Row : FILL_PANEL;
+
+		for (size_t sz_Col = 0; sz_Col < cp_Args->sz_Cols; ++sz_Col) {
+			fillrun(cp_Args, (uint64_t)sz_Col * cp_Args->sz_Rows + csz_Row, csz_Rows,
+				cp_Args->pu8_Buffer + (csz_Row * cp_Args->sz_Ld + sz_Col) * csz_Size, cp_Args->sz_Ld * csz_Size);
+		}
+	}
+	return;
+}
+
+// Every element is about to be overwritten, so a buffer shared with a clone is swapped for a fresh one, not copied
+static int fillunique(vector_t* pv_Vector) {
+	return bufunique(&pv_Vector->p_StorageBuffer, &pv_Vector->psz_References, pv_Vector->sz_BufferSize, 0, pv_Vector->pfn_Allocate, pv_Vector->pfn_Free);
+}
+
+static int fillvector(vector_t* pv_Vector, fillargs_t* p_Args) {
+	if (fillunique(pv_Vector) != 0) {
+		return -1;
+	}
+
+	p_Args->s32_Type = pv_Vector->s32_Type;
+	p_Args->sz_ElementSize = pv_Vector->sz_ElementSize;
+	p_Args->pu8_Buffer = (uint8_t*)pv_Vector->p_StorageBuffer;
+
+	return parfor(pv_Vector->sz_ElementCount, FILL_PARALLEL_GRAIN, fillpacked, p_Args);
+}
+
+static int fillmatrix(matrix_t* pm_Matrix, fillargs_t* p_Args) {
+	const size_t csz_Ld = MATRIX_LEADING_DIM(pm_Matrix);
+
+	// Padding between columns or rows is not filled, so only padded matrices keep the old contents
+	if (bufunique(&pm_Matrix->p_StorageBuffer, &pm_Matrix->psz_References, pm_Matrix->sz_BufferSize, csz_Ld != MATRIX_INNER_DIM(pm_Matrix),
+		pm_Matrix->pfn_Allocate, pm_Matrix->pfn_Free) != 0) {
+		return -1;
+	}
+
+	p_Args->s32_Type = pm_Matrix->s32_Type;
+	p_Args->sz_ElementSize = pm_Matrix->sz_ElementSize;
+	p_Args->pu8_Buffer = (uint8_t*)pm_Matrix->p_StorageBuffer;
+	p_Args->sz_Rows = pm_Matrix->sz_Height;
+	p_Args->sz_Cols = pm_Matrix->sz_Width;
+	p_Args->sz_Ld = csz_Ld;
+
+	if (MATRIX_IS_ROW_MAJOR(pm_Matrix)) {
+		const size_t csz_Panels = (pm_Matrix->sz_Height + FILL_PANEL - 1) / FILL_PANEL;
+		const size_t csz_PanelSize = FILL_PANEL * pm_Matrix->sz_Width;
+		return parfor(csz_Panels, (csz_PanelSize < FILL_PARALLEL_GRAIN) ? FILL_PARALLEL_GRAIN / csz_PanelSize : 1, fillpanels, p_Args);
+	}
+
+	// Packed column-major storage is numbered exactly like a vector
+	if (csz_Ld == pm_Matrix->sz_Height) {
+		return parfor(pm_Matrix->sz_Height * pm_Matrix->sz_Width, FILL_PARALLEL_GRAIN, fillpacked, p_Args);
+	}
+	return parfor(pm_Matrix->sz_Width, (pm_Matrix->sz_Height < FILL_PARALLEL_GRAIN) ? FILL_PARALLEL_GRAIN / pm_Matrix->sz_Height : 1, fillcolumns, p_Args);
+}
+
+static int fillisfloat(const TYPE cs32_Type, const size_t csz_Size) {
+	return (cs32_Type == TYPE_FP32 && csz_Size == sizeof(float)) || (cs32_Type == TYPE_FP64 && csz_Size == sizeof(double));
+}
+
+int vctfill(vector_t* pv_Vector, const void* cp_Value) {
+	if (pv_Vector == NULL || cp_Value == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_CONSTANT;
+	s_Args.cp_Value = cp_Value;
+	return fillvector(pv_Vector, &s_Args);
+}
+
+/**
+ * FILL_IOTA_KERNEL_DEF - Generates an arithmetic sequence kernel for one built-in type.
+ *
+ * Elements are computed as start + index * step in ctype, an unsigned type at least as wide as the element for
+ * integers (so the sequence wraps like the provided op sets) and double for floating point, which keeps chunks
+ * independent.  Types narrower than int use unsigned int, since uint8_t and uint16_t would promote to (signed) int.
+ */
+#define FILL_IOTA_KERNEL_DEF(type, ctype, abbr) \
+static void filliota##abbr(void* p_Buffer, const void* cp_Start, const void* cp_Step, const size_t csz_Begin, const size_t csz_End) { \
+	type* p_Out = (type*)p_Buffer; \
+	const ctype cStart = (ctype)*(const type*)cp_Start; \
+	const ctype cStep = (ctype)*(const type*)cp_Step; \
+	\
+	for (size_t sz_Idx = csz_Begin; sz_Idx < csz_End; ++sz_Idx) { \
+		p_Out[sz_Idx] = (type)(cStart + (ctype)sz_Idx * cStep); \
+	} \
+	return; \
+}
+
+FILL_IOTA_KERNEL_DEF(int8_t, unsigned int, S8)
+FILL_IOTA_KERNEL_DEF(uint8_t, unsigned int, U8)
+FILL_IOTA_KERNEL_DEF(int16_t, unsigned int, S16)
+FILL_IOTA_KERNEL_DEF(uint16_t, unsigned int, U16)
+FILL_IOTA_KERNEL_DEF(int32_t, uint32_t, S32)
+FILL_IOTA_KERNEL_DEF(uint32_t, uint32_t, U32)
+FILL_IOTA_KERNEL_DEF(int64_t, uint64_t, S64)
+FILL_IOTA_KERNEL_DEF(uint64_t, uint64_t, U64)
+FILL_IOTA_KERNEL_DEF(size_t, size_t, SZ)
+FILL_IOTA_KERNEL_DEF(float, double, FP32)
+FILL_IOTA_KERNEL_DEF(double, double, FP64)
+
+#define FILL_IOTA_CASE(type_enum, type, abbr) \
+	case type_enum: \
+		return (csz_Size == sizeof(type)) ? filliota##abbr : NULL;
+
+static void (*filliotanative(const TYPE cs32_Type, const size_t csz_Size))(void*, const void*, const void*, const size_t, const size_t) {
+	switch (cs32_Type) {
+		FILL_IOTA_CASE(TYPE_S8, int8_t, S8)
+		FILL_IOTA_CASE(TYPE_U8, uint8_t, U8)
+		FILL_IOTA_CASE(TYPE_S16, int16_t, S16)
+		FILL_IOTA_CASE(TYPE_U16, uint16_t, U16)
+		FILL_IOTA_CASE(TYPE_S32, int32_t, S32)
+		FILL_IOTA_CASE(TYPE_U32, uint32_t, U32)
+		FILL_IOTA_CASE(TYPE_S64, int64_t, S64)
+		FILL_IOTA_CASE(TYPE_U64, uint64_t, U64)
+		FILL_IOTA_CASE(TYPE_SZ, size_t, SZ)
+		FILL_IOTA_CASE(TYPE_FP32, float, FP32)
+		FILL_IOTA_CASE(TYPE_FP64, double, FP64)
+		default:
+			return NULL;
+	}
+}
+
+/**
+ * iotaargs_t - Operands of a sequence fill, shared by every chunk.
+ *
+ * Members:
+ * - pfn_Kernel: Native kernel, or NULL for linspace.
+ * - cp_Start/cp_Step: Sequence operands handed to pfn_Kernel.
+ * - f64_Start/f64_Step/f64_Stop: Linspace operands; the last element is written as f64_Stop.
+ */
+typedef struct __iotaargs_t {
+	void (*pfn_Kernel)(void*, const void*, const void*, const size_t, const size_t);
+	void* p_Buffer;
+	const void* cp_Start;
+	const void* cp_Step;
+	TYPE s32_Type;
+	size_t sz_Last;
+	double f64_Start;
+	double f64_Step;
+	double f64_Stop;
+} iotaargs_t;
+
+static void iotachunk(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const iotaargs_t* cp_Args = (const iotaargs_t*)p_Context;
+	(void)sz_Chunk;
+
+	if (cp_Args->pfn_Kernel != NULL) {
+		cp_Args->pfn_Kernel(cp_Args->p_Buffer, cp_Args->cp_Start, cp_Args->cp_Step, sz_Begin, sz_End);
+		return;
+	}
+
+	for (size_t sz_Idx = sz_Begin; sz_Idx < sz_End; ++sz_Idx) {
+		const double cf64_Value = (sz_Idx == cp_Args->sz_Last) ? cp_Args->f64_Stop : cp_Args->f64_Start + (double)sz_Idx * cp_Args->f64_Step;
+
+		if (cp_Args->s32_Type == TYPE_FP32) {
+			((float*)cp_Args->p_Buffer)[sz_Idx] = (float)cf64_Value;
+		} else {
+			((double*)cp_Args->p_Buffer)[sz_Idx] = cf64_Value;
+		}
+	}
+	return;
+}
+
+int vctiota(vector_t* pv_Vector, const void* cp_Start, const void* cp_Step) {
+	if (pv_Vector == NULL || cp_Start == NULL || cp_Step == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (fillunique(pv_Vector) != 0) {
+		return -1;
+	}
+
+	iotaargs_t s_Args = { 0 };
+	s_Args.pfn_Kernel = filliotanative(pv_Vector->s32_Type, pv_Vector->sz_ElementSize);
+	s_Args.p_Buffer = pv_Vector->p_StorageBuffer;
+	s_Args.cp_Start = cp_Start;
+	s_Args.cp_Step = cp_Step;
+
+	if (s_Args.pfn_Kernel != NULL) {
+		return parfor(pv_Vector->sz_ElementCount, FILL_PARALLEL_GRAIN, iotachunk, &s_Args);
+	}
+
+	if (pv_Vector->pfn_ElementAdd == NULL) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	// Without native arithmetic every element depends on the one before it
+	uint8_t* pu8_Element = (uint8_t*)pv_Vector->p_StorageBuffer;
+	memcpy(pu8_Element, cp_Start, pv_Vector->sz_ElementSize);
+	for (size_t sz_Idx = 1; sz_Idx < pv_Vector->sz_ElementCount; ++sz_Idx) {
+		pv_Vector->pfn_ElementAdd(pu8_Element + pv_Vector->sz_ElementSize, pu8_Element, cp_Step);
+		pu8_Element += pv_Vector->sz_ElementSize;
+	}
+	return 0;
+}
+
+int vctlinspace(vector_t* pv_Vector, const double cf64_Start, const double cf64_Stop) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!fillisfloat(pv_Vector->s32_Type, pv_Vector->sz_ElementSize)) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	if (fillunique(pv_Vector) != 0) {
+		return -1;
+	}
+
+	iotaargs_t s_Args = { 0 };
+	s_Args.p_Buffer = pv_Vector->p_StorageBuffer;
+	s_Args.s32_Type = pv_Vector->s32_Type;
+	s_Args.sz_Last = pv_Vector->sz_ElementCount - 1;
+	s_Args.f64_Start = cf64_Start;
+	s_Args.f64_Step = (s_Args.sz_Last != 0) ? (cf64_Stop - cf64_Start) / (double)s_Args.sz_Last : 0.0;
+	s_Args.f64_Stop = (s_Args.sz_Last != 0) ? cf64_Stop : cf64_Start;
+
+	return parfor(pv_Vector->sz_ElementCount, FILL_PARALLEL_GRAIN, iotachunk, &s_Args);
+}
+
+int vctuniform(vector_t* pv_Vector, const uint64_t cu64_Seed, const double cf64_Low, const double cf64_High) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!fillisfloat(pv_Vector->s32_Type, pv_Vector->sz_ElementSize)) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_UNIFORM;
+	s_Args.u64_Seed = cu64_Seed;
+	s_Args.f64_Offset = cf64_Low;
+	s_Args.f64_Scale = cf64_High - cf64_Low;
+	return fillvector(pv_Vector, &s_Args);
+}
+
+int vctnormal(vector_t* pv_Vector, const uint64_t cu64_Seed, const double cf64_Mean, const double cf64_Deviation) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!fillisfloat(pv_Vector->s32_Type, pv_Vector->sz_ElementSize)) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_NORMAL;
+	s_Args.u64_Seed = cu64_Seed;
+	s_Args.f64_Offset = cf64_Mean;
+	s_Args.f64_Scale = cf64_Deviation;
+	return fillvector(pv_Vector, &s_Args);
+}
+
+int vctrandom(vector_t* pv_Vector, const uint64_t cu64_Seed) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Vector) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_RANDOM;
+	s_Args.u64_Seed = cu64_Seed;
+	return fillvector(pv_Vector, &s_Args);
+}
+
+int mtxfill(matrix_t* pm_Matrix, const void* cp_Value) {
+	if (pm_Matrix == NULL || cp_Value == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_CONSTANT;
+	s_Args.cp_Value = cp_Value;
+	return fillmatrix(pm_Matrix, &s_Args);
+}
+
+int mtxuniform(matrix_t* pm_Matrix, const uint64_t cu64_Seed, const double cf64_Low, const double cf64_High) {
+	if (pm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!fillisfloat(pm_Matrix->s32_Type, pm_Matrix->sz_ElementSize)) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_UNIFORM;
+	s_Args.u64_Seed = cu64_Seed;
+	s_Args.f64_Offset = cf64_Low;
+	s_Args.f64_Scale = cf64_High - cf64_Low;
+	return fillmatrix(pm_Matrix, &s_Args);
+}
+
+int mtxnormal(matrix_t* pm_Matrix, const uint64_t cu64_Seed, const double cf64_Mean, const double cf64_Deviation) {
+	if (pm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (!fillisfloat(pm_Matrix->s32_Type, pm_Matrix->sz_ElementSize)) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_NORMAL;
+	s_Args.u64_Seed = cu64_Seed;
+	s_Args.f64_Offset = cf64_Mean;
+	s_Args.f64_Scale = cf64_Deviation;
+	return fillmatrix(pm_Matrix, &s_Args);
+}
+
+int mtxrandom(matrix_t* pm_Matrix, const uint64_t cu64_Seed) {
+	if (pm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	fillargs_t s_Args = { 0 };
+	s_Args.s32_Kind = FILL_RANDOM;
+	s_Args.u64_Seed = cu64_Seed;
+	return fillmatrix(pm_Matrix, &s_Args);
+}
@@ -0,0 +1,116 @@
+/*
+ * internal.h
+ *
+ * Routines shared between lin99 translation units that are not part of the public headers.
+ *
+ */
+
+
+#ifndef INTERNAL_H_
+#define INTERNAL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+
+/**
+ * MATRIX_* - Storage geometry of a matrix_t, valid for either layout.
+ *
+ * The inner dimension is the one stored contiguously (the height of a column-major matrix, the width of a
+ * row-major one).  MATRIX_ROW_STRIDE is the distance from (i, j) to (i + 1, j) and MATRIX_COL_STRIDE the
+ * distance from (i, j) to (i, j + 1), both in elements.  MATRIX_EXTENT is the number of elements spanned.
+ */
+#define MATRIX_IS_ROW_MAJOR(cpm)	((cpm)->s32_Layout == MATRIX_LAYOUT_ROW_MAJOR)
+#define MATRIX_INNER_DIM(cpm)   	(MATRIX_IS_ROW_MAJOR(cpm) ? (cpm)->sz_Width : (cpm)->sz_Height)
+#define MATRIX_OUTER_DIM(cpm)   	(MATRIX_IS_ROW_MAJOR(cpm) ? (cpm)->sz_Height : (cpm)->sz_Width)
+#define MATRIX_LEADING_DIM(cpm) 	(((cpm)->sz_LeadingDim != 0) ? (cpm)->sz_LeadingDim : MATRIX_INNER_DIM(cpm))
+#define MATRIX_ROW_STRIDE(cpm)  	(MATRIX_IS_ROW_MAJOR(cpm) ? MATRIX_LEADING_DIM(cpm) : 1)
+#define MATRIX_COL_STRIDE(cpm)  	(MATRIX_IS_ROW_MAJOR(cpm) ? 1 : MATRIX_LEADING_DIM(cpm))
+#define MATRIX_EXTENT(cpm)      	(MATRIX_LEADING_DIM(cpm) * (MATRIX_OUTER_DIM(cpm) - 1) + MATRIX_INNER_DIM(cpm))
+
+// Operation selectors for the built-in integer kernels
+#define INTEGER_OP_ADD	0
+#define INTEGER_OP_SUB	1
+#define INTEGER_OP_MUL	2
+#define INTEGER_OP_DIV	3
+
+/**
+ * intkernel - Run the built-in saturating/checked integer kernel for a vector type (see vector.c).
+ *
+ * Computes cp_A[i] (op) cp_B[i * csz_StrideB] into p_R[i] for csz_Count elements.
+ *
+ * Returns:
+ *  - Overflow occurred: 1
+ *  - No overflow: 0
+ *  - Type or mode not handled by the built-in kernels: -1
+ */
+int intkernel(void* p_R, const void* cp_A, const void* cp_B, const size_t csz_StrideB, const size_t csz_Count,
+	const TYPE cs32_Type, const int cs32_Op, const int cs32_Mode);
+
+// Operand forms accepted by the internal GEMM kernels
+#define GEMM_NORMAL   	0
+#define GEMM_TRANSPOSE	1
+
+/**
+ * gemmFP32/gemmFP64 - Column-major C = alpha * op(A) * op(B) + beta * C (see dense.c).
+ *
+ * Parameters:
+ *  - cs32_TransA/cs32_TransB: GEMM_NORMAL or GEMM_TRANSPOSE for each operand.
+ *  - csz_M/csz_N/csz_K: op(A) is csz_M x csz_K, op(B) is csz_K x csz_N and C is csz_M x csz_N.
+ *  - csz_LdA/csz_LdB/csz_LdC: Distance between consecutive columns of each operand, in elements.
+ *
+ * C must not overlap A or B.  When beta is 0, C is overwritten without being read.
+ */
+void gemmFP32(const int cs32_TransA, const int cs32_TransB, const size_t csz_M, const size_t csz_N, const size_t csz_K,
+	const float cf32_Alpha, const float* cp_A, const size_t csz_LdA, const float* cp_B, const size_t csz_LdB,
+	const float cf32_Beta, float* p_C, const size_t csz_LdC);
+void gemmFP64(const int cs32_TransA, const int cs32_TransB, const size_t csz_M, const size_t csz_N, const size_t csz_K,
+	const double cf64_Alpha, const double* cp_A, const size_t csz_LdA, const double* cp_B, const size_t csz_LdB,
+	const double cf64_Beta, double* p_C, const size_t csz_LdC);
+
+/**
+ * bufshare/bufrelease/bufunique - Reference counting of storage shared by vctclone and mtxclone (see vector.c).
+ *
+ * bufshare adds a holder to the count at *ppsz_References, creating it with pfn_Allocate and the caller as
+ * the first holder when there is none yet.  The count lives in the holders' own allocator family, so it is
+ * freed with the same pfn_Free as the buffer, and custom allocators see every allocation made for them.
+ * bufrelease drops the caller's hold and frees p_Buffer with pfn_Free when the caller was the last holder
+ * (or the buffer was never shared).  bufunique replaces a still-shared *pp_Buffer with a private buffer of
+ * csz_Size bytes, copying the contents only when cs32_Keep is set (writers about to overwrite every byte
+ * pass 0).  Both leave *ppsz_References NULL for the caller.
+ *
+ * bufshare and bufunique return 0, or -1 when memory runs out.
+ */
+int bufshare(size_t** ppsz_References, void* (*pfn_Allocate)(size_t));
+void bufrelease(void* p_Buffer, size_t** ppsz_References, void (*pfn_Free)(void*));
+int bufunique(void** pp_Buffer, size_t** ppsz_References, const size_t csz_Size, const int cs32_Keep,
+	void* (*pfn_Allocate)(size_t), void (*pfn_Free)(void*));
+
+/**
+ * mtxoverlap - Non-zero when the byte ranges [cp_A, cp_A + csz_SizeA) and [cp_B, cp_B + csz_SizeB) intersect
+ * (see dense.c).
+ */
+int mtxoverlap(const void* cp_A, const size_t csz_SizeA, const void* cp_B, const size_t csz_SizeB);
+
+/**
+ * mtxcolumnview - Describe a vector as a packed one-column matrix sharing its storage (see dense.c).
+ */
+void mtxcolumnview(matrix_t* pm_View, const vector_t* cpv_Vector);
+
+// Largest node and CPU ids the NUMA helpers track
+#define NUMA_MAX_NODES  	1024
+#define NUMA_MAX_CPUS   	1024
+
+/**
+ * numacpus - CPUs of the csz_Node-th online NUMA node, as listed by sysfs (see memory.c).
+ *
+ * Returns:
+ *  - Number of CPU ids stored in ps32_Cpus (at most csz_Max), 0 when the node or topology is unknown
+ */
+size_t numacpus(const size_t csz_Node, int* ps32_Cpus, const size_t csz_Max);
+
+#endif // INTERNAL_H_
@@ -5,6 +5,39 @@
 
 #include "lin99/vector.h"
 #include "lin99/matrix.h"
+#include "internal.h"
+
+// Validates the layout and leading dimension, filling in the packed value when none was given
+static int mtxgeometry(matrix_t* pm_Matrix) {
+	if (pm_Matrix->s32_Layout != MATRIX_LAYOUT_COLUMN_MAJOR && pm_Matrix->s32_Layout != MATRIX_LAYOUT_ROW_MAJOR) {
+		printf("UNKNOWN LAYOUT!\n");
+		return -1;
+	}
+
+	if (pm_Matrix->sz_LeadingDim == 0) {
+		pm_Matrix->sz_LeadingDim = MATRIX_INNER_DIM(pm_Matrix);
+	}
+
+	if (pm_Matrix->sz_LeadingDim < MATRIX_INNER_DIM(pm_Matrix)) {
+		printf("LEADING DIMENSION SMALLER THAN MATRIX!\n");
+		return -1;
+	}
+
+	pm_Matrix->sz_ElementCount = pm_Matrix->sz_Width * pm_Matrix->sz_Height;
+	if (pm_Matrix->sz_ElementCount / pm_Matrix->sz_Width != pm_Matrix->sz_Height ||
+	pm_Matrix->sz_LeadingDim > SIZE_MAX / MATRIX_OUTER_DIM(pm_Matrix)) {
+		printf("MULTIPLICATION OVERFLOW WHEN CALCULATING ELEMENT COUNT\n");
+		return -1;
+	}
+
+	if (MATRIX_EXTENT(pm_Matrix) > SIZE_MAX / pm_Matrix->sz_ElementSize) {
+		printf("MULTIPLICATION OVERFLOW WHEN CALCULATING BUFFER SIZE\n");
+		return -1;
+	}
+
+	pm_Matrix->sz_BufferSize = pm_Matrix->sz_ElementSize * MATRIX_EXTENT(pm_Matrix);
+	return 0;
+}
 
 int mtxcreate(matrix_t* pm_Matrix, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*)) {
 	if(pm_Matrix == NULL) {
@@ -19,16 +52,16 @@ int mtxcreate(matrix_t* pm_Matrix, void* (*pfn_AllocateMemory)(size_t), void (*p
 	}
 
 	// We can't use aligned_alloc here since this project is intended to be strictly C99, and aligned_alloc wasn't introduced until C11
-	pm_Matrix->pfn_Allocate = ((pfn_AllocateMemory != NULL) || (pm_Matrix->pfn_Allocate != NULL)) ? pfn_AllocateMemory : zalloc;
-	pm_Matrix->pfn_Free = ((pfn_FreeMemory != NULL) || (pm_Matrix->pfn_Free != NULL)) ? pfn_FreeMemory : free;
+	// Callbacks passed in win over callbacks already set on the struct, which win over calloc/free
+	pm_Matrix->pfn_Allocate = (pfn_AllocateMemory != NULL) ? pfn_AllocateMemory : ((pm_Matrix->pfn_Allocate != NULL) ? pm_Matrix->pfn_Allocate : zalloc);
+	pm_Matrix->pfn_Free = (pfn_FreeMemory != NULL) ? pfn_FreeMemory : ((pm_Matrix->pfn_Free != NULL) ? pm_Matrix->pfn_Free : free);
 
-	pm_Matrix->sz_ElementCount = pm_Matrix->sz_Width * pm_Matrix->sz_Height;
-	if (pm_Matrix->sz_ElementCount < pm_Matrix->sz_Width) {
-		printf("MULTIPLICATION OVERFLOW WHEN CALCULATING ELEMENT COUNT\n");
+	if (mtxgeometry(pm_Matrix) != 0) {
 		return -1;
 	}
 
-	pm_Matrix->sz_BufferSize = pm_Matrix->sz_ElementSize * pm_Matrix->sz_ElementCount;
+	pm_Matrix->s32_Borrowed = 0;
+	pm_Matrix->psz_References = NULL;
 	pm_Matrix->p_StorageBuffer = pm_Matrix->pfn_Allocate(pm_Matrix->sz_BufferSize);
 
 	if (!CHECK_ALLOCATION(pm_Matrix->p_StorageBuffer) || pm_Matrix->sz_BufferSize < pm_Matrix->sz_ElementCount) {
@@ -40,6 +73,79 @@ int mtxcreate(matrix_t* pm_Matrix, void* (*pfn_AllocateMemory)(size_t), void (*p
 	return 0;
 }
 
+int mtxwrap(matrix_t* pm_Matrix, void* p_Buffer, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*)) {
+	if (pm_Matrix == NULL || p_Buffer == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (pm_Matrix->sz_Width == 0 ||
+	pm_Matrix->sz_Height == 0 ||
+	pm_Matrix->sz_ElementSize == 0) {
+		return -1;
+	}
+
+	// Same precedence as mtxcreate: callbacks passed in, then callbacks already set on the struct, then calloc/free
+	pm_Matrix->pfn_Allocate = (pfn_AllocateMemory != NULL) ? pfn_AllocateMemory : ((pm_Matrix->pfn_Allocate != NULL) ? pm_Matrix->pfn_Allocate : zalloc);
+	pm_Matrix->pfn_Free = (pfn_FreeMemory != NULL) ? pfn_FreeMemory : ((pm_Matrix->pfn_Free != NULL) ? pm_Matrix->pfn_Free : free);
+
+	if (mtxgeometry(pm_Matrix) != 0) {
+		return -1;
+	}
+
+	pm_Matrix->p_StorageBuffer = p_Buffer;
+	pm_Matrix->s32_Borrowed = 1;
+	pm_Matrix->psz_References = NULL;
+	return 0;
+}
+
+int mtxclone(matrix_t* pm_Clone, matrix_t* pm_Source) {
+	if (pm_Clone == NULL || pm_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Source) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (pm_Clone == pm_Source) {
+		return 0;
+	}
+
+	if (pm_Source->s32_Borrowed) {
+		void* p_Copy = pm_Source->pfn_Allocate(pm_Source->sz_BufferSize);
+		if (!CHECK_ALLOCATION(p_Copy)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+		memcpy(p_Copy, pm_Source->p_StorageBuffer, pm_Source->sz_BufferSize);
+
+		*pm_Clone = *pm_Source;
+		pm_Clone->p_StorageBuffer = p_Copy;
+		pm_Clone->s32_Borrowed = 0;
+		pm_Clone->psz_References = NULL;
+		return 0;
+	}
+
+	if (bufshare(&pm_Source->psz_References, pm_Source->pfn_Allocate) != 0) {
+		return -1;
+	}
+
+	*pm_Clone = *pm_Source;
+	return 0;
+}
+
+int mtxunique(matrix_t* pm_Matrix) {
+	if (pm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	return bufunique(&pm_Matrix->p_StorageBuffer, &pm_Matrix->psz_References, pm_Matrix->sz_BufferSize, 1, pm_Matrix->pfn_Allocate, pm_Matrix->pfn_Free);
+}
+
 int mtxmemchk(const matrix_t* cpm_Matrix) {
   	if (cpm_Matrix->p_StorageBuffer != NULL         &&
   	cpm_Matrix->sz_ElementSize      != 0        	&&
@@ -49,7 +155,10 @@ int mtxmemchk(const matrix_t* cpm_Matrix) {
   	cpm_Matrix->sz_BufferSize   	!= 0         	&&
   	cpm_Matrix->s32_Type       	!= TYPE_NULL    &&
   	cpm_Matrix->pfn_Allocate   	!= NULL      	&&
-  	cpm_Matrix->pfn_Free       	!= NULL) {
+  	cpm_Matrix->pfn_Free       	!= NULL		&&
+	(cpm_Matrix->s32_Layout == MATRIX_LAYOUT_COLUMN_MAJOR || cpm_Matrix->s32_Layout == MATRIX_LAYOUT_ROW_MAJOR) &&
+	MATRIX_LEADING_DIM(cpm_Matrix) >= MATRIX_INNER_DIM(cpm_Matrix) &&
+	cpm_Matrix->sz_BufferSize / cpm_Matrix->sz_ElementSize >= MATRIX_EXTENT(cpm_Matrix)) {
     		return 0;
   	}
 
@@ -63,7 +172,7 @@ void mtxreadraw(void* p_Destination, const matrix_t* cpm_Matrix, const size_t cs
 		return;
 	}
 
-	if (csz_RawIdx < cpm_Matrix->sz_ElementCount) {
+	if (csz_RawIdx < MATRIX_EXTENT(cpm_Matrix)) {
 		memcpy(p_Destination, (uint8_t*)cpm_Matrix->p_StorageBuffer + csz_RawIdx * cpm_Matrix->sz_ElementSize, cpm_Matrix->sz_ElementSize);
 		return;
 	}
@@ -78,12 +187,48 @@ void mtxread(void* p_Destination, const matrix_t* cpm_Matrix, const size_t csz_R
 		return;
 	}
 
+	if (csz_RowIdx >= cpm_Matrix->sz_Height || csz_ColIdx >= cpm_Matrix->sz_Width) {
+		printf("INDEX EXCEEDED MATRIX DIMENSIONS!\n");
+		return;
+	}
+
 	// Use our mtxreadraw function so we don't have to maintain two functions that fulfill the same job.
-	mtxreadraw(p_Destination, cpm_Matrix, csz_RowIdx + cpm_Matrix->sz_Height * csz_ColIdx);
+	mtxreadraw(p_Destination, cpm_Matrix, csz_RowIdx * MATRIX_ROW_STRIDE(cpm_Matrix) + csz_ColIdx * MATRIX_COL_STRIDE(cpm_Matrix));
+	return;
+}
+
+void mtxwriteraw(matrix_t* pm_Matrix, const size_t csz_RawIdx, void* p_Data) {
+	if (pm_Matrix == NULL || p_Data == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return;
+	}
+
+	if (csz_RawIdx < MATRIX_EXTENT(pm_Matrix)) {
+		if (mtxunique(pm_Matrix) != 0) {
+			return;
+		}
+		memcpy((uint8_t*)pm_Matrix->p_StorageBuffer + csz_RawIdx * pm_Matrix->sz_ElementSize, p_Data, pm_Matrix->sz_ElementSize);
+		return;
+	}
+
+	printf("RAW INDEX EXCEEDED ELEMENT COUNT!\n");
 	return;
 }
 
-// Add write commands here.
+void mtxwrite(matrix_t* pm_Matrix, const size_t csz_RowIdx, const size_t csz_ColIdx, void* p_Data) {
+	if (pm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return;
+	}
+
+	if (csz_RowIdx >= pm_Matrix->sz_Height || csz_ColIdx >= pm_Matrix->sz_Width) {
+		printf("INDEX EXCEEDED MATRIX DIMENSIONS!\n");
+		return;
+	}
+
+	mtxwriteraw(pm_Matrix, csz_RowIdx * MATRIX_ROW_STRIDE(pm_Matrix) + csz_ColIdx * MATRIX_COL_STRIDE(pm_Matrix), p_Data);
+	return;
+}
 
 void mtxdstry(matrix_t* pm_Matrix) {
 	if (pm_Matrix == NULL) {
@@ -91,8 +236,8 @@ void mtxdstry(matrix_t* pm_Matrix) {
 		return;
 	}
 
-	if (pm_Matrix->p_StorageBuffer != NULL) {\
-		pm_Matrix->pfn_Free(pm_Matrix->p_StorageBuffer);
+	if (pm_Matrix->p_StorageBuffer != NULL && !pm_Matrix->s32_Borrowed) {\
+		bufrelease(pm_Matrix->p_StorageBuffer, &pm_Matrix->psz_References, pm_Matrix->pfn_Free);
 		pm_Matrix->sz_BufferSize = 0;
 	}
 	return;
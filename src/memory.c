@@ -0,0 +1,320 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/memory.h"
+#include "lin99/parallel.h"
+#include "internal.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MAP_REMAP_AVAILABLE
+#endif
+
+#if defined(MAP_REMAP_AVAILABLE) && defined(SYS_mbind) && defined(SYS_getcpu)
+#define NUMA_POLICY_AVAILABLE
+#endif
+
+// Memory policy modes of the mbind system call (linux/mempolicy.h)
+#define NUMA_MPOL_PREFERRED 	1
+#define NUMA_MPOL_INTERLEAVE	3
+
+#define NUMA_SYSFS_ONLINE   	"/sys/devices/system/node/online"
+#define NUMA_SYSFS_CPULIST  	"/sys/devices/system/node/node%d/cpulist"
+
+/**
+ * mapheader_t - Bookkeeping stored in front of every buffer handed out by mapalloc.
+ *
+ * Members:
+ * - sz_Size: Size the buffer was last requested with.
+ * - sz_Mapped: Length of the page mapping holding the header and buffer, or 0 for a heap block.
+ *
+ * The header is padded to 64 bytes so the buffer keeps the alignment of the underlying block.
+ */
+typedef union __mapheader_t {
+	struct {
+		size_t sz_Size;
+		size_t sz_Mapped;
+	} s_Info;
+	uint8_t a_Padding[64];
+} mapheader_t;
+
+#ifdef MAP_REMAP_AVAILABLE
+static void* mapcreate(const size_t csz_Length) {
+	void* p_Mapping = mmap(NULL, csz_Length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return (p_Mapping == MAP_FAILED) ? NULL : p_Mapping;
+}
+#endif
+
+void* mapalloc(const size_t csz_Size) {
+	if (csz_Size > SIZE_MAX - sizeof(mapheader_t)) {
+		return NULL;
+	}
+
+	const size_t csz_Total = csz_Size + sizeof(mapheader_t);
+	mapheader_t* p_Header = NULL;
+
+#ifdef MAP_REMAP_AVAILABLE
+	// Fresh anonymous pages are already zero, so large buffers skip the memset calloc would do
+	if (csz_Size >= MAP_THRESHOLD) {
+		p_Header = (mapheader_t*)mapcreate(csz_Total);
+		if (p_Header == NULL) {
+			return NULL;
+		}
+		p_Header->s_Info.sz_Size = csz_Size;
+		p_Header->s_Info.sz_Mapped = csz_Total;
+		return p_Header + 1;
+	}
+#endif
+
+	p_Header = (mapheader_t*)calloc(csz_Total, 1);
+	if (p_Header == NULL) {
+		return NULL;
+	}
+	p_Header->s_Info.sz_Size = csz_Size;
+	p_Header->s_Info.sz_Mapped = 0;
+	return p_Header + 1;
+}
+
+void* maprealloc(void* p_Buffer, const size_t csz_OldSize, const size_t csz_NewSize) {
+	(void)csz_OldSize;
+
+	if (p_Buffer == NULL) {
+		return mapalloc(csz_NewSize);
+	}
+	if (csz_NewSize > SIZE_MAX - sizeof(mapheader_t)) {
+		return NULL;
+	}
+
+	mapheader_t* p_Header = (mapheader_t*)p_Buffer - 1;
+	const size_t csz_Total = csz_NewSize + sizeof(mapheader_t);
+
+#ifdef MAP_REMAP_AVAILABLE
+	if (p_Header->s_Info.sz_Mapped != 0) {
+		// Pages are moved by the kernel; anything past the old length comes back zero-filled
+		mapheader_t* p_Moved = (mapheader_t*)mremap(p_Header, p_Header->s_Info.sz_Mapped, csz_Total, MREMAP_MAYMOVE);
+		if (p_Moved == (mapheader_t*)MAP_FAILED) {
+			return NULL;
+		}
+		p_Moved->s_Info.sz_Size = csz_NewSize;
+		p_Moved->s_Info.sz_Mapped = csz_Total;
+		return p_Moved + 1;
+	}
+
+	// A heap block crossing the threshold is copied into a mapping once; from then on it grows by remapping
+	if (csz_NewSize >= MAP_THRESHOLD) {
+		mapheader_t* p_Mapped = (mapheader_t*)mapcreate(csz_Total);
+		if (p_Mapped == NULL) {
+			return NULL;
+		}
+		memcpy(p_Mapped + 1, p_Buffer, p_Header->s_Info.sz_Size);
+		p_Mapped->s_Info.sz_Size = csz_NewSize;
+		p_Mapped->s_Info.sz_Mapped = csz_Total;
+		free(p_Header);
+		return p_Mapped + 1;
+	}
+#endif
+
+	// realloc does not zero what it adds, unlike the mapping paths
+	const size_t csz_Previous = p_Header->s_Info.sz_Size;
+	mapheader_t* p_Resized = (mapheader_t*)realloc(p_Header, csz_Total);
+	if (p_Resized == NULL) {
+		return NULL;
+	}
+	if (csz_NewSize > csz_Previous) {
+		memset((uint8_t*)(p_Resized + 1) + csz_Previous, 0, csz_NewSize - csz_Previous);
+	}
+	p_Resized->s_Info.sz_Size = csz_NewSize;
+	return p_Resized + 1;
+}
+
+void mapfree(void* p_Buffer) {
+	if (p_Buffer == NULL) {
+		return;
+	}
+
+	mapheader_t* p_Header = (mapheader_t*)p_Buffer - 1;
+
+#ifdef MAP_REMAP_AVAILABLE
+	if (p_Header->s_Info.sz_Mapped != 0) {
+		munmap(p_Header, p_Header->s_Info.sz_Mapped);
+		return;
+	}
+#endif
+
+	free(p_Header);
+	return;
+}
+
+// Parse a sysfs list such as "0-3,8,10-11" into ascending ids.  Returns how many were stored.
+static size_t numaparse(const char* cpc_Path, int* ps32_Ids, const size_t csz_Max) {
+	FILE* p_File = fopen(cpc_Path, "r");
+	size_t sz_Count = 0;
+	long l_First, l_Last;
+
+	if (p_File == NULL) {
+		return 0;
+	}
+
+	while (fscanf(p_File, "%ld", &l_First) == 1) {
+		int s32_Next = fgetc(p_File);
+
+		l_Last = l_First;
+		if (s32_Next == '-') {
+			if (fscanf(p_File, "%ld", &l_Last) != 1) {
+				break;
+			}
+			s32_Next = fgetc(p_File);
+		}
+		for (long l_Id = l_First; l_Id <= l_Last && sz_Count < csz_Max; ++l_Id) {
+			ps32_Ids[sz_Count++] = (int)l_Id;
+		}
+		if (s32_Next != ',') {
+			break;
+		}
+	}
+
+	fclose(p_File);
+	return sz_Count;
+}
+
+size_t numanodes(void) {
+	int a_Nodes[NUMA_MAX_NODES];
+	const size_t csz_Nodes = numaparse(NUMA_SYSFS_ONLINE, a_Nodes, NUMA_MAX_NODES);
+
+	return (csz_Nodes != 0) ? csz_Nodes : 1;
+}
+
+size_t numacpus(const size_t csz_Node, int* ps32_Cpus, const size_t csz_Max) {
+	int a_Nodes[NUMA_MAX_NODES];
+	char a_Path[sizeof(NUMA_SYSFS_CPULIST) + 16];
+	const size_t csz_Nodes = numaparse(NUMA_SYSFS_ONLINE, a_Nodes, NUMA_MAX_NODES);
+
+	if (csz_Node >= csz_Nodes) {
+		return 0;
+	}
+
+	snprintf(a_Path, sizeof(a_Path), NUMA_SYSFS_CPULIST, a_Nodes[csz_Node]);
+	return numaparse(a_Path, ps32_Cpus, csz_Max);
+}
+
+#ifdef NUMA_POLICY_AVAILABLE
+// Restrict a mapping to a set of nodes.  Failure is ignored: placement is a performance hint, never a requirement.
+static void numapolicy(void* p_Mapping, const size_t csz_Length, const int cs32_Mode, const int* cps32_Nodes, const size_t csz_Nodes) {
+	unsigned long a_Mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+	const size_t csz_Bits = 8 * sizeof(unsigned long);
+
+	memset(a_Mask, 0, sizeof(a_Mask));
+	for (size_t sz_Node = 0; sz_Node < csz_Nodes; ++sz_Node) {
+		if (cps32_Nodes[sz_Node] >= 0 && cps32_Nodes[sz_Node] < NUMA_MAX_NODES) {
+			a_Mask[(size_t)cps32_Nodes[sz_Node] / csz_Bits] |= 1UL << ((size_t)cps32_Nodes[sz_Node] % csz_Bits);
+		}
+	}
+
+	// The kernel reads one bit fewer than maxnode says
+	(void)syscall(SYS_mbind, p_Mapping, csz_Length, cs32_Mode, a_Mask, (unsigned long)NUMA_MAX_NODES + 1, 0UL);
+	return;
+}
+#endif
+
+/**
+ * numamap - Map a buffer for one of the NUMA allocators, applying a policy before any page is touched.
+ *
+ * cs32_Mode is NUMA_MPOL_INTERLEAVE, NUMA_MPOL_PREFERRED (for the calling thread's node) or 0 for none.
+ * Buffers below MAP_THRESHOLD, and systems without mappings, get an ordinary mapalloc buffer.
+ */
+static void* numamap(const size_t csz_Size, const int cs32_Mode) {
+#ifdef MAP_REMAP_AVAILABLE
+	if (csz_Size < MAP_THRESHOLD || csz_Size > SIZE_MAX - sizeof(mapheader_t)) {
+		return mapalloc(csz_Size);
+	}
+
+	const size_t csz_Total = csz_Size + sizeof(mapheader_t);
+	mapheader_t* p_Header = (mapheader_t*)mapcreate(csz_Total);
+	if (p_Header == NULL) {
+		return NULL;
+	}
+
+#ifdef NUMA_POLICY_AVAILABLE
+	int a_Nodes[NUMA_MAX_NODES];
+	const size_t csz_Nodes = numaparse(NUMA_SYSFS_ONLINE, a_Nodes, NUMA_MAX_NODES);
+
+	if (cs32_Mode == NUMA_MPOL_INTERLEAVE && csz_Nodes > 1) {
+		numapolicy(p_Header, csz_Total, NUMA_MPOL_INTERLEAVE, a_Nodes, csz_Nodes);
+	} else if (cs32_Mode == NUMA_MPOL_PREFERRED && csz_Nodes > 1) {
+		unsigned int u32_Cpu = 0, u32_Node = 0;
+		if (syscall(SYS_getcpu, &u32_Cpu, &u32_Node, NULL) == 0) {
+			const int cs32_Node = (int)u32_Node;
+			numapolicy(p_Header, csz_Total, NUMA_MPOL_PREFERRED, &cs32_Node, 1);
+		}
+	}
+#else
+	(void)cs32_Mode;
+#endif
+
+	// Writing the header faults in the first page, so it happens only after the policy is in place
+	p_Header->s_Info.sz_Size = csz_Size;
+	p_Header->s_Info.sz_Mapped = csz_Total;
+	return p_Header + 1;
+#else
+	(void)cs32_Mode;
+	return mapalloc(csz_Size);
+#endif
+}
+
+void* numainterleave(const size_t csz_Size) {
+	return numamap(csz_Size, NUMA_MPOL_INTERLEAVE);
+}
+
+void* numalocal(const size_t csz_Size) {
+	return numamap(csz_Size, NUMA_MPOL_PREFERRED);
+}
+
+/**
+ * numatouch_t - Buffer being faulted in by numatouch.
+ *
+ * Members:
+ * - pu8_Buffer: Start of the caller-visible buffer.
+ * - sz_Page: Page size; pages start where the offset plus the header size is a multiple of it.
+ */
+typedef struct __numatouch_t {
+	uint8_t* pu8_Buffer;
+	size_t sz_Page;
+} numatouch_t;
+
+// Each page is faulted in by the chunk holding its first byte; the header page was already touched by the caller
+static void numatouchchunk(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const numatouch_t* cp_Touch = (const numatouch_t*)p_Context;
+	const size_t csz_Page = cp_Touch->sz_Page;
+	(void)sz_Chunk;
+
+	for (size_t sz_Offset = (sz_Begin + sizeof(mapheader_t) + csz_Page - 1) / csz_Page * csz_Page - sizeof(mapheader_t); sz_Offset < sz_End; sz_Offset += csz_Page) {
+		cp_Touch->pu8_Buffer[sz_Offset] = 0;
+	}
+	return;
+}
+
+void* numatouch(const size_t csz_Size) {
+	void* p_Buffer = numamap(csz_Size, 0);
+
+#ifdef MAP_REMAP_AVAILABLE
+	if (p_Buffer != NULL && ((mapheader_t*)p_Buffer - 1)->s_Info.sz_Mapped != 0) {
+		const long cl_Page = sysconf(_SC_PAGESIZE);
+		numatouch_t s_Touch;
+
+		s_Touch.pu8_Buffer = (uint8_t*)p_Buffer;
+		s_Touch.sz_Page = (cl_Page > 0) ? (size_t)cl_Page : 4096;
+		// A grain of one page splits any mapped buffer into pargetthreads() chunks, like the kernels do
+		parfor(csz_Size, s_Touch.sz_Page, numatouchchunk, &s_Touch);
+	}
+#endif
+
+	return p_Buffer;
+}
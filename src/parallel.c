@@ -0,0 +1,260 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/parallel.h"
+#include "lin99/memory.h"
+#include "internal.h"
+
+#ifdef LIN99_THREADS
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#define PAR_AFFINITY_AVAILABLE
+#endif
+
+/**
+ * parpool_t - State shared between parfor and the worker threads.
+ *
+ * Members:
+ * - mtx_Call: Held by the thread running parfor (or reconfiguring the pool) for the whole call.
+ * - mtx_Job/cnd_Ready/cnd_Done: Protect and signal the fields describing the current job.
+ * - a_Workers/sz_Workers: Worker threads; worker w always runs chunk w + 1.
+ * - sz_Threads: Requested thread count, 0 for one per online processor.
+ * - s32_Bind: PAR_BIND_* placement applied to workers as they start.
+ * - ul_Generation: Bumped for every job so workers can tell a new job from a spurious wake-up.
+ * - sz_Pending: Worker chunks of the current job that have not finished yet.
+ * - s32_Shutdown: Tells the workers to exit.
+ */
+typedef struct __parpool_t {
+	pthread_mutex_t mtx_Call;
+	pthread_mutex_t mtx_Job;
+	pthread_cond_t cnd_Ready;
+	pthread_cond_t cnd_Done;
+
+	pthread_t a_Workers[PAR_MAX_THREADS];
+	size_t sz_Workers;
+	size_t sz_Threads;
+	int s32_Bind;
+
+	unsigned long ul_Generation;
+	void (*pfn_Body)(void*, size_t, size_t, size_t);
+	void* p_Context;
+	size_t sz_Count;
+	size_t sz_Chunks;
+	size_t sz_Pending;
+	int s32_Shutdown;
+} parpool_t;
+
+static parpool_t g_Pool = {
+	.mtx_Call = PTHREAD_MUTEX_INITIALIZER,
+	.mtx_Job = PTHREAD_MUTEX_INITIALIZER,
+	.cnd_Ready = PTHREAD_COND_INITIALIZER,
+	.cnd_Done = PTHREAD_COND_INITIALIZER
+};
+
+static void* parworker(void* p_Argument) {
+	const size_t csz_Chunk = (size_t)(uintptr_t)p_Argument + 1;
+	unsigned long ul_Seen = 0;
+
+	pthread_mutex_lock(&g_Pool.mtx_Job);
+	for (;;) {
+		while (g_Pool.ul_Generation == ul_Seen && !g_Pool.s32_Shutdown) {
+			pthread_cond_wait(&g_Pool.cnd_Ready, &g_Pool.mtx_Job);
+		}
+		if (g_Pool.s32_Shutdown) {
+			break;
+		}
+		ul_Seen = g_Pool.ul_Generation;
+
+		if (csz_Chunk >= g_Pool.sz_Chunks) {
+			continue;
+		}
+
+		void (*pfn_Body)(void*, size_t, size_t, size_t) = g_Pool.pfn_Body;
+		void* p_Context = g_Pool.p_Context;
+		size_t sz_Begin, sz_End;
+		parrange(&sz_Begin, &sz_End, g_Pool.sz_Count, g_Pool.sz_Chunks, csz_Chunk);
+
+		pthread_mutex_unlock(&g_Pool.mtx_Job);
+		pfn_Body(p_Context, csz_Chunk, sz_Begin, sz_End);
+		pthread_mutex_lock(&g_Pool.mtx_Job);
+
+		if (--g_Pool.sz_Pending == 0) {
+			pthread_cond_signal(&g_Pool.cnd_Done);
+		}
+	}
+	pthread_mutex_unlock(&g_Pool.mtx_Job);
+
+	return NULL;
+}
+
+// Caller must hold mtx_Call
+static void parstop(void) {
+	pthread_mutex_lock(&g_Pool.mtx_Job);
+	g_Pool.s32_Shutdown = 1;
+	pthread_cond_broadcast(&g_Pool.cnd_Ready);
+	pthread_mutex_unlock(&g_Pool.mtx_Job);
+
+	for (size_t sz_Worker = 0; sz_Worker < g_Pool.sz_Workers; ++sz_Worker) {
+		pthread_join(g_Pool.a_Workers[sz_Worker], NULL);
+	}
+
+	g_Pool.sz_Workers = 0;
+	g_Pool.s32_Shutdown = 0;
+	g_Pool.ul_Generation = 0;
+}
+
+// Restrict the worker running chunk csz_Chunk to its NUMA node.  A failed pin leaves the worker unbound.
+static void parpin(pthread_t th_Worker, const size_t csz_Chunk) {
+#ifdef PAR_AFFINITY_AVAILABLE
+	int a_Cpus[NUMA_MAX_CPUS];
+	const size_t csz_Node = csz_Chunk * numanodes() / pargetthreads();
+	const size_t csz_Cpus = numacpus(csz_Node, a_Cpus, NUMA_MAX_CPUS);
+	cpu_set_t s_Set;
+
+	if (csz_Cpus == 0) {
+		return;
+	}
+
+	CPU_ZERO(&s_Set);
+	for (size_t sz_Cpu = 0; sz_Cpu < csz_Cpus; ++sz_Cpu) {
+		if (a_Cpus[sz_Cpu] >= 0 && a_Cpus[sz_Cpu] < CPU_SETSIZE) {
+			CPU_SET(a_Cpus[sz_Cpu], &s_Set);
+		}
+	}
+	(void)pthread_setaffinity_np(th_Worker, sizeof(s_Set), &s_Set);
+#else
+	(void)th_Worker;
+	(void)csz_Chunk;
+#endif
+	return;
+}
+
+// Caller must hold mtx_Call.  Returns the number of usable workers, which may be fewer than requested.
+static size_t parstart(const size_t csz_Workers) {
+	while (g_Pool.sz_Workers < csz_Workers) {
+		if (pthread_create(&g_Pool.a_Workers[g_Pool.sz_Workers], NULL, parworker, (void*)(uintptr_t)g_Pool.sz_Workers) != 0) {
+			break;
+		}
+		if (g_Pool.s32_Bind == PAR_BIND_NODES) {
+			parpin(g_Pool.a_Workers[g_Pool.sz_Workers], g_Pool.sz_Workers + 1);
+		}
+		++g_Pool.sz_Workers;
+	}
+	return g_Pool.sz_Workers;
+}
+#endif // LIN99_THREADS
+
+void parthreads(const size_t csz_Threads) {
+#ifdef LIN99_THREADS
+	pthread_mutex_lock(&g_Pool.mtx_Call);
+	parstop();
+	g_Pool.sz_Threads = (csz_Threads > PAR_MAX_THREADS) ? PAR_MAX_THREADS : csz_Threads;
+	pthread_mutex_unlock(&g_Pool.mtx_Call);
+#else
+	(void)csz_Threads;
+#endif
+	return;
+}
+
+void parbind(const int cs32_Mode) {
+#ifdef LIN99_THREADS
+	pthread_mutex_lock(&g_Pool.mtx_Call);
+	parstop();
+	g_Pool.s32_Bind = cs32_Mode;
+	pthread_mutex_unlock(&g_Pool.mtx_Call);
+#else
+	(void)cs32_Mode;
+#endif
+	return;
+}
+
+size_t pargetthreads(void) {
+#ifdef LIN99_THREADS
+	size_t sz_Threads = g_Pool.sz_Threads;
+
+	if (sz_Threads == 0) {
+		long l_Online = sysconf(_SC_NPROCESSORS_ONLN);
+		sz_Threads = (l_Online > 0) ? (size_t)l_Online : 1;
+	}
+	return (sz_Threads > PAR_MAX_THREADS) ? PAR_MAX_THREADS : sz_Threads;
+#else
+	return 1;
+#endif
+}
+
+size_t parchunks(const size_t csz_Count, const size_t csz_Grain) {
+	const size_t csz_Grains = (csz_Count + ((csz_Grain != 0) ? csz_Grain : 1) - 1) / ((csz_Grain != 0) ? csz_Grain : 1);
+	const size_t csz_Threads = pargetthreads();
+
+	return (csz_Grains < csz_Threads) ? csz_Grains : csz_Threads;
+}
+
+void parrange(size_t* psz_Begin, size_t* psz_End, const size_t csz_Count, const size_t csz_Chunks, const size_t csz_Chunk) {
+	// The first (count % chunks) chunks take one extra index, which avoids overflowing count * chunk
+	const size_t csz_Base = csz_Count / csz_Chunks;
+	const size_t csz_Extra = csz_Count % csz_Chunks;
+
+	*psz_Begin = csz_Base * csz_Chunk + ((csz_Chunk < csz_Extra) ? csz_Chunk : csz_Extra);
+	*psz_End = *psz_Begin + csz_Base + ((csz_Chunk < csz_Extra) ? 1 : 0);
+	return;
+}
+
+int parfor(const size_t csz_Count, const size_t csz_Grain, void (*pfn_Body)(void*, size_t, size_t, size_t), void* p_Context) {
+	if (pfn_Body == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	const size_t csz_Chunks = parchunks(csz_Count, csz_Grain);
+	size_t sz_Begin, sz_End;
+
+	if (csz_Chunks == 0) {
+		return 0;
+	}
+
+#ifdef LIN99_THREADS
+	// A busy pool means a nested or concurrent call; it still gets the same partition, just run serially
+	if (csz_Chunks > 1 && pthread_mutex_trylock(&g_Pool.mtx_Call) == 0) {
+		if (parstart(csz_Chunks - 1) >= csz_Chunks - 1) {
+			pthread_mutex_lock(&g_Pool.mtx_Job);
+			g_Pool.pfn_Body = pfn_Body;
+			g_Pool.p_Context = p_Context;
+			g_Pool.sz_Count = csz_Count;
+			g_Pool.sz_Chunks = csz_Chunks;
+			g_Pool.sz_Pending = csz_Chunks - 1;
+			++g_Pool.ul_Generation;
+			pthread_cond_broadcast(&g_Pool.cnd_Ready);
+			pthread_mutex_unlock(&g_Pool.mtx_Job);
+
+			parrange(&sz_Begin, &sz_End, csz_Count, csz_Chunks, 0);
+			pfn_Body(p_Context, 0, sz_Begin, sz_End);
+
+			pthread_mutex_lock(&g_Pool.mtx_Job);
+			while (g_Pool.sz_Pending != 0) {
+				pthread_cond_wait(&g_Pool.cnd_Done, &g_Pool.mtx_Job);
+			}
+			pthread_mutex_unlock(&g_Pool.mtx_Job);
+
+			pthread_mutex_unlock(&g_Pool.mtx_Call);
+			return 0;
+		}
+		pthread_mutex_unlock(&g_Pool.mtx_Call);
+	}
+#endif
+
+	for (size_t sz_Chunk = 0; sz_Chunk < csz_Chunks; ++sz_Chunk) {
+		parrange(&sz_Begin, &sz_End, csz_Count, csz_Chunks, sz_Chunk);
+		pfn_Body(p_Context, sz_Chunk, sz_Begin, sz_End);
+	}
+
+	return 0;
+}
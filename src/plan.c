@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/vector.h"
+#include "lin99/parallel.h"
+#include "lin99/plan.h"
+#include "internal.h"
+
+// Fewest elements worth handing to another thread; below this the wake-up costs more than the work
+#define PLAN_PARALLEL_GRAIN 	65536
+
+/**
+ * PLAN_NATIVE_SET - Generates the four type-specialised element-wise loops for a built-in type.
+ *
+ * Addition, subtraction and multiplication go through utype, an unsigned type at least as wide as the
+ * element, so that wrapping matches the provided op sets without relying on signed overflow.  Types
+ * narrower than int use unsigned int, since uint8_t and uint16_t would promote to (signed) int first.
+ */
+#define PLAN_NATIVE_OP(name, type, utype, op) \
+static void name(void* p_R, const void* cp_A, const void* cp_B, size_t sz_Count) { \
+	type* p_Out = (type*)p_R; \
+	const type* cp_Left = (const type*)cp_A; \
+	const type* cp_Right = (const type*)cp_B; \
+	\
+	for (size_t sz_Idx = 0; sz_Idx < sz_Count; ++sz_Idx) { \
+		p_Out[sz_Idx] = (type)((utype)cp_Left[sz_Idx] op (utype)cp_Right[sz_Idx]); \
+	} \
+}
+
+#define PLAN_NATIVE_SET(type, utype, abbr) \
+PLAN_NATIVE_OP(planadd##abbr, type, utype, +) \
+PLAN_NATIVE_OP(plansub##abbr, type, utype, -) \
+PLAN_NATIVE_OP(planmul##abbr, type, utype, *) \
+PLAN_NATIVE_OP(plandiv##abbr, type, type, /)
+
+PLAN_NATIVE_SET(int8_t, unsigned int, S8)
+PLAN_NATIVE_SET(uint8_t, unsigned int, U8)
+PLAN_NATIVE_SET(int16_t, unsigned int, S16)
+PLAN_NATIVE_SET(uint16_t, unsigned int, U16)
+PLAN_NATIVE_SET(int32_t, uint32_t, S32)
+PLAN_NATIVE_SET(uint32_t, uint32_t, U32)
+PLAN_NATIVE_SET(int64_t, uint64_t, S64)
+PLAN_NATIVE_SET(uint64_t, uint64_t, U64)
+PLAN_NATIVE_SET(size_t, size_t, SZ)
+PLAN_NATIVE_SET(float, float, FP32)
+PLAN_NATIVE_SET(double, double, FP64)
+
+#define PLAN_NATIVE_CASE(type_enum, abbr) \
+	case type_enum: { \
+		static void (*const a_Kernels[4])(void*, const void*, const void*, size_t) = { \
+			planadd##abbr, plansub##abbr, planmul##abbr, plandiv##abbr \
+		}; \
+		return a_Kernels[cs32_Operation]; \
+	}
+
+static void (*plannative(const TYPE cs32_Type, const int cs32_Operation))(void*, const void*, const void*, size_t) {
+	switch (cs32_Type) {
+		PLAN_NATIVE_CASE(TYPE_S8, S8)
+		PLAN_NATIVE_CASE(TYPE_U8, U8)
+		PLAN_NATIVE_CASE(TYPE_S16, S16)
+		PLAN_NATIVE_CASE(TYPE_U16, U16)
+		PLAN_NATIVE_CASE(TYPE_S32, S32)
+		PLAN_NATIVE_CASE(TYPE_U32, U32)
+		PLAN_NATIVE_CASE(TYPE_S64, S64)
+		PLAN_NATIVE_CASE(TYPE_U64, U64)
+		PLAN_NATIVE_CASE(TYPE_SZ, SZ)
+		PLAN_NATIVE_CASE(TYPE_FP32, FP32)
+		PLAN_NATIVE_CASE(TYPE_FP64, FP64)
+		default:
+			return NULL;
+	}
+}
+
+// A vector that declares a built-in type with a different element size cannot use the native kernels
+static size_t plansizeof(const TYPE cs32_Type) {
+	switch (cs32_Type) {
+		case TYPE_S8:   return sizeof(int8_t);
+		case TYPE_U8:   return sizeof(uint8_t);
+		case TYPE_S16:  return sizeof(int16_t);
+		case TYPE_U16:  return sizeof(uint16_t);
+		case TYPE_S32:  return sizeof(int32_t);
+		case TYPE_U32:  return sizeof(uint32_t);
+		case TYPE_S64:  return sizeof(int64_t);
+		case TYPE_U64:  return sizeof(uint64_t);
+		case TYPE_SZ:   return sizeof(size_t);
+		case TYPE_FP32: return sizeof(float);
+		case TYPE_FP64: return sizeof(double);
+		default:        return 0;
+	}
+}
+
+static int planisinteger(const TYPE cs32_Type) {
+	return cs32_Type >= TYPE_S8 && cs32_Type <= TYPE_SZ;
+}
+
+int vctplancreate(vctplan_t* pvp_Plan, const int cs32_Operation, const vector_t* cpv_A, const vector_t* cpv_B, const vector_t* cpv_Result, const int cs32_Flags) {
+	if (pvp_Plan == NULL || cpv_A == NULL || cpv_B == NULL || cpv_Result == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (cs32_Operation < PLAN_OP_ADD || cs32_Operation > PLAN_OP_DIV) {
+		printf("UNKNOWN OPERATION!\n");
+		return -1;
+	}
+
+	void (*const a_Callbacks[4])(void*, const void*, const void*) = {
+		cpv_A->pfn_ElementAdd, cpv_A->pfn_ElementSubtract, cpv_A->pfn_ElementMultiply, cpv_A->pfn_ElementDivide
+	};
+
+	// Everything vctadd and friends check per call is checked here once
+	if (vctcmp(cpv_A, cpv_B) != 0                               ||
+	a_Callbacks[cs32_Operation] == NULL                         ||
+	vctmemchk(cpv_A) != 0                                       ||
+	vctmemchk(cpv_B) != 0                                       ||
+	vctmemchk(cpv_Result) != 0                                  ||
+	cpv_Result->s32_Type != cpv_A->s32_Type                     ||
+	cpv_Result->sz_ElementCount < cpv_A->sz_ElementCount        ||
+	cpv_Result->sz_ElementSize != cpv_A->sz_ElementSize) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	memset(pvp_Plan, 0, sizeof(*pvp_Plan));
+	pvp_Plan->s32_Operation = cs32_Operation;
+	pvp_Plan->s32_Type = cpv_A->s32_Type;
+	pvp_Plan->s32_IntegerMode = cpv_Result->s32_IntegerMode;
+	pvp_Plan->sz_ElementCount = cpv_A->sz_ElementCount;
+	pvp_Plan->sz_ElementSize = cpv_A->sz_ElementSize;
+	pvp_Plan->pfn_Element = a_Callbacks[cs32_Operation];
+	pvp_Plan->s32_Kernel = PLAN_KERNEL_CALLBACK;
+
+	if (planisinteger(cpv_A->s32_Type) &&
+	(cpv_Result->s32_IntegerMode == INTEGER_MODE_SATURATE || cpv_Result->s32_IntegerMode == INTEGER_MODE_CHECKED)) {
+		// Integer modes already bypass the callbacks in vctadd and friends, so the plan does the same regardless of flags
+		pvp_Plan->s32_Kernel = PLAN_KERNEL_INTEGER;
+	} else if (!(cs32_Flags & PLAN_FLAG_CALLBACK)) {
+		pvp_Plan->pfn_Native = plannative(cpv_A->s32_Type, cs32_Operation);
+		if (pvp_Plan->pfn_Native != NULL && pvp_Plan->sz_ElementSize == plansizeof(cpv_A->s32_Type)) {
+			pvp_Plan->s32_Kernel = PLAN_KERNEL_NATIVE;
+		}
+	}
+
+	pvp_Plan->sz_Chunks = (cs32_Flags & PLAN_FLAG_SERIAL) ? 1 : parchunks(pvp_Plan->sz_ElementCount, PLAN_PARALLEL_GRAIN);
+	return 0;
+}
+
+/**
+ * planargs_t - Operands of one plan execution, shared by every chunk.
+ *
+ * Members:
+ * - cpvp_Plan: Plan being executed.
+ * - p_R/cp_A/cp_B: Storage buffers of the result and operands.
+ * - a_Overflow: Overflow reported by each chunk, combined once all chunks finish.
+ */
+typedef struct __planargs_t {
+	const vctplan_t* cpvp_Plan;
+	void* p_R;
+	const void* cp_A;
+	const void* cp_B;
+	int a_Overflow[PAR_MAX_THREADS];
+} planargs_t;
+
+static void planchunk(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	planargs_t* p_Args = (planargs_t*)p_Context;
+	const vctplan_t* cpvp_Plan = p_Args->cpvp_Plan;
+	const size_t csz_Offset = sz_Begin * cpvp_Plan->sz_ElementSize;
+
+	uint8_t* pu8_R = (uint8_t*)p_Args->p_R + csz_Offset;
+	const uint8_t* cpu8_A = (const uint8_t*)p_Args->cp_A + csz_Offset;
+	const uint8_t* cpu8_B = (const uint8_t*)p_Args->cp_B + csz_Offset;
+
+	switch (cpvp_Plan->s32_Kernel) {
+		case PLAN_KERNEL_NATIVE:
+			cpvp_Plan->pfn_Native(pu8_R, cpu8_A, cpu8_B, sz_End - sz_Begin);
+			break;
+		case PLAN_KERNEL_INTEGER:
+			// PLAN_OP_* and INTEGER_OP_* share their values
+			p_Args->a_Overflow[sz_Chunk] = intkernel(pu8_R, cpu8_A, cpu8_B, 1, sz_End - sz_Begin, cpvp_Plan->s32_Type, cpvp_Plan->s32_Operation, cpvp_Plan->s32_IntegerMode);
+			break;
+		default:
+			// Callbacks read their operands before writing, so element-by-element in place is safe when aliased
+			for (size_t sz_Idx = sz_Begin; sz_Idx < sz_End; ++sz_Idx) {
+				cpvp_Plan->pfn_Element(pu8_R, cpu8_A, cpu8_B);
+				pu8_R += cpvp_Plan->sz_ElementSize;
+				cpu8_A += cpvp_Plan->sz_ElementSize;
+				cpu8_B += cpvp_Plan->sz_ElementSize;
+			}
+			break;
+	}
+	return;
+}
+
+void vctplanexec(const vctplan_t* cpvp_Plan, vector_t* pv_Result, const vector_t* cpv_A, const vector_t* cpv_B) {
+	if (vctunique(pv_Result) != 0) {
+		return;
+	}
+
+	planargs_t s_Args;
+	s_Args.cpvp_Plan = cpvp_Plan;
+	s_Args.p_R = pv_Result->p_StorageBuffer;
+	s_Args.cp_A = cpv_A->p_StorageBuffer;
+	s_Args.cp_B = cpv_B->p_StorageBuffer;
+
+	if (cpvp_Plan->sz_Chunks <= 1) {
+		s_Args.a_Overflow[0] = 0;
+		planchunk(&s_Args, 0, 0, cpvp_Plan->sz_ElementCount);
+		pv_Result->s32_OverflowFlag |= (s_Args.a_Overflow[0] > 0);
+		return;
+	}
+
+	memset(s_Args.a_Overflow, 0, sizeof(int) * cpvp_Plan->sz_Chunks);
+	// The grain is derived from the chunk count chosen at creation so every execution splits identically
+	parfor(cpvp_Plan->sz_ElementCount, (cpvp_Plan->sz_ElementCount + cpvp_Plan->sz_Chunks - 1) / cpvp_Plan->sz_Chunks, planchunk, &s_Args);
+
+	for (size_t sz_Chunk = 0; sz_Chunk < cpvp_Plan->sz_Chunks; ++sz_Chunk) {
+		pv_Result->s32_OverflowFlag |= (s_Args.a_Overflow[sz_Chunk] > 0);
+	}
+	return;
+}
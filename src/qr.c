@@ -0,0 +1,547 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "internal.h"
+
+// Reflectors accumulated into one compact WY block before the trailing columns are updated
+#define QR_BLOCK    	32
+// Rows of A stacked under the running R factor per TSQR step, and the fewest rows worth a thread
+#define QR_TSQR_ROWS	1024
+
+// Elements of scratch qrfactor needs: V, T and the two W blocks, all sized by the first (widest) trailing update
+static size_t qrscratch(const size_t csz_Rows, const size_t csz_Cols, const size_t csz_Steps) {
+	const size_t csz_FirstWidth = (csz_Steps < QR_BLOCK) ? csz_Steps : QR_BLOCK;
+
+	if (csz_Steps == 0 || csz_Cols == csz_FirstWidth) {
+		return 0;
+	}
+	return csz_Rows * QR_BLOCK + QR_BLOCK * QR_BLOCK + 2 * QR_BLOCK * (csz_Cols - csz_FirstWidth);
+}
+
+/**
+ * QR_KERNEL_DEF - Generates the Householder QR routines for one floating point type.
+ *
+ * The factorisation routines work on raw column-major storage with an explicit leading dimension; operands
+ * of either layout are copied into that form by qrload as they are stacked.  Reflector i is
+ * H_i = I - tau_i * v_i * v_i^T with v_i[i] = 1 implied, and the entries of v_i below the diagonal
+ * are stored in place of the eliminated entries of A, as in LAPACK's geqrf.
+ */
+#define QR_KERNEL_DEF(type, abbr, fn_Sqrt, fn_Fabs, ct_Epsilon) \
+/* Turns p_X into beta * e_1 by a reflector, storing beta in p_X[0] and v[1:] in p_X[1:] */ \
+static type qrhouse##abbr(type* p_X, const size_t csz_Length) { \
+	type t_Tail = 0; \
+	for (size_t sz_Idx = 1; sz_Idx < csz_Length; ++sz_Idx) { \
+		t_Tail += p_X[sz_Idx] * p_X[sz_Idx]; \
+	} \
+	if (t_Tail == 0) { \
+		return 0; \
+	} \
+	\
+	const type ct_Alpha = p_X[0]; \
+	const type ct_Norm = fn_Sqrt(ct_Alpha * ct_Alpha + t_Tail); \
+	const type ct_Beta = (ct_Alpha > 0) ? -ct_Norm : ct_Norm; \
+	const type ct_Inverse = 1 / (ct_Alpha - ct_Beta); \
+	\
+	for (size_t sz_Idx = 1; sz_Idx < csz_Length; ++sz_Idx) { \
+		p_X[sz_Idx] *= ct_Inverse; \
+	} \
+	p_X[0] = ct_Beta; \
+	return (ct_Beta - ct_Alpha) / ct_Beta; \
+} \
+\
+/* Unblocked factorisation of an csz_Rows x csz_Cols panel, reflectors applied only within the panel */ \
+static void qrpanel##abbr(type* p_A, const size_t csz_Rows, const size_t csz_Cols, const size_t csz_LdA, type* p_Tau) { \
+	const size_t csz_Steps = (csz_Rows < csz_Cols) ? csz_Rows : csz_Cols; \
+	\
+	for (size_t sz_J = 0; sz_J < csz_Steps; ++sz_J) { \
+		type* p_V = p_A + sz_J + sz_J * csz_LdA; \
+		const size_t csz_Length = csz_Rows - sz_J; \
+		const type ct_Tau = qrhouse##abbr(p_V, csz_Length); \
+		p_Tau[sz_J] = ct_Tau; \
+		if (ct_Tau == 0) { \
+			continue; \
+		} \
+		\
+		for (size_t sz_C = sz_J + 1; sz_C < csz_Cols; ++sz_C) { \
+			type* p_Column = p_A + sz_J + sz_C * csz_LdA; \
+			type t_Dot = p_Column[0]; \
+			for (size_t sz_R = 1; sz_R < csz_Length; ++sz_R) { \
+				t_Dot += p_V[sz_R] * p_Column[sz_R]; \
+			} \
+			t_Dot *= ct_Tau; \
+			p_Column[0] -= t_Dot; \
+			for (size_t sz_R = 1; sz_R < csz_Length; ++sz_R) { \
+				p_Column[sz_R] -= t_Dot * p_V[sz_R]; \
+			} \
+		} \
+	} \
+} \
+\
+/**
+ * qrfactor - Blocked Householder QR of the first csz_Steps columns of a csz_Rows x csz_Cols matrix.
+ *
+ * Every reflector is also applied to the remaining columns, so trailing right-hand sides come out as Q^T B.
+ * Each panel of QR_BLOCK reflectors is folded into the compact WY form I - V T V^T and applied to the
+ * trailing columns with three GEMMs.  p_Scratch holds at least qrscratch(csz_Rows, csz_Cols, csz_Steps) elements
+ * and is owned by the caller, so repeated factorisations (one per TSQR step) share a single allocation.
+ */ \
+static void qrfactor##abbr(type* p_A, const size_t csz_Rows, const size_t csz_Cols, const size_t csz_Steps, const size_t csz_LdA, type* p_Tau, \
+	type* p_Scratch) { \
+	const size_t csz_FirstWidth = (csz_Steps < QR_BLOCK) ? csz_Steps : QR_BLOCK; \
+	const size_t csz_Trailing = csz_Cols - csz_FirstWidth; \
+	\
+	for (size_t sz_K = 0; sz_K < csz_Steps; sz_K += QR_BLOCK) { \
+		const size_t csz_Width = (csz_Steps - sz_K < QR_BLOCK) ? csz_Steps - sz_K : QR_BLOCK; \
+		const size_t csz_PanelRows = csz_Rows - sz_K; \
+		const size_t csz_Remaining = csz_Cols - sz_K - csz_Width; \
+		type* p_Panel = p_A + sz_K + sz_K * csz_LdA; \
+		\
+		qrpanel##abbr(p_Panel, csz_PanelRows, csz_Width, csz_LdA, p_Tau + sz_K); \
+		if (csz_Remaining == 0) { \
+			continue; \
+		} \
+		\
+		/* The first panel has the widest trailing update, so its layout of the scratch serves every later panel */ \
+		type* p_V = p_Scratch; \
+		type* p_T = p_V + csz_Rows * QR_BLOCK; \
+		type* p_W = p_T + QR_BLOCK * QR_BLOCK; \
+		type* p_WT = p_W + QR_BLOCK * csz_Trailing; \
+		\
+		/* Unpack V with its implicit unit diagonal and zero upper triangle so plain GEMMs can use it */ \
+		for (size_t sz_I = 0; sz_I < csz_Width; ++sz_I) { \
+			type* p_Column = p_V + sz_I * csz_PanelRows; \
+			for (size_t sz_R = 0; sz_R < csz_PanelRows; ++sz_R) { \
+				p_Column[sz_R] = (sz_R < sz_I) ? 0 : ((sz_R == sz_I) ? 1 : p_Panel[sz_R + sz_I * csz_LdA]); \
+			} \
+		} \
+		\
+		/* T[0:i, i] = -tau_i * T[0:i, 0:i] * V[:, 0:i]^T v_i, with T[i, i] = tau_i */ \
+		memset(p_T, 0, sizeof(type) * csz_Width * csz_Width); \
+		for (size_t sz_I = 0; sz_I < csz_Width; ++sz_I) { \
+			const type ct_Tau = p_Tau[sz_K + sz_I]; \
+			const type* cp_Vi = p_V + sz_I * csz_PanelRows; \
+			type a_Dots[QR_BLOCK]; \
+			\
+			for (size_t sz_Q = 0; sz_Q < sz_I; ++sz_Q) { \
+				const type* cp_Vq = p_V + sz_Q * csz_PanelRows; \
+				type t_Dot = 0; \
+				for (size_t sz_R = sz_I; sz_R < csz_PanelRows; ++sz_R) { \
+					t_Dot += cp_Vq[sz_R] * cp_Vi[sz_R]; \
+				} \
+				a_Dots[sz_Q] = -ct_Tau * t_Dot; \
+			} \
+			for (size_t sz_Q = 0; sz_Q < sz_I; ++sz_Q) { \
+				type t_Sum = 0; \
+				for (size_t sz_P = sz_Q; sz_P < sz_I; ++sz_P) { \
+					t_Sum += p_T[sz_Q + sz_P * csz_Width] * a_Dots[sz_P]; \
+				} \
+				p_T[sz_Q + sz_I * csz_Width] = t_Sum; \
+			} \
+			p_T[sz_I + sz_I * csz_Width] = ct_Tau; \
+		} \
+		\
+		/* C = (I - V T^T V^T) C, evaluated as W = V^T C, W = T^T W, C -= V W */ \
+		type* p_C = p_A + sz_K + (sz_K + csz_Width) * csz_LdA; \
+		gemm##abbr(GEMM_TRANSPOSE, GEMM_NORMAL, csz_Width, csz_Remaining, csz_PanelRows, 1, p_V, csz_PanelRows, p_C, csz_LdA, 0, p_W, csz_Width); \
+		gemm##abbr(GEMM_TRANSPOSE, GEMM_NORMAL, csz_Width, csz_Remaining, csz_Width, 1, p_T, csz_Width, p_W, csz_Width, 0, p_WT, csz_Width); \
+		gemm##abbr(GEMM_NORMAL, GEMM_NORMAL, csz_PanelRows, csz_Remaining, csz_Width, -1, p_V, csz_PanelRows, p_WT, csz_Width, 1, p_C, csz_LdA); \
+	} \
+} \
+\
+/* Copy csz_Count x csz_Cols strided entries into a column-major block, reading along contiguous memory in either layout */ \
+static void qrload##abbr(type* p_Block, const size_t csz_LdBlock, const type* cp_Source, const size_t csz_RowStride, const size_t csz_ColStride, \
+	const size_t csz_Count, const size_t csz_Cols) { \
+	if (csz_RowStride == 1) { \
+		for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+			memcpy(p_Block + sz_C * csz_LdBlock, cp_Source + sz_C * csz_ColStride, sizeof(type) * csz_Count); \
+		} \
+		return; \
+	} \
+	for (size_t sz_R = 0; sz_R < csz_Count; ++sz_R) { \
+		for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+			p_Block[sz_R + sz_C * csz_LdBlock] = cp_Source[sz_R * csz_RowStride + sz_C * csz_ColStride]; \
+		} \
+	} \
+} \
+\
+/* Copy a column-major csz_Rows x csz_Cols block into a matrix_t of either layout */ \
+static void qrstore##abbr(matrix_t* pm_Matrix, const type* cp_Block, const size_t csz_LdBlock, const size_t csz_Rows, const size_t csz_Cols) { \
+	type* p_Data = (type*)pm_Matrix->p_StorageBuffer; \
+	const size_t csz_RowStride = MATRIX_ROW_STRIDE(pm_Matrix); \
+	const size_t csz_ColStride = MATRIX_COL_STRIDE(pm_Matrix); \
+	\
+	for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+		for (size_t sz_R = 0; sz_R < csz_Rows; ++sz_R) { \
+			p_Data[sz_R * csz_RowStride + sz_C * csz_ColStride] = cp_Block[sz_R + sz_C * csz_LdBlock]; \
+		} \
+	} \
+} \
+\
+/**
+ * qrstack - Fold csz_Count rows of [A | B] into a running n x (n + nrhs) accumulator [R | Q^T B].
+ *
+ * The accumulator is stacked on top of the new rows and the stack is refactored, which is one step of
+ * a sequential TSQR.  p_Stack must hold (n + QR_TSQR_ROWS) x (n + nrhs) elements, p_Tau n elements
+ * and p_Scratch qrscratch(n + QR_TSQR_ROWS, n + nrhs, n) elements.
+ */ \
+static void qrstack##abbr(type* p_Accumulator, type* p_Stack, type* p_Tau, const size_t csz_N, const size_t csz_Rhs, \
+	const type* cp_A, const size_t csz_RowStrideA, const size_t csz_ColStrideA, \
+	const type* cp_B, const size_t csz_RowStrideB, const size_t csz_ColStrideB, const size_t csz_Count, type* p_Scratch) { \
+	const size_t csz_Rows = csz_N + csz_Count; \
+	const size_t csz_Cols = csz_N + csz_Rhs; \
+	\
+	for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+		memcpy(p_Stack + sz_C * csz_Rows, p_Accumulator + sz_C * csz_N, sizeof(type) * csz_N); \
+	} \
+	qrload##abbr(p_Stack + csz_N, csz_Rows, cp_A, csz_RowStrideA, csz_ColStrideA, csz_Count, csz_N); \
+	qrload##abbr(p_Stack + csz_N + csz_N * csz_Rows, csz_Rows, cp_B, csz_RowStrideB, csz_ColStrideB, csz_Count, csz_Rhs); \
+	\
+	qrfactor##abbr(p_Stack, csz_Rows, csz_Cols, csz_N, csz_Rows, p_Tau, p_Scratch); \
+	\
+	/* Keep only R (dropping the reflectors stored below its diagonal) and the top of Q^T B */ \
+	for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+		for (size_t sz_R = 0; sz_R < csz_N; ++sz_R) { \
+			p_Accumulator[sz_R + sz_C * csz_N] = (sz_C < csz_N && sz_R > sz_C) ? 0 : p_Stack[sz_R + sz_C * csz_Rows]; \
+		} \
+	} \
+} \
+\
+typedef struct __qrargs##abbr##_t { \
+	size_t sz_N; \
+	size_t sz_Rhs; \
+	const type* cp_A; \
+	size_t sz_RowStrideA; \
+	size_t sz_ColStrideA; \
+	const type* cp_B; \
+	size_t sz_RowStrideB; \
+	size_t sz_ColStrideB; \
+	type* p_Accumulators; \
+	int a_Status[PAR_MAX_THREADS]; \
+	void* (*pfn_Allocate)(size_t); \
+	void (*pfn_Free)(void*); \
+} qrargs##abbr##_t; \
+\
+/* Sequential TSQR over one row range, leaving that range's [R | Q^T B] in its own accumulator */ \
+static void qrchunk##abbr(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) { \
+	qrargs##abbr##_t* p_Args = (qrargs##abbr##_t*)p_Context; \
+	const size_t csz_N = p_Args->sz_N; \
+	const size_t csz_Cols = csz_N + p_Args->sz_Rhs; \
+	type* p_Accumulator = p_Args->p_Accumulators + sz_Chunk * csz_N * csz_Cols; \
+	\
+	/* Stack, reflector scales and WY scratch are sized for a full block once and reused by every block of the range */ \
+	const size_t csz_StackSize = (csz_N + QR_TSQR_ROWS) * csz_Cols; \
+	type* p_Stack = (type*)p_Args->pfn_Allocate(sizeof(type) * (csz_StackSize + csz_N + qrscratch(csz_N + QR_TSQR_ROWS, csz_Cols, csz_N))); \
+	if (!CHECK_ALLOCATION(p_Stack)) { \
+		p_Args->a_Status[sz_Chunk] = -1; \
+		return; \
+	} \
+	type* p_Tau = p_Stack + csz_StackSize; \
+	type* p_Scratch = p_Tau + csz_N; \
+	\
+	memset(p_Accumulator, 0, sizeof(type) * csz_N * csz_Cols); \
+	for (size_t sz_Row = sz_Begin; sz_Row < sz_End; sz_Row += QR_TSQR_ROWS) { \
+		const size_t csz_Count = (sz_End - sz_Row < QR_TSQR_ROWS) ? sz_End - sz_Row : QR_TSQR_ROWS; \
+		/* Without right-hand sides cp_B is NULL, and offsetting a null pointer is undefined */ \
+		const type* cp_RowsB = (p_Args->cp_B != NULL && p_Args->sz_Rhs != 0) ? p_Args->cp_B + sz_Row * p_Args->sz_RowStrideB : NULL; \
+		qrstack##abbr(p_Accumulator, p_Stack, p_Tau, csz_N, p_Args->sz_Rhs, \
+			p_Args->cp_A + sz_Row * p_Args->sz_RowStrideA, p_Args->sz_RowStrideA, p_Args->sz_ColStrideA, \
+			cp_RowsB, p_Args->sz_RowStrideB, p_Args->sz_ColStrideB, csz_Count, p_Scratch); \
+	} \
+	\
+	p_Args->pfn_Free(p_Stack); \
+} \
+\
+/**
+ * qrtsqr - Tall-skinny QR of [A | B], returning the n x (n + nrhs) block [R | Q^T B] in p_Result.
+ *
+ * Row ranges are reduced independently on the parallel backend, then their accumulators are stacked
+ * and factored once more, which is a two-level TSQR reduction tree.
+ */ \
+static int qrtsqr##abbr(type* p_Result, const size_t csz_N, const size_t csz_Rhs, const type* cp_A, const size_t csz_M, \
+	const size_t csz_RowStrideA, const size_t csz_ColStrideA, const type* cp_B, const size_t csz_RowStrideB, const size_t csz_ColStrideB, \
+	void* (*pfn_Allocate)(size_t), void (*pfn_Free)(void*)) { \
+	const size_t csz_Cols = csz_N + csz_Rhs; \
+	const size_t csz_Chunks = parchunks(csz_M, QR_TSQR_ROWS); \
+	\
+	qrargs##abbr##_t s_Args; \
+	memset(&s_Args, 0, sizeof(s_Args)); \
+	s_Args.sz_N = csz_N; \
+	s_Args.sz_Rhs = csz_Rhs; \
+	s_Args.cp_A = cp_A; \
+	s_Args.sz_RowStrideA = csz_RowStrideA; \
+	s_Args.sz_ColStrideA = csz_ColStrideA; \
+	s_Args.cp_B = cp_B; \
+	s_Args.sz_RowStrideB = csz_RowStrideB; \
+	s_Args.sz_ColStrideB = csz_ColStrideB; \
+	s_Args.pfn_Allocate = pfn_Allocate; \
+	s_Args.pfn_Free = pfn_Free; \
+	s_Args.p_Accumulators = (type*)pfn_Allocate(sizeof(type) * csz_Chunks * csz_N * csz_Cols); \
+	if (!CHECK_ALLOCATION(s_Args.p_Accumulators)) { \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	\
+	parfor(csz_M, QR_TSQR_ROWS, qrchunk##abbr, &s_Args); \
+	\
+	int s32_Status = 0; \
+	for (size_t sz_Chunk = 0; sz_Chunk < csz_Chunks; ++sz_Chunk) { \
+		s32_Status |= s_Args.a_Status[sz_Chunk]; \
+	} \
+	if (s32_Status != 0) { \
+		pfn_Free(s_Args.p_Accumulators); \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	\
+	if (csz_Chunks == 1) { \
+		memcpy(p_Result, s_Args.p_Accumulators, sizeof(type) * csz_N * csz_Cols); \
+		pfn_Free(s_Args.p_Accumulators); \
+		return 0; \
+	} \
+	\
+	/* Second level of the tree: stack the per-range R factors (and Q^T B blocks) and factor them together */ \
+	const size_t csz_Rows = csz_Chunks * csz_N; \
+	type* p_Stack = (type*)pfn_Allocate(sizeof(type) * (csz_Rows * csz_Cols + csz_N + qrscratch(csz_Rows, csz_Cols, csz_N))); \
+	if (!CHECK_ALLOCATION(p_Stack)) { \
+		pfn_Free(s_Args.p_Accumulators); \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	type* p_Tau = p_Stack + csz_Rows * csz_Cols; \
+	\
+	for (size_t sz_Chunk = 0; sz_Chunk < csz_Chunks; ++sz_Chunk) { \
+		for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+			memcpy(p_Stack + sz_C * csz_Rows + sz_Chunk * csz_N, s_Args.p_Accumulators + (sz_Chunk * csz_Cols + sz_C) * csz_N, sizeof(type) * csz_N); \
+		} \
+	} \
+	pfn_Free(s_Args.p_Accumulators); \
+	\
+	qrfactor##abbr(p_Stack, csz_Rows, csz_Cols, csz_N, csz_Rows, p_Tau, p_Tau + csz_N); \
+	\
+	for (size_t sz_C = 0; sz_C < csz_Cols; ++sz_C) { \
+		for (size_t sz_R = 0; sz_R < csz_N; ++sz_R) { \
+			p_Result[sz_R + sz_C * csz_N] = (sz_C < csz_N && sz_R > sz_C) ? 0 : p_Stack[sz_R + sz_C * csz_Rows]; \
+		} \
+	} \
+	\
+	pfn_Free(p_Stack); \
+	return 0; \
+} \
+\
+/**
+ * qrsolve - Solve R X = Y in place of Y by back substitution, refusing numerically singular R.
+ *
+ * A diagonal entry counts as zero below max(m, n) * eps * max|R_jj|, the usual rank tolerance for a
+ * Householder QR of an m x n matrix; scaling by n alone lets a duplicated column of a tall matrix through.
+ */ \
+static int qrsolve##abbr(type* p_Block, const size_t csz_M, const size_t csz_N, const size_t csz_Rhs) { \
+	const type ct_Dimension = (type)((csz_M > csz_N) ? csz_M : csz_N); \
+	type t_Largest = 0; \
+	for (size_t sz_I = 0; sz_I < csz_N; ++sz_I) { \
+		type t_Diagonal = fn_Fabs(p_Block[sz_I + sz_I * csz_N]); \
+		t_Largest = (t_Diagonal > t_Largest) ? t_Diagonal : t_Largest; \
+	} \
+	for (size_t sz_I = 0; sz_I < csz_N; ++sz_I) { \
+		if (!(fn_Fabs(p_Block[sz_I + sz_I * csz_N]) > t_Largest * ct_Dimension * ct_Epsilon)) { \
+			return -1; \
+		} \
+	} \
+	\
+	for (size_t sz_C = 0; sz_C < csz_Rhs; ++sz_C) { \
+		type* p_Y = p_Block + (csz_N + sz_C) * csz_N; \
+		for (size_t sz_I = csz_N; sz_I-- > 0;) { \
+			type t_Sum = p_Y[sz_I]; \
+			for (size_t sz_J = sz_I + 1; sz_J < csz_N; ++sz_J) { \
+				t_Sum -= p_Block[sz_I + sz_J * csz_N] * p_Y[sz_J]; \
+			} \
+			p_Y[sz_I] = t_Sum / p_Block[sz_I + sz_I * csz_N]; \
+		} \
+	} \
+	return 0; \
+}
+
+QR_KERNEL_DEF(float, FP32, sqrtf, fabsf, FLT_EPSILON)
+QR_KERNEL_DEF(double, FP64, sqrt, fabs, DBL_EPSILON)
+
+int mtxqr(matrix_t* pm_Matrix, void* p_Tau) {
+	if (pm_Matrix == NULL || p_Tau == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Matrix) != 0) {
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0) {
+		printf("MATRIX NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	// The packed reflectors only have a meaning in column-major storage
+	if (MATRIX_IS_ROW_MAJOR(pm_Matrix)) {
+		printf("LAYOUT NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	const size_t csz_Rows = pm_Matrix->sz_Height;
+	const size_t csz_Cols = pm_Matrix->sz_Width;
+	const size_t csz_Steps = (csz_Rows < csz_Cols) ? csz_Rows : csz_Cols;
+	const size_t csz_Ld = MATRIX_LEADING_DIM(pm_Matrix);
+	const size_t csz_Scratch = qrscratch(csz_Rows, csz_Cols, csz_Steps);
+
+	if (pm_Matrix->s32_Type != TYPE_FP32 && pm_Matrix->s32_Type != TYPE_FP64) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	void* p_Scratch = NULL;
+	if (csz_Scratch > 0) {
+		p_Scratch = pm_Matrix->pfn_Allocate(pm_Matrix->sz_ElementSize * csz_Scratch);
+		if (!CHECK_ALLOCATION(p_Scratch)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+	}
+
+	if (pm_Matrix->s32_Type == TYPE_FP32) {
+		qrfactorFP32((float*)pm_Matrix->p_StorageBuffer, csz_Rows, csz_Cols, csz_Steps, csz_Ld, (float*)p_Tau, (float*)p_Scratch);
+	} else {
+		qrfactorFP64((double*)pm_Matrix->p_StorageBuffer, csz_Rows, csz_Cols, csz_Steps, csz_Ld, (double*)p_Tau, (double*)p_Scratch);
+	}
+
+	if (p_Scratch != NULL) {
+		pm_Matrix->pfn_Free(p_Scratch);
+	}
+	return 0;
+}
+
+int mtxtsqr(matrix_t* pm_R, const matrix_t* cpm_A) {
+	if (pm_R == NULL || cpm_A == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_R) != 0) {
+		return -1;
+	}
+
+	if (mtxmemchk(pm_R) != 0                    ||
+	mtxmemchk(cpm_A) != 0                       ||
+	pm_R->s32_Type != cpm_A->s32_Type           ||
+	cpm_A->sz_Height < cpm_A->sz_Width          ||
+	pm_R->sz_Height != cpm_A->sz_Width          ||
+	pm_R->sz_Width != cpm_A->sz_Width) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (cpm_A->s32_Type != TYPE_FP32 && cpm_A->s32_Type != TYPE_FP64) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	const size_t csz_N = cpm_A->sz_Width;
+	const size_t csz_RowStrideA = MATRIX_ROW_STRIDE(cpm_A);
+	const size_t csz_ColStrideA = MATRIX_COL_STRIDE(cpm_A);
+	int s32_Status;
+
+	// R is produced packed and column-major, then stored in whatever layout pm_R uses
+	void* p_Block = cpm_A->pfn_Allocate(cpm_A->sz_ElementSize * csz_N * csz_N);
+	if (!CHECK_ALLOCATION(p_Block)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+
+	if (cpm_A->s32_Type == TYPE_FP32) {
+		s32_Status = qrtsqrFP32((float*)p_Block, csz_N, 0, (const float*)cpm_A->p_StorageBuffer, cpm_A->sz_Height, csz_RowStrideA, csz_ColStrideA,
+			NULL, 1, 0, cpm_A->pfn_Allocate, cpm_A->pfn_Free);
+		if (s32_Status == 0) {
+			qrstoreFP32(pm_R, (const float*)p_Block, csz_N, csz_N, csz_N);
+		}
+	} else {
+		s32_Status = qrtsqrFP64((double*)p_Block, csz_N, 0, (const double*)cpm_A->p_StorageBuffer, cpm_A->sz_Height, csz_RowStrideA, csz_ColStrideA,
+			NULL, 1, 0, cpm_A->pfn_Allocate, cpm_A->pfn_Free);
+		if (s32_Status == 0) {
+			qrstoreFP64(pm_R, (const double*)p_Block, csz_N, csz_N, csz_N);
+		}
+	}
+
+	cpm_A->pfn_Free(p_Block);
+	return s32_Status;
+}
+
+int mtxlstsq(matrix_t* pm_X, const matrix_t* cpm_A, const matrix_t* cpm_B) {
+	if (pm_X == NULL || cpm_A == NULL || cpm_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_X) != 0) {
+		return -1;
+	}
+
+	if (mtxmemchk(pm_X) != 0                    ||
+	mtxmemchk(cpm_A) != 0                       ||
+	mtxmemchk(cpm_B) != 0                       ||
+	pm_X->s32_Type != cpm_A->s32_Type           ||
+	cpm_B->s32_Type != cpm_A->s32_Type          ||
+	cpm_A->sz_Height < cpm_A->sz_Width          ||
+	cpm_B->sz_Height != cpm_A->sz_Height        ||
+	pm_X->sz_Height != cpm_A->sz_Width          ||
+	pm_X->sz_Width != cpm_B->sz_Width) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (cpm_A->s32_Type != TYPE_FP32 && cpm_A->s32_Type != TYPE_FP64) {
+		printf("TYPE NOT SUPPORTED!\n");
+		return -1;
+	}
+
+	const size_t csz_N = cpm_A->sz_Width;
+	const size_t csz_Rhs = cpm_B->sz_Width;
+	const size_t csz_M = cpm_A->sz_Height;
+	int s32_Status;
+
+	// [R | Q^T B] is small (n x (n + nrhs)), so the solve happens in scratch and only X is written back
+	void* p_Block = cpm_A->pfn_Allocate(cpm_A->sz_ElementSize * csz_N * (csz_N + csz_Rhs));
+	if (!CHECK_ALLOCATION(p_Block)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+
+	if (cpm_A->s32_Type == TYPE_FP32) {
+		s32_Status = qrtsqrFP32((float*)p_Block, csz_N, csz_Rhs, (const float*)cpm_A->p_StorageBuffer, csz_M, MATRIX_ROW_STRIDE(cpm_A), MATRIX_COL_STRIDE(cpm_A),
+			(const float*)cpm_B->p_StorageBuffer, MATRIX_ROW_STRIDE(cpm_B), MATRIX_COL_STRIDE(cpm_B), cpm_A->pfn_Allocate, cpm_A->pfn_Free);
+		if (s32_Status == 0 && qrsolveFP32((float*)p_Block, csz_M, csz_N, csz_Rhs) != 0) {
+			s32_Status = 1;
+		}
+		if (s32_Status == 0) {
+			qrstoreFP32(pm_X, (const float*)p_Block + csz_N * csz_N, csz_N, csz_N, csz_Rhs);
+		}
+	} else {
+		s32_Status = qrtsqrFP64((double*)p_Block, csz_N, csz_Rhs, (const double*)cpm_A->p_StorageBuffer, csz_M, MATRIX_ROW_STRIDE(cpm_A), MATRIX_COL_STRIDE(cpm_A),
+			(const double*)cpm_B->p_StorageBuffer, MATRIX_ROW_STRIDE(cpm_B), MATRIX_COL_STRIDE(cpm_B), cpm_A->pfn_Allocate, cpm_A->pfn_Free);
+		if (s32_Status == 0 && qrsolveFP64((double*)p_Block, csz_M, csz_N, csz_Rhs) != 0) {
+			s32_Status = 1;
+		}
+		if (s32_Status == 0) {
+			qrstoreFP64(pm_X, (const double*)p_Block + csz_N * csz_N, csz_N, csz_N, csz_Rhs);
+		}
+	}
+
+	if (s32_Status > 0) {
+		printf("MATRIX IS RANK DEFICIENT!\n");
+	}
+
+	cpm_A->pfn_Free(p_Block);
+	return (s32_Status == 0) ? 0 : -1;
+}
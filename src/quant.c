@@ -0,0 +1,663 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "lin99/quant.h"
+#include "internal.h"
+
+// Elements summed into an int32_t before spilling into an int64_t; 255 * 255 * 16384 still fits in int32_t
+#define QDOT_BLOCK  	16384
+// Products accumulated side by side; a constant trip count lets the lane loop vectorise
+#define QDOT_LANES  	32
+// Columns of B scored together so each chunk of a column of A is loaded once for all of them
+#define QGEMM_BLOCK 	8
+// Multiply-adds worth handing to one thread
+#define QGEMM_PARALLEL_WORK	(1 << 20)
+
+#define IS_QUANTIZED_TYPE(type) ((type) == TYPE_S8 || (type) == TYPE_U8)
+
+/**
+ * QDOT_KERNEL_DEF - Generates widening 8-bit dot products for one pair of element types.
+ *
+ * The products are accumulated in QDOT_LANES int32_t lanes, and the lanes are spilled to int64_t every
+ * QDOT_BLOCK elements, before any of them can overflow.  This is the portable path; AVX2 and VNNI builds use
+ * the intrinsic kernels below and only hand it their tails.  qdots scores one column of A against up to
+ * QGEMM_BLOCK columns of B, csz_LdB bytes apart, reusing each chunk of A while it is in registers.
+ */
+#define QDOT_KERNEL_DEF(typeA, typeB, abbr) \
+static inline void qlanes##abbr(int32_t* restrict ps32_Lanes, const typeA* restrict cp_A, const typeB* restrict cp_B) { \
+	for (size_t sz_Lane = 0; sz_Lane < QDOT_LANES; ++sz_Lane) { \
+		ps32_Lanes[sz_Lane] += (int32_t)cp_A[sz_Lane] * (int32_t)cp_B[sz_Lane]; \
+	} \
+} \
+\
+static void qdots##abbr(int64_t* ps64_Dots, const typeA* cp_A, const typeB* cp_B, const size_t csz_LdB, const size_t csz_Count, const size_t csz_Length) { \
+	int32_t a_Lanes[QGEMM_BLOCK][QDOT_LANES]; \
+	const size_t csz_Full = csz_Length - csz_Length % QDOT_LANES; \
+	\
+	for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+		ps64_Dots[sz_J] = 0; \
+	} \
+	\
+	for (size_t sz_Block = 0; sz_Block < csz_Full; sz_Block += QDOT_BLOCK) { \
+		const size_t csz_End = (csz_Full - sz_Block < QDOT_BLOCK) ? csz_Full : sz_Block + QDOT_BLOCK; \
+		\
+		memset(a_Lanes, 0, sizeof(a_Lanes)); \
+		for (size_t sz_Idx = sz_Block; sz_Idx < csz_End; sz_Idx += QDOT_LANES) { \
+			for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+				qlanes##abbr(a_Lanes[sz_J], cp_A + sz_Idx, cp_B + sz_J * csz_LdB + sz_Idx); \
+			} \
+		} \
+		for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+			for (size_t sz_Lane = 0; sz_Lane < QDOT_LANES; ++sz_Lane) { \
+				ps64_Dots[sz_J] += a_Lanes[sz_J][sz_Lane]; \
+			} \
+		} \
+	} \
+	\
+	for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+		for (size_t sz_Idx = csz_Full; sz_Idx < csz_Length; ++sz_Idx) { \
+			ps64_Dots[sz_J] += (int32_t)cp_A[sz_Idx] * (int32_t)cp_B[sz_J * csz_LdB + sz_Idx]; \
+		} \
+	} \
+	return; \
+}
+
+QDOT_KERNEL_DEF(int8_t, int8_t, S8S8)
+QDOT_KERNEL_DEF(uint8_t, uint8_t, U8U8)
+QDOT_KERNEL_DEF(uint8_t, int8_t, U8S8)
+QDOT_KERNEL_DEF(int8_t, uint8_t, S8U8)
+
+/**
+ * QDOT_AVX2_DEF / QDOT_VNNI_DEF - Intrinsic versions of qdots##abbr for builds targeting AVX2 or VNNI.
+ *
+ * GCC does not lower the lane loop above onto multiply-add instructions, so they are spelled out here.  The
+ * AVX2 path widens 16 elements of each operand to int16_t and sums adjacent products with pmaddwd; pmaddubsw
+ * is not used because it saturates a pair such as 255 * 127 + 255 * 127 to int16_t.  vpdpbusd multiplies
+ * unsigned by signed bytes straight into int32_t lanes: S8U8 swaps its operands, and S8S8 flips A into
+ * unsigned range (A + 128) and subtracts 128 * sum(B) afterwards.  U8U8 has no unsigned-by-unsigned form and
+ * keeps the AVX2 path.  Both spill their lanes every QDOT_BLOCK elements like the scalar loop, and hand the
+ * last csz_Length % QDOT_LANES elements to it.
+ */
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+#define QDOT_DPBUSD(acc, u, s)	_mm256_dpbusd_epi32((acc), (u), (s))
+#elif defined(__AVXVNNI__)
+#define QDOT_DPBUSD(acc, u, s)	_mm256_dpbusd_avx_epi32((acc), (u), (s))
+#endif
+
+#if defined(__AVX2__)
+#define QDOT_WIDEN_S8(p)	_mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(p)))
+#define QDOT_WIDEN_U8(p)	_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(p)))
+
+// Sum of the eight int32_t lanes of a register, widened so the caller can add it to an int64_t dot
+static inline int64_t qhsum(const __m256i cv_Lanes) {
+	int32_t a_Lanes[8];
+	int64_t s64_Sum = 0;
+
+	_mm256_storeu_si256((__m256i*)a_Lanes, cv_Lanes);
+	for (size_t sz_Lane = 0; sz_Lane < 8; ++sz_Lane) {
+		s64_Sum += a_Lanes[sz_Lane];
+	}
+	return s64_Sum;
+}
+
+// The last csz_Length % QDOT_LANES elements go through the scalar kernel, which sees them as a short dot
+#define QDOT_TAIL(abbr) \
+	int64_t a_Tail[QGEMM_BLOCK]; \
+	qdots##abbr(a_Tail, cp_A + csz_Full, cp_B + csz_Full, csz_LdB, csz_Count, csz_Length - csz_Full); \
+	for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+		ps64_Dots[sz_J] += a_Tail[sz_J]; \
+	}
+
+#define QDOT_AVX2_DEF(typeA, typeB, abbr, widenA, widenB) \
+static void qavx2##abbr(int64_t* ps64_Dots, const typeA* cp_A, const typeB* cp_B, const size_t csz_LdB, const size_t csz_Count, const size_t csz_Length) { \
+	__m256i a_Lanes[QGEMM_BLOCK]; \
+	const size_t csz_Full = csz_Length - csz_Length % QDOT_LANES; \
+	\
+	for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+		ps64_Dots[sz_J] = 0; \
+	} \
+	\
+	for (size_t sz_Block = 0; sz_Block < csz_Full; sz_Block += QDOT_BLOCK) { \
+		const size_t csz_End = (csz_Full - sz_Block < QDOT_BLOCK) ? csz_Full : sz_Block + QDOT_BLOCK; \
+		\
+		for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+			a_Lanes[sz_J] = _mm256_setzero_si256(); \
+		} \
+		for (size_t sz_Idx = sz_Block; sz_Idx < csz_End; sz_Idx += 16) { \
+			const __m256i cv_A = widenA(cp_A + sz_Idx); \
+			for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+				a_Lanes[sz_J] = _mm256_add_epi32(a_Lanes[sz_J], _mm256_madd_epi16(cv_A, widenB(cp_B + sz_J * csz_LdB + sz_Idx))); \
+			} \
+		} \
+		for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+			ps64_Dots[sz_J] += qhsum(a_Lanes[sz_J]); \
+		} \
+	} \
+	\
+	QDOT_TAIL(abbr) \
+	return; \
+}
+
+QDOT_AVX2_DEF(uint8_t, uint8_t, U8U8, QDOT_WIDEN_U8, QDOT_WIDEN_U8)
+#if !defined(QDOT_DPBUSD)
+QDOT_AVX2_DEF(int8_t, int8_t, S8S8, QDOT_WIDEN_S8, QDOT_WIDEN_S8)
+QDOT_AVX2_DEF(uint8_t, int8_t, U8S8, QDOT_WIDEN_U8, QDOT_WIDEN_S8)
+QDOT_AVX2_DEF(int8_t, uint8_t, S8U8, QDOT_WIDEN_S8, QDOT_WIDEN_U8)
+#endif
+#endif
+
+#if defined(__AVX2__) && defined(QDOT_DPBUSD)
+// One 32-byte step: unsigned operand first, and S8S8 also counts sum(B) in the bias lanes
+#define QDOT_STEP_U8S8(lanes, bias, a, b)	(lanes) = QDOT_DPBUSD((lanes), (a), (b))
+#define QDOT_STEP_S8U8(lanes, bias, a, b)	(lanes) = QDOT_DPBUSD((lanes), (b), (a))
+#define QDOT_STEP_S8S8(lanes, bias, a, b) \
+	(lanes) = QDOT_DPBUSD((lanes), _mm256_xor_si256((a), _mm256_set1_epi8((char)0x80)), (b)); \
+	(bias) = QDOT_DPBUSD((bias), _mm256_set1_epi8(1), (b))
+
+#define QDOT_VNNI_DEF(typeA, typeB, abbr) \
+static void qvnni##abbr(int64_t* ps64_Dots, const typeA* cp_A, const typeB* cp_B, const size_t csz_LdB, const size_t csz_Count, const size_t csz_Length) { \
+	__m256i a_Lanes[QGEMM_BLOCK], a_Bias[QGEMM_BLOCK]; \
+	const size_t csz_Full = csz_Length - csz_Length % QDOT_LANES; \
+	\
+	for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+		ps64_Dots[sz_J] = 0; \
+	} \
+	\
+	for (size_t sz_Block = 0; sz_Block < csz_Full; sz_Block += QDOT_BLOCK) { \
+		const size_t csz_End = (csz_Full - sz_Block < QDOT_BLOCK) ? csz_Full : sz_Block + QDOT_BLOCK; \
+		\
+		for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+			a_Lanes[sz_J] = _mm256_setzero_si256(); \
+			a_Bias[sz_J] = _mm256_setzero_si256(); \
+		} \
+		for (size_t sz_Idx = sz_Block; sz_Idx < csz_End; sz_Idx += QDOT_LANES) { \
+			const __m256i cv_A = _mm256_loadu_si256((const __m256i*)(cp_A + sz_Idx)); \
+			for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+				const __m256i cv_B = _mm256_loadu_si256((const __m256i*)(cp_B + sz_J * csz_LdB + sz_Idx)); \
+				QDOT_STEP_##abbr(a_Lanes[sz_J], a_Bias[sz_J], cv_A, cv_B); \
+			} \
+		} \
+		for (size_t sz_J = 0; sz_J < csz_Count; ++sz_J) { \
+			ps64_Dots[sz_J] += qhsum(a_Lanes[sz_J]) - 128 * qhsum(a_Bias[sz_J]); \
+		} \
+	} \
+	\
+	QDOT_TAIL(abbr) \
+	return; \
+}
+
+QDOT_VNNI_DEF(int8_t, int8_t, S8S8)
+QDOT_VNNI_DEF(uint8_t, int8_t, U8S8)
+QDOT_VNNI_DEF(int8_t, uint8_t, S8U8)
+
+#define QDOT_PATH_S8S8	qvnniS8S8
+#define QDOT_PATH_U8U8	qavx2U8U8
+#define QDOT_PATH_U8S8	qvnniU8S8
+#define QDOT_PATH_S8U8	qvnniS8U8
+#elif defined(__AVX2__)
+#define QDOT_PATH_S8S8	qavx2S8S8
+#define QDOT_PATH_U8U8	qavx2U8U8
+#define QDOT_PATH_U8S8	qavx2U8S8
+#define QDOT_PATH_S8U8	qavx2S8U8
+#else
+#define QDOT_PATH_S8S8	qdotsS8S8
+#define QDOT_PATH_U8U8	qdotsU8U8
+#define QDOT_PATH_U8S8	qdotsU8S8
+#define QDOT_PATH_S8U8	qdotsS8U8
+#endif
+
+// One column of A against csz_Count columns of B, dispatched on the element types
+static void qdots(int64_t* ps64_Dots, const void* cp_A, const TYPE cs32_TypeA, const void* cp_B, const TYPE cs32_TypeB, const size_t csz_LdB, const size_t csz_Count, const size_t csz_Length) {
+	if (cs32_TypeA == TYPE_S8 && cs32_TypeB == TYPE_S8) {
+		QDOT_PATH_S8S8(ps64_Dots, (const int8_t*)cp_A, (const int8_t*)cp_B, csz_LdB, csz_Count, csz_Length);
+	} else if (cs32_TypeA == TYPE_U8 && cs32_TypeB == TYPE_U8) {
+		QDOT_PATH_U8U8(ps64_Dots, (const uint8_t*)cp_A, (const uint8_t*)cp_B, csz_LdB, csz_Count, csz_Length);
+	} else if (cs32_TypeA == TYPE_U8) {
+		QDOT_PATH_U8S8(ps64_Dots, (const uint8_t*)cp_A, (const int8_t*)cp_B, csz_LdB, csz_Count, csz_Length);
+	} else {
+		QDOT_PATH_S8U8(ps64_Dots, (const int8_t*)cp_A, (const uint8_t*)cp_B, csz_LdB, csz_Count, csz_Length);
+	}
+	return;
+}
+
+static int64_t qdot(const void* cp_A, const TYPE cs32_TypeA, const void* cp_B, const TYPE cs32_TypeB, const size_t csz_Length) {
+	int64_t s64_Dot;
+
+	qdots(&s64_Dot, cp_A, cs32_TypeA, cp_B, cs32_TypeB, 0, 1, csz_Length);
+	return s64_Dot;
+}
+
+static int64_t qsum(const void* cp_Data, const TYPE cs32_Type, const size_t csz_Length) {
+	int64_t s64_Sum = 0;
+
+	if (cs32_Type == TYPE_S8) {
+		const int8_t* cps8_Data = (const int8_t*)cp_Data;
+		for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) {
+			s64_Sum += cps8_Data[sz_Idx];
+		}
+	} else {
+		const uint8_t* cpu8_Data = (const uint8_t*)cp_Data;
+		for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) {
+			s64_Sum += cpu8_Data[sz_Idx];
+		}
+	}
+
+	return s64_Sum;
+}
+
+// sum((a - za) * (b - zb)) expanded so the integer kernel only ever sees the raw codes
+static float qdequantize(const int64_t cs64_Dot, const int64_t cs64_SumA, const int64_t cs64_SumB, const size_t csz_Length,
+	const float cf32_ScaleA, const int32_t cs32_ZeroPointA, const float cf32_ScaleB, const int32_t cs32_ZeroPointB) {
+	int64_t s64_Corrected = cs64_Dot
+		- (int64_t)cs32_ZeroPointB * cs64_SumA
+		- (int64_t)cs32_ZeroPointA * cs64_SumB
+		+ (int64_t)csz_Length * cs32_ZeroPointA * cs32_ZeroPointB;
+
+	return (float)((double)cf32_ScaleA * (double)cf32_ScaleB * (double)s64_Corrected);
+}
+
+/**
+ * qparams - Scale and zero point covering [cf32_Low, cf32_High].
+ *
+ * TYPE_S8 uses the symmetric range [-127, 127] so that negation never overflows.  TYPE_U8 stretches
+ * [min(x, 0), max(x, 0)] over [0, 255], keeping 0.0 exactly representable by its zero point.
+ */
+static void qparams(const TYPE cs32_Type, const float cf32_Low, const float cf32_High, float* pf32_Scale, int32_t* ps32_ZeroPoint) {
+	if (cs32_Type == TYPE_S8) {
+		float f32_Range = (-cf32_Low > cf32_High) ? -cf32_Low : cf32_High;
+		*pf32_Scale = (f32_Range > 0.0f) ? f32_Range / 127.0f : 1.0f;
+		*ps32_ZeroPoint = 0;
+		return;
+	}
+
+	*pf32_Scale = (cf32_High - cf32_Low > 0.0f) ? (cf32_High - cf32_Low) / 255.0f : 1.0f;
+	long l_ZeroPoint = lrintf(-cf32_Low / *pf32_Scale);
+	l_ZeroPoint = (l_ZeroPoint > 255) ? 255 : l_ZeroPoint;
+	l_ZeroPoint = (l_ZeroPoint < 0) ? 0 : l_ZeroPoint;
+	*ps32_ZeroPoint = (int32_t)l_ZeroPoint;
+	return;
+}
+
+static void qencode(uint8_t* pu8_Code, const TYPE cs32_Type, const float cf32_Value, const float cf32_Scale, const int32_t cs32_ZeroPoint) {
+	long l_Code = lrintf(cf32_Value / cf32_Scale) + cs32_ZeroPoint;
+
+	if (cs32_Type == TYPE_S8) {
+		l_Code = (l_Code > 127) ? 127 : l_Code;
+		l_Code = (l_Code < -127) ? -127 : l_Code;
+		*(int8_t*)pu8_Code = (int8_t)l_Code;
+		return;
+	}
+
+	l_Code = (l_Code > 255) ? 255 : l_Code;
+	l_Code = (l_Code < 0) ? 0 : l_Code;
+	*pu8_Code = (uint8_t)l_Code;
+	return;
+}
+
+// Quantize one run of floats, csz_SourceStride floats apart, into codes csz_QuantizedStride bytes apart
+static void qcolumn(void* p_Quantized, const size_t csz_QuantizedStride, const TYPE cs32_Type, float* pf32_Scale, int32_t* ps32_ZeroPoint,
+	const float* cpf32_Source, const size_t csz_SourceStride, const size_t csz_Length) {
+	float f32_Low = 0.0f;
+	float f32_High = 0.0f;
+	int32_t s32_ZeroPoint;
+
+	for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) {
+		const float cf32_Value = cpf32_Source[sz_Idx * csz_SourceStride];
+		f32_Low = (cf32_Value < f32_Low) ? cf32_Value : f32_Low;
+		f32_High = (cf32_Value > f32_High) ? cf32_Value : f32_High;
+	}
+
+	qparams(cs32_Type, f32_Low, f32_High, pf32_Scale, &s32_ZeroPoint);
+	for (size_t sz_Idx = 0; sz_Idx < csz_Length; ++sz_Idx) {
+		qencode((uint8_t*)p_Quantized + sz_Idx * csz_QuantizedStride, cs32_Type, cpf32_Source[sz_Idx * csz_SourceStride], *pf32_Scale, s32_ZeroPoint);
+	}
+
+	if (ps32_ZeroPoint != NULL) {
+		*ps32_ZeroPoint = s32_ZeroPoint;
+	}
+	return;
+}
+
+// Copy a row-major quantized matrix into packed column-major scratch so every column is contiguous for qdot
+static uint8_t* qpack(const matrix_t* cpm_Matrix) {
+	uint8_t* pu8_Packed = (uint8_t*)cpm_Matrix->pfn_Allocate(cpm_Matrix->sz_ElementCount);
+	if (!CHECK_ALLOCATION(pu8_Packed)) {
+		return NULL;
+	}
+
+	const size_t csz_Ld = MATRIX_LEADING_DIM(cpm_Matrix);
+	for (size_t sz_Row = 0; sz_Row < cpm_Matrix->sz_Height; ++sz_Row) {
+		const uint8_t* cpu8_Row = (const uint8_t*)cpm_Matrix->p_StorageBuffer + sz_Row * csz_Ld;
+		for (size_t sz_Col = 0; sz_Col < cpm_Matrix->sz_Width; ++sz_Col) {
+			pu8_Packed[sz_Row + sz_Col * cpm_Matrix->sz_Height] = cpu8_Row[sz_Col];
+		}
+	}
+	return pu8_Packed;
+}
+
+/**
+ * qgemm_t - Operands of mtxqgemm shared by every thread.
+ *
+ * Members:
+ * - pf32_Result/sz_RowStrideR/sz_ColStrideR: Result storage and its element strides.
+ * - cpu8_A/cpu8_B/sz_LdA/sz_LdB: Column-major codes of both operands and the distance between their columns.
+ * - s32_TypeA/s32_TypeB: TYPE_S8 or TYPE_U8.
+ * - sz_WidthA/sz_WidthB/sz_Length: Column counts and the shared column length.
+ * - cpf32_ScalesA/cps32_ZeroPointsA/cpf32_ScalesB/cps32_ZeroPointsB: Per-column quantization parameters.
+ * - cps64_SumsA: Column sums of A, or NULL when B has no zero points.
+ */
+typedef struct __qgemm_t {
+	float* pf32_Result;
+	size_t sz_RowStrideR;
+	size_t sz_ColStrideR;
+	const uint8_t* cpu8_A;
+	const uint8_t* cpu8_B;
+	size_t sz_LdA;
+	size_t sz_LdB;
+	TYPE s32_TypeA;
+	TYPE s32_TypeB;
+	size_t sz_WidthA;
+	size_t sz_WidthB;
+	size_t sz_Length;
+	const float* cpf32_ScalesA;
+	const int32_t* cps32_ZeroPointsA;
+	const float* cpf32_ScalesB;
+	const int32_t* cps32_ZeroPointsB;
+	const int64_t* cps64_SumsA;
+} qgemm_t;
+
+// Scores tiles [sz_Begin, sz_End) of QGEMM_BLOCK columns of B against every column of A
+static void qgemmtiles(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const qgemm_t* cp_Gemm = (const qgemm_t*)p_Context;
+	(void)sz_Chunk;
+
+	for (size_t sz_Tile = sz_Begin; sz_Tile < sz_End; ++sz_Tile) {
+		const size_t csz_ColB0 = sz_Tile * QGEMM_BLOCK;
+		const size_t csz_Block = (cp_Gemm->sz_WidthB - csz_ColB0 < QGEMM_BLOCK) ? cp_Gemm->sz_WidthB - csz_ColB0 : QGEMM_BLOCK;
+		const uint8_t* cpu8_TileB = cp_Gemm->cpu8_B + csz_ColB0 * cp_Gemm->sz_LdB;
+		int64_t a_SumsB[QGEMM_BLOCK] = {0};
+		int64_t a_Dots[QGEMM_BLOCK];
+
+		if (cp_Gemm->cps32_ZeroPointsA != NULL) {
+			for (size_t sz_J = 0; sz_J < csz_Block; ++sz_J) {
+				a_SumsB[sz_J] = qsum(cpu8_TileB + sz_J * cp_Gemm->sz_LdB, cp_Gemm->s32_TypeB, cp_Gemm->sz_Length);
+			}
+		}
+
+		for (size_t sz_ColA = 0; sz_ColA < cp_Gemm->sz_WidthA; ++sz_ColA) {
+			const int32_t cs32_ZeroPointA = (cp_Gemm->cps32_ZeroPointsA != NULL) ? cp_Gemm->cps32_ZeroPointsA[sz_ColA] : 0;
+
+			qdots(a_Dots, cp_Gemm->cpu8_A + sz_ColA * cp_Gemm->sz_LdA, cp_Gemm->s32_TypeA, cpu8_TileB, cp_Gemm->s32_TypeB, cp_Gemm->sz_LdB, csz_Block, cp_Gemm->sz_Length);
+			for (size_t sz_J = 0; sz_J < csz_Block; ++sz_J) {
+				const size_t csz_ColB = csz_ColB0 + sz_J;
+				const int32_t cs32_ZeroPointB = (cp_Gemm->cps32_ZeroPointsB != NULL) ? cp_Gemm->cps32_ZeroPointsB[csz_ColB] : 0;
+
+				cp_Gemm->pf32_Result[sz_ColA * cp_Gemm->sz_RowStrideR + csz_ColB * cp_Gemm->sz_ColStrideR] = qdequantize(a_Dots[sz_J],
+					(cp_Gemm->cps64_SumsA != NULL) ? cp_Gemm->cps64_SumsA[sz_ColA] : 0, a_SumsB[sz_J], cp_Gemm->sz_Length,
+					cp_Gemm->cpf32_ScalesA[sz_ColA], cs32_ZeroPointA, cp_Gemm->cpf32_ScalesB[csz_ColB], cs32_ZeroPointB);
+			}
+		}
+	}
+	return;
+}
+
+int vctquantize(vector_t* pv_Quantized, float* pf32_Scale, int32_t* ps32_ZeroPoint, const vector_t* cpv_Source) {
+	if (pv_Quantized == NULL || pf32_Scale == NULL || cpv_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Quantized) != 0                            ||
+	vctmemchk(cpv_Source) != 0                                  ||
+	cpv_Source->s32_Type != TYPE_FP32                           ||
+	!IS_QUANTIZED_TYPE(pv_Quantized->s32_Type)                  ||
+	(pv_Quantized->s32_Type == TYPE_U8 && ps32_ZeroPoint == NULL) ||
+	pv_Quantized->sz_ElementCount != cpv_Source->sz_ElementCount) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (vctunique(pv_Quantized) != 0) {
+		return -1;
+	}
+
+	qcolumn(pv_Quantized->p_StorageBuffer, 1, pv_Quantized->s32_Type, pf32_Scale, ps32_ZeroPoint, (const float*)cpv_Source->p_StorageBuffer, 1, cpv_Source->sz_ElementCount);
+	return 0;
+}
+
+int mtxquantize(matrix_t* pm_Quantized, float* pf32_Scales, int32_t* ps32_ZeroPoints, const matrix_t* cpm_Source) {
+	if (pm_Quantized == NULL || pf32_Scales == NULL || cpm_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Quantized) != 0                            ||
+	mtxmemchk(cpm_Source) != 0                                  ||
+	cpm_Source->s32_Type != TYPE_FP32                           ||
+	!IS_QUANTIZED_TYPE(pm_Quantized->s32_Type)                  ||
+	(pm_Quantized->s32_Type == TYPE_U8 && ps32_ZeroPoints == NULL) ||
+	pm_Quantized->sz_Width != cpm_Source->sz_Width              ||
+	pm_Quantized->sz_Height != cpm_Source->sz_Height) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Quantized) != 0) {
+		return -1;
+	}
+
+	const float* cpf32_Source = (const float*)cpm_Source->p_StorageBuffer;
+	uint8_t* pu8_Quantized = (uint8_t*)pm_Quantized->p_StorageBuffer;
+	const size_t csz_RowStrideS = MATRIX_ROW_STRIDE(cpm_Source), csz_ColStrideS = MATRIX_COL_STRIDE(cpm_Source);
+	const size_t csz_RowStrideQ = MATRIX_ROW_STRIDE(pm_Quantized), csz_ColStrideQ = MATRIX_COL_STRIDE(pm_Quantized);
+
+	if (!MATRIX_IS_ROW_MAJOR(cpm_Source)) {
+		for (size_t sz_Col = 0; sz_Col < cpm_Source->sz_Width; ++sz_Col) {
+			qcolumn(pu8_Quantized + sz_Col * csz_ColStrideQ, csz_RowStrideQ, pm_Quantized->s32_Type,
+				&pf32_Scales[sz_Col], (ps32_ZeroPoints != NULL) ? &ps32_ZeroPoints[sz_Col] : NULL,
+				cpf32_Source + sz_Col * csz_ColStrideS, csz_RowStrideS, cpm_Source->sz_Height);
+		}
+		return 0;
+	}
+
+	// Row-major sources are streamed a row at a time, once for the column ranges and once for the codes
+	float* pf32_Ranges = (float*)cpm_Source->pfn_Allocate(sizeof(float) * 2 * cpm_Source->sz_Width);
+	int32_t* ps32_Zeros = (int32_t*)cpm_Source->pfn_Allocate(sizeof(int32_t) * cpm_Source->sz_Width);
+	if (!CHECK_ALLOCATION(pf32_Ranges) || !CHECK_ALLOCATION(ps32_Zeros)) {
+		if (CHECK_ALLOCATION(pf32_Ranges)) {
+			cpm_Source->pfn_Free(pf32_Ranges);
+		}
+		if (CHECK_ALLOCATION(ps32_Zeros)) {
+			cpm_Source->pfn_Free(ps32_Zeros);
+		}
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	float* pf32_Low = pf32_Ranges;
+	float* pf32_High = pf32_Ranges + cpm_Source->sz_Width;
+
+	memset(pf32_Ranges, 0, sizeof(float) * 2 * cpm_Source->sz_Width);
+	for (size_t sz_Row = 0; sz_Row < cpm_Source->sz_Height; ++sz_Row) {
+		const float* cpf32_Row = cpf32_Source + sz_Row * csz_RowStrideS;
+		for (size_t sz_Col = 0; sz_Col < cpm_Source->sz_Width; ++sz_Col) {
+			pf32_Low[sz_Col] = (cpf32_Row[sz_Col] < pf32_Low[sz_Col]) ? cpf32_Row[sz_Col] : pf32_Low[sz_Col];
+			pf32_High[sz_Col] = (cpf32_Row[sz_Col] > pf32_High[sz_Col]) ? cpf32_Row[sz_Col] : pf32_High[sz_Col];
+		}
+	}
+
+	for (size_t sz_Col = 0; sz_Col < cpm_Source->sz_Width; ++sz_Col) {
+		qparams(pm_Quantized->s32_Type, pf32_Low[sz_Col], pf32_High[sz_Col], &pf32_Scales[sz_Col], &ps32_Zeros[sz_Col]);
+		if (ps32_ZeroPoints != NULL) {
+			ps32_ZeroPoints[sz_Col] = ps32_Zeros[sz_Col];
+		}
+	}
+
+	for (size_t sz_Row = 0; sz_Row < cpm_Source->sz_Height; ++sz_Row) {
+		const float* cpf32_Row = cpf32_Source + sz_Row * csz_RowStrideS;
+		for (size_t sz_Col = 0; sz_Col < cpm_Source->sz_Width; ++sz_Col) {
+			qencode(pu8_Quantized + sz_Row * csz_RowStrideQ + sz_Col * csz_ColStrideQ, pm_Quantized->s32_Type,
+				cpf32_Row[sz_Col], pf32_Scales[sz_Col], ps32_Zeros[sz_Col]);
+		}
+	}
+
+	cpm_Source->pfn_Free(ps32_Zeros);
+	cpm_Source->pfn_Free(pf32_Ranges);
+	return 0;
+}
+
+int vctdots32(int32_t* ps32_Product, const vector_t* cpv_A, const vector_t* cpv_B) {
+	if (ps32_Product == NULL || cpv_A == NULL || cpv_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(cpv_A) != 0                       ||
+	vctmemchk(cpv_B) != 0                           ||
+	!IS_QUANTIZED_TYPE(cpv_A->s32_Type)             ||
+	!IS_QUANTIZED_TYPE(cpv_B->s32_Type)             ||
+	cpv_A->sz_ElementCount != cpv_B->sz_ElementCount) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	int64_t s64_Dot = qdot(cpv_A->p_StorageBuffer, cpv_A->s32_Type, cpv_B->p_StorageBuffer, cpv_B->s32_Type, cpv_A->sz_ElementCount);
+	s64_Dot = (s64_Dot > INT32_MAX) ? INT32_MAX : s64_Dot;
+	s64_Dot = (s64_Dot < INT32_MIN) ? INT32_MIN : s64_Dot;
+	*ps32_Product = (int32_t)s64_Dot;
+
+	return 0;
+}
+
+int vctqdot(float* pf32_Product, const vector_t* cpv_A, const float cf32_ScaleA, const int32_t cs32_ZeroPointA, const vector_t* cpv_B, const float cf32_ScaleB, const int32_t cs32_ZeroPointB) {
+	if (pf32_Product == NULL || cpv_A == NULL || cpv_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(cpv_A) != 0                       ||
+	vctmemchk(cpv_B) != 0                           ||
+	!IS_QUANTIZED_TYPE(cpv_A->s32_Type)             ||
+	!IS_QUANTIZED_TYPE(cpv_B->s32_Type)             ||
+	cpv_A->sz_ElementCount != cpv_B->sz_ElementCount) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_Length = cpv_A->sz_ElementCount;
+	int64_t s64_Dot = qdot(cpv_A->p_StorageBuffer, cpv_A->s32_Type, cpv_B->p_StorageBuffer, cpv_B->s32_Type, csz_Length);
+	int64_t s64_SumA = (cs32_ZeroPointB != 0) ? qsum(cpv_A->p_StorageBuffer, cpv_A->s32_Type, csz_Length) : 0;
+	int64_t s64_SumB = (cs32_ZeroPointA != 0) ? qsum(cpv_B->p_StorageBuffer, cpv_B->s32_Type, csz_Length) : 0;
+
+	*pf32_Product = qdequantize(s64_Dot, s64_SumA, s64_SumB, csz_Length, cf32_ScaleA, cs32_ZeroPointA, cf32_ScaleB, cs32_ZeroPointB);
+	return 0;
+}
+
+int mtxqgemm(matrix_t* pm_Result, const matrix_t* cpm_A, const float* cpf32_ScalesA, const int32_t* cps32_ZeroPointsA, const matrix_t* cpm_B, const float* cpf32_ScalesB, const int32_t* cps32_ZeroPointsB) {
+	if (pm_Result == NULL || cpm_A == NULL || cpf32_ScalesA == NULL || cpm_B == NULL || cpf32_ScalesB == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Result) != 0                   ||
+	mtxmemchk(cpm_A) != 0                           ||
+	mtxmemchk(cpm_B) != 0                           ||
+	!IS_QUANTIZED_TYPE(cpm_A->s32_Type)             ||
+	!IS_QUANTIZED_TYPE(cpm_B->s32_Type)             ||
+	pm_Result->s32_Type != TYPE_FP32                ||
+	cpm_A->sz_Height != cpm_B->sz_Height            ||
+	pm_Result->sz_Height != cpm_A->sz_Width         ||
+	pm_Result->sz_Width != cpm_B->sz_Width) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Result) != 0) {
+		return -1;
+	}
+
+	const size_t csz_Length = cpm_A->sz_Height;
+
+	// The kernels need contiguous columns, so row-major operands are packed once; column-major ones are used in place
+	uint8_t* pu8_PackedA = NULL;
+	uint8_t* pu8_PackedB = NULL;
+	if (MATRIX_IS_ROW_MAJOR(cpm_A) && (pu8_PackedA = qpack(cpm_A)) == NULL) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	if (MATRIX_IS_ROW_MAJOR(cpm_B) && (pu8_PackedB = qpack(cpm_B)) == NULL) {
+		if (pu8_PackedA != NULL) {
+			cpm_A->pfn_Free(pu8_PackedA);
+		}
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	const uint8_t* cpu8_A = (pu8_PackedA != NULL) ? pu8_PackedA : (const uint8_t*)cpm_A->p_StorageBuffer;
+	const uint8_t* cpu8_B = (pu8_PackedB != NULL) ? pu8_PackedB : (const uint8_t*)cpm_B->p_StorageBuffer;
+	const size_t csz_LdA = (pu8_PackedA != NULL) ? csz_Length : MATRIX_LEADING_DIM(cpm_A);
+	const size_t csz_LdB = (pu8_PackedB != NULL) ? csz_Length : MATRIX_LEADING_DIM(cpm_B);
+
+	// Column sums of A are only needed to correct for the zero points of B, so they are computed once up front
+	int64_t* ps64_SumsA = NULL;
+	if (cps32_ZeroPointsB != NULL) {
+		ps64_SumsA = (int64_t*)cpm_A->pfn_Allocate(sizeof(int64_t) * cpm_A->sz_Width);
+		if (!CHECK_ALLOCATION(ps64_SumsA)) {
+			if (pu8_PackedA != NULL) {
+				cpm_A->pfn_Free(pu8_PackedA);
+			}
+			if (pu8_PackedB != NULL) {
+				cpm_B->pfn_Free(pu8_PackedB);
+			}
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+		for (size_t sz_Col = 0; sz_Col < cpm_A->sz_Width; ++sz_Col) {
+			ps64_SumsA[sz_Col] = qsum(cpu8_A + sz_Col * csz_LdA, cpm_A->s32_Type, csz_Length);
+		}
+	}
+
+	qgemm_t s_Gemm;
+	s_Gemm.pf32_Result = (float*)pm_Result->p_StorageBuffer;
+	s_Gemm.sz_RowStrideR = MATRIX_ROW_STRIDE(pm_Result);
+	s_Gemm.sz_ColStrideR = MATRIX_COL_STRIDE(pm_Result);
+	s_Gemm.cpu8_A = cpu8_A;
+	s_Gemm.cpu8_B = cpu8_B;
+	s_Gemm.sz_LdA = csz_LdA;
+	s_Gemm.sz_LdB = csz_LdB;
+	s_Gemm.s32_TypeA = cpm_A->s32_Type;
+	s_Gemm.s32_TypeB = cpm_B->s32_Type;
+	s_Gemm.sz_WidthA = cpm_A->sz_Width;
+	s_Gemm.sz_WidthB = cpm_B->sz_Width;
+	s_Gemm.sz_Length = csz_Length;
+	s_Gemm.cpf32_ScalesA = cpf32_ScalesA;
+	s_Gemm.cps32_ZeroPointsA = cps32_ZeroPointsA;
+	s_Gemm.cpf32_ScalesB = cpf32_ScalesB;
+	s_Gemm.cps32_ZeroPointsB = cps32_ZeroPointsB;
+	s_Gemm.cps64_SumsA = ps64_SumsA;
+
+	// Threads take whole tiles of QGEMM_BLOCK columns of B, so every element of the result is written by one thread
+	const size_t csz_Tiles = (cpm_B->sz_Width + QGEMM_BLOCK - 1) / QGEMM_BLOCK;
+	const size_t csz_TileWork = cpm_A->sz_Width * QGEMM_BLOCK * ((csz_Length != 0) ? csz_Length : 1);
+	const int cs32_Status = parfor(csz_Tiles, (csz_TileWork >= QGEMM_PARALLEL_WORK) ? 1 : QGEMM_PARALLEL_WORK / csz_TileWork, qgemmtiles, &s_Gemm);
+
+	if (ps64_SumsA != NULL) {
+		cpm_A->pfn_Free(ps64_SumsA);
+	}
+	if (pu8_PackedA != NULL) {
+		cpm_A->pfn_Free(pu8_PackedA);
+	}
+	if (pu8_PackedB != NULL) {
+		cpm_B->pfn_Free(pu8_PackedB);
+	}
+
+	return cs32_Status;
+}
@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "internal.h"
+
+// Columns of C handled per step of mtxsyrk; the diagonal block is the only place work is wasted
+#define SYRK_BLOCK  	64
+
+/**
+ * RANK_KERNEL_DEF - Generates the native rank-1 and rank-k update kernels for one floating point type.
+ *
+ * Both kernels address the destination through its storage: "lines" are the contiguous runs (columns of a
+ * column-major matrix, rows of a row-major one) csz_Ld elements apart, so the innermost loop is always unit-stride.
+ */
+#define RANK_KERNEL_DEF(type, abbr) \
+/* A[i + o * ld] = alpha * u[i] * v[o], or += when accumulating, for every i < csz_Inner and o < csz_Outer */ \
+static void rankone##abbr(type* p_A, const size_t csz_Ld, const type* cp_U, const size_t csz_Inner, const type* cp_V, const size_t csz_Outer, \
+	const type ct_Alpha, const int cs32_Accumulate) { \
+	for (size_t sz_O = 0; sz_O < csz_Outer; ++sz_O) { \
+		type* p_Line = p_A + sz_O * csz_Ld; \
+		const type ct_Factor = ct_Alpha * cp_V[sz_O]; \
+		\
+		if (cs32_Accumulate) { \
+			for (size_t sz_I = 0; sz_I < csz_Inner; ++sz_I) { \
+				p_Line[sz_I] += ct_Factor * cp_U[sz_I]; \
+			} \
+		} else { \
+			for (size_t sz_I = 0; sz_I < csz_Inner; ++sz_I) { \
+				p_Line[sz_I] = ct_Factor * cp_U[sz_I]; \
+			} \
+		} \
+	} \
+} \
+\
+/**
+ * syrk - Column-major C += alpha * X * X^T on one triangle of the csz_N x csz_N matrix C.
+ *
+ * cs32_TransX is GEMM_NORMAL when X is stored as csz_N x csz_K and GEMM_TRANSPOSE when its storage holds X^T.
+ * Each block column of C is one GEMM for the part strictly inside the triangle plus one small GEMM into
+ * scratch for the diagonal block, of which only the triangle is added back.
+ */ \
+static int syrk##abbr(type* p_C, const size_t csz_LdC, const int cs32_Lower, const size_t csz_N, const size_t csz_K, const type ct_Alpha, \
+	const type* cp_X, const int cs32_TransX, const size_t csz_LdX, void* (*pfn_Allocate)(size_t), void (*pfn_Free)(void*)) { \
+	const int cs32_TransXt = (cs32_TransX == GEMM_NORMAL) ? GEMM_TRANSPOSE : GEMM_NORMAL; \
+	const size_t csz_RowStep = (cs32_TransX == GEMM_NORMAL) ? 1 : csz_LdX; \
+	\
+	type* p_Diagonal = (type*)pfn_Allocate(sizeof(type) * SYRK_BLOCK * SYRK_BLOCK); \
+	if (!CHECK_ALLOCATION(p_Diagonal)) { \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	\
+	for (size_t sz_J0 = 0; sz_J0 < csz_N; sz_J0 += SYRK_BLOCK) { \
+		const size_t csz_Block = (csz_N - sz_J0 < SYRK_BLOCK) ? csz_N - sz_J0 : SYRK_BLOCK; \
+		const type* cp_XJ = cp_X + sz_J0 * csz_RowStep; \
+		\
+		gemm##abbr(cs32_TransX, cs32_TransXt, csz_Block, csz_Block, csz_K, ct_Alpha, cp_XJ, csz_LdX, cp_XJ, csz_LdX, 0, p_Diagonal, csz_Block); \
+		for (size_t sz_J = 0; sz_J < csz_Block; ++sz_J) { \
+			type* p_Column = p_C + sz_J0 + (sz_J0 + sz_J) * csz_LdC; \
+			const size_t csz_Begin = cs32_Lower ? sz_J : 0; \
+			const size_t csz_End = cs32_Lower ? csz_Block : sz_J + 1; \
+			for (size_t sz_I = csz_Begin; sz_I < csz_End; ++sz_I) { \
+				p_Column[sz_I] += p_Diagonal[sz_I + sz_J * csz_Block]; \
+			} \
+		} \
+		\
+		if (cs32_Lower && sz_J0 + csz_Block < csz_N) { \
+			const size_t csz_Row0 = sz_J0 + csz_Block; \
+			gemm##abbr(cs32_TransX, cs32_TransXt, csz_N - csz_Row0, csz_Block, csz_K, ct_Alpha, cp_X + csz_Row0 * csz_RowStep, csz_LdX, \
+				cp_XJ, csz_LdX, 1, p_C + csz_Row0 + sz_J0 * csz_LdC, csz_LdC); \
+		} else if (!cs32_Lower && sz_J0 > 0) { \
+			gemm##abbr(cs32_TransX, cs32_TransXt, sz_J0, csz_Block, csz_K, ct_Alpha, cp_X, csz_LdX, \
+				cp_XJ, csz_LdX, 1, p_C + sz_J0 * csz_LdC, csz_LdC); \
+		} \
+	} \
+	\
+	pfn_Free(p_Diagonal); \
+	return 0; \
+}
+
+RANK_KERNEL_DEF(float, FP32)
+RANK_KERNEL_DEF(double, FP64)
+
+static int ranknative(const TYPE cs32_Type, const size_t csz_ElementSize) {
+	return (cs32_Type == TYPE_FP32 && csz_ElementSize == sizeof(float)) || (cs32_Type == TYPE_FP64 && csz_ElementSize == sizeof(double));
+}
+
+/**
+ * rankupdate - Shared body of vctouter and mtxger on validated operands.
+ *
+ * A row-major matrix stores x y^T as the column-major y x^T, so the operands are swapped for it and the
+ * kernels always run along contiguous lines.  A NULL cp_Alpha overwrites A with x y^T.
+ */
+static int rankupdate(matrix_t* pm_Matrix, const void* cp_Alpha, const vector_t* cpv_X, const vector_t* cpv_Y) {
+	const vector_t* cpv_Inner = MATRIX_IS_ROW_MAJOR(pm_Matrix) ? cpv_Y : cpv_X;
+	const vector_t* cpv_Outer = MATRIX_IS_ROW_MAJOR(pm_Matrix) ? cpv_X : cpv_Y;
+	const size_t csz_Ld = MATRIX_LEADING_DIM(pm_Matrix);
+
+	if (ranknative(pm_Matrix->s32_Type, pm_Matrix->sz_ElementSize)) {
+		if (pm_Matrix->s32_Type == TYPE_FP32) {
+			rankoneFP32((float*)pm_Matrix->p_StorageBuffer, csz_Ld, (const float*)cpv_Inner->p_StorageBuffer, cpv_Inner->sz_ElementCount,
+				(const float*)cpv_Outer->p_StorageBuffer, cpv_Outer->sz_ElementCount, (cp_Alpha != NULL) ? *(const float*)cp_Alpha : 1.0f, cp_Alpha != NULL);
+		} else {
+			rankoneFP64((double*)pm_Matrix->p_StorageBuffer, csz_Ld, (const double*)cpv_Inner->p_StorageBuffer, cpv_Inner->sz_ElementCount,
+				(const double*)cpv_Outer->p_StorageBuffer, cpv_Outer->sz_ElementCount, (cp_Alpha != NULL) ? *(const double*)cp_Alpha : 1.0, cp_Alpha != NULL);
+		}
+		return 0;
+	}
+
+	if (pm_Matrix->pfn_ElementMultiply == NULL || (cp_Alpha != NULL && pm_Matrix->pfn_ElementAdd == NULL)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_Size = pm_Matrix->sz_ElementSize;
+	uint8_t* pu8_Scratch = (uint8_t*)pm_Matrix->pfn_Allocate(2 * csz_Size);
+	if (!CHECK_ALLOCATION(pu8_Scratch)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	uint8_t* pu8_Factor = pu8_Scratch;
+	uint8_t* pu8_Product = pu8_Scratch + csz_Size;
+
+	for (size_t sz_O = 0; sz_O < cpv_Outer->sz_ElementCount; ++sz_O) {
+		uint8_t* pu8_Line = (uint8_t*)pm_Matrix->p_StorageBuffer + sz_O * csz_Ld * csz_Size;
+		const uint8_t* cpu8_Outer = (const uint8_t*)cpv_Outer->p_StorageBuffer + sz_O * csz_Size;
+
+		if (cp_Alpha != NULL) {
+			pm_Matrix->pfn_ElementMultiply(pu8_Factor, cp_Alpha, cpu8_Outer);
+		} else {
+			memcpy(pu8_Factor, cpu8_Outer, csz_Size);
+		}
+
+		for (size_t sz_I = 0; sz_I < cpv_Inner->sz_ElementCount; ++sz_I) {
+			const uint8_t* cpu8_Inner = (const uint8_t*)cpv_Inner->p_StorageBuffer + sz_I * csz_Size;
+			uint8_t* pu8_Out = pu8_Line + sz_I * csz_Size;
+
+			// The inner operand stays on the left, so non-commutative element types still see x_i * y_j
+			if (cp_Alpha == NULL) {
+				pm_Matrix->pfn_ElementMultiply(pu8_Out, (cpv_Inner == cpv_X) ? cpu8_Inner : pu8_Factor, (cpv_Inner == cpv_X) ? pu8_Factor : cpu8_Inner);
+			} else {
+				pm_Matrix->pfn_ElementMultiply(pu8_Product, (cpv_Inner == cpv_X) ? cpu8_Inner : pu8_Factor, (cpv_Inner == cpv_X) ? pu8_Factor : cpu8_Inner);
+				pm_Matrix->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Product);
+			}
+		}
+	}
+
+	pm_Matrix->pfn_Free(pu8_Scratch);
+	return 0;
+}
+
+static int rankcheck(const matrix_t* cpm_Matrix, const vector_t* cpv_X, const vector_t* cpv_Y) {
+	if (mtxmemchk(cpm_Matrix) != 0                              ||
+	vctmemchk(cpv_X) != 0                                       ||
+	vctmemchk(cpv_Y) != 0                                       ||
+	cpv_X->s32_Type != cpm_Matrix->s32_Type                     ||
+	cpv_Y->s32_Type != cpm_Matrix->s32_Type                     ||
+	cpv_X->sz_ElementSize != cpm_Matrix->sz_ElementSize         ||
+	cpv_Y->sz_ElementSize != cpm_Matrix->sz_ElementSize         ||
+	cpv_X->sz_ElementCount != cpm_Matrix->sz_Height             ||
+	cpv_Y->sz_ElementCount != cpm_Matrix->sz_Width              ||
+	mtxoverlap(cpm_Matrix->p_StorageBuffer, cpm_Matrix->sz_BufferSize, cpv_X->p_StorageBuffer, cpv_X->sz_BufferSize) ||
+	mtxoverlap(cpm_Matrix->p_StorageBuffer, cpm_Matrix->sz_BufferSize, cpv_Y->p_StorageBuffer, cpv_Y->sz_BufferSize)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+	return 0;
+}
+
+int vctouter(matrix_t* pm_Result, const vector_t* cpv_X, const vector_t* cpv_Y) {
+	if (pm_Result == NULL || cpv_X == NULL || cpv_Y == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Result) != 0) {
+		return -1;
+	}
+
+	if (rankcheck(pm_Result, cpv_X, cpv_Y) != 0) {
+		return -1;
+	}
+
+	return rankupdate(pm_Result, NULL, cpv_X, cpv_Y);
+}
+
+int mtxger(matrix_t* pm_Matrix, const void* cp_Alpha, const vector_t* cpv_X, const vector_t* cpv_Y) {
+	if (pm_Matrix == NULL || cp_Alpha == NULL || cpv_X == NULL || cpv_Y == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Matrix) != 0) {
+		return -1;
+	}
+
+	if (rankcheck(pm_Matrix, cpv_X, cpv_Y) != 0) {
+		return -1;
+	}
+
+	return rankupdate(pm_Matrix, cp_Alpha, cpv_X, cpv_Y);
+}
+
+int mtxsyrk(matrix_t* pm_Matrix, const int cs32_Triangle, const void* cp_Alpha, const matrix_t* cpm_Samples) {
+	if (pm_Matrix == NULL || cp_Alpha == NULL || cpm_Samples == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxunique(pm_Matrix) != 0) {
+		return -1;
+	}
+
+	if (cs32_Triangle != MATRIX_TRIANGLE_UPPER && cs32_Triangle != MATRIX_TRIANGLE_LOWER) {
+		printf("UNKNOWN TRIANGLE!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(pm_Matrix) != 0                                   ||
+	mtxmemchk(cpm_Samples) != 0                                     ||
+	cpm_Samples->s32_Type != pm_Matrix->s32_Type                    ||
+	cpm_Samples->sz_ElementSize != pm_Matrix->sz_ElementSize        ||
+	pm_Matrix->sz_Height != cpm_Samples->sz_Height                  ||
+	pm_Matrix->sz_Width != cpm_Samples->sz_Height                   ||
+	mtxoverlap(pm_Matrix->p_StorageBuffer, pm_Matrix->sz_BufferSize, cpm_Samples->p_StorageBuffer, cpm_Samples->sz_BufferSize)) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_N = cpm_Samples->sz_Height;
+	const size_t csz_K = cpm_Samples->sz_Width;
+
+	if (ranknative(pm_Matrix->s32_Type, pm_Matrix->sz_ElementSize)) {
+		// The update is symmetric, so a row-major C is updated as its column-major transpose with the other triangle
+		const int cs32_Lower = (cs32_Triangle == MATRIX_TRIANGLE_LOWER) != MATRIX_IS_ROW_MAJOR(pm_Matrix);
+		const int cs32_TransX = MATRIX_IS_ROW_MAJOR(cpm_Samples) ? GEMM_TRANSPOSE : GEMM_NORMAL;
+
+		if (pm_Matrix->s32_Type == TYPE_FP32) {
+			return syrkFP32((float*)pm_Matrix->p_StorageBuffer, MATRIX_LEADING_DIM(pm_Matrix), cs32_Lower, csz_N, csz_K, *(const float*)cp_Alpha,
+				(const float*)cpm_Samples->p_StorageBuffer, cs32_TransX, MATRIX_LEADING_DIM(cpm_Samples), pm_Matrix->pfn_Allocate, pm_Matrix->pfn_Free);
+		}
+		return syrkFP64((double*)pm_Matrix->p_StorageBuffer, MATRIX_LEADING_DIM(pm_Matrix), cs32_Lower, csz_N, csz_K, *(const double*)cp_Alpha,
+			(const double*)cpm_Samples->p_StorageBuffer, cs32_TransX, MATRIX_LEADING_DIM(cpm_Samples), pm_Matrix->pfn_Allocate, pm_Matrix->pfn_Free);
+	}
+
+	if (pm_Matrix->pfn_ElementAdd == NULL || pm_Matrix->pfn_ElementMultiply == NULL) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_Size = pm_Matrix->sz_ElementSize;
+	uint8_t* pu8_Scratch = (uint8_t*)pm_Matrix->pfn_Allocate(2 * csz_Size);
+	if (!CHECK_ALLOCATION(pu8_Scratch)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	uint8_t* pu8_Factor = pu8_Scratch;
+	uint8_t* pu8_Product = pu8_Scratch + csz_Size;
+
+	const uint8_t* cpu8_X = (const uint8_t*)cpm_Samples->p_StorageBuffer;
+	uint8_t* pu8_C = (uint8_t*)pm_Matrix->p_StorageBuffer;
+	const size_t csz_RowX = MATRIX_ROW_STRIDE(cpm_Samples) * csz_Size, csz_ColX = MATRIX_COL_STRIDE(cpm_Samples) * csz_Size;
+	const size_t csz_RowC = MATRIX_ROW_STRIDE(pm_Matrix) * csz_Size, csz_ColC = MATRIX_COL_STRIDE(pm_Matrix) * csz_Size;
+
+	// One sample at a time: C(i, j) += x_i * (alpha * x_j) over the chosen triangle
+	for (size_t sz_P = 0; sz_P < csz_K; ++sz_P) {
+		for (size_t sz_J = 0; sz_J < csz_N; ++sz_J) {
+			const size_t csz_Begin = (cs32_Triangle == MATRIX_TRIANGLE_LOWER) ? sz_J : 0;
+			const size_t csz_End = (cs32_Triangle == MATRIX_TRIANGLE_LOWER) ? csz_N : sz_J + 1;
+
+			pm_Matrix->pfn_ElementMultiply(pu8_Factor, cp_Alpha, cpu8_X + sz_J * csz_RowX + sz_P * csz_ColX);
+			for (size_t sz_I = csz_Begin; sz_I < csz_End; ++sz_I) {
+				uint8_t* pu8_Out = pu8_C + sz_I * csz_RowC + sz_J * csz_ColC;
+				pm_Matrix->pfn_ElementMultiply(pu8_Product, cpu8_X + sz_I * csz_RowX + sz_P * csz_ColX, pu8_Factor);
+				pm_Matrix->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Product);
+			}
+		}
+	}
+
+	pm_Matrix->pfn_Free(pu8_Scratch);
+	return 0;
+}
@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/search.h"
+#include "internal.h"
+
+// Queries scored together against each corpus tile; the tile is reused from cache by every query in the block
+#define KNN_QUERY_BLOCK 	16
+// Corpus columns scored per tile before the results are folded into the top-k heaps
+#define KNN_CORPUS_BLOCK	128
+// Independent partial sums per dot product so the inner loop can be vectorized without reassociation
+#define KNN_LANES       	8
+
+/**
+ * KNN_KERNEL_DEF - Generates the type-specific scoring, heap and search routines.
+ *
+ * Each query keeps a min-heap of its csz_K best scores, so a corpus column only touches the heap
+ * when it beats the worst neighbour found so far.  L2 distances are negated while searching so every
+ * metric is maximized, and restored before being reported.
+ *
+ * Each block of queries is packed contiguously first.  A column-major corpus is scored one column at a
+ * time with dot products; a row-major corpus is scored one row at a time, accumulating a whole row of the
+ * tile per query, so in both layouts the corpus is only ever read along contiguous memory.
+ */
+#define KNN_KERNEL_DEF(type, abbr, fn_Sqrt) \
+static type knndot##abbr(const type* cp_A, const type* cp_B, const size_t csz_Length) { \
+	type a_Lanes[KNN_LANES] = {0}; \
+	size_t sz_Idx = 0; \
+	\
+	for (; sz_Idx + KNN_LANES <= csz_Length; sz_Idx += KNN_LANES) { \
+		for (size_t sz_Lane = 0; sz_Lane < KNN_LANES; ++sz_Lane) { \
+			a_Lanes[sz_Lane] += cp_A[sz_Idx + sz_Lane] * cp_B[sz_Idx + sz_Lane]; \
+		} \
+	} \
+	\
+	type t_Sum = 0; \
+	for (size_t sz_Lane = 0; sz_Lane < KNN_LANES; ++sz_Lane) { \
+		t_Sum += a_Lanes[sz_Lane]; \
+	} \
+	for (; sz_Idx < csz_Length; ++sz_Idx) { \
+		t_Sum += cp_A[sz_Idx] * cp_B[sz_Idx]; \
+	} \
+	return t_Sum; \
+} \
+\
+static void knnsiftdown##abbr(type* p_Scores, size_t* psz_Indices, const size_t csz_Count, size_t sz_Root) { \
+	for (;;) { \
+		size_t sz_Smallest = sz_Root; \
+		size_t sz_Left = 2 * sz_Root + 1; \
+		size_t sz_Right = sz_Left + 1; \
+		\
+		if (sz_Left < csz_Count && p_Scores[sz_Left] < p_Scores[sz_Smallest]) { \
+			sz_Smallest = sz_Left; \
+		} \
+		if (sz_Right < csz_Count && p_Scores[sz_Right] < p_Scores[sz_Smallest]) { \
+			sz_Smallest = sz_Right; \
+		} \
+		if (sz_Smallest == sz_Root) { \
+			return; \
+		} \
+		\
+		type t_Score = p_Scores[sz_Root]; \
+		p_Scores[sz_Root] = p_Scores[sz_Smallest]; \
+		p_Scores[sz_Smallest] = t_Score; \
+		\
+		size_t sz_Index = psz_Indices[sz_Root]; \
+		psz_Indices[sz_Root] = psz_Indices[sz_Smallest]; \
+		psz_Indices[sz_Smallest] = sz_Index; \
+		\
+		sz_Root = sz_Smallest; \
+	} \
+} \
+\
+static void knnoffer##abbr(type* p_Scores, size_t* psz_Indices, size_t* psz_Filled, const size_t csz_K, const type ct_Score, const size_t csz_Index) { \
+	if (*psz_Filled < csz_K) { \
+		size_t sz_Child = (*psz_Filled)++; \
+		\
+		while (sz_Child > 0) { \
+			size_t sz_Parent = (sz_Child - 1) / 2; \
+			if (!(ct_Score < p_Scores[sz_Parent])) { \
+				break; \
+			} \
+			p_Scores[sz_Child] = p_Scores[sz_Parent]; \
+			psz_Indices[sz_Child] = psz_Indices[sz_Parent]; \
+			sz_Child = sz_Parent; \
+		} \
+		p_Scores[sz_Child] = ct_Score; \
+		psz_Indices[sz_Child] = csz_Index; \
+		return; \
+	} \
+	\
+	if (ct_Score > p_Scores[0]) { \
+		p_Scores[0] = ct_Score; \
+		psz_Indices[0] = csz_Index; \
+		knnsiftdown##abbr(p_Scores, psz_Indices, csz_K, 0); \
+	} \
+} \
+\
+static int knnsearch##abbr(size_t* psz_Indices, type* p_Scores, const matrix_t* cpm_Corpus, const matrix_t* cpm_Queries, const size_t csz_K, const int cs32_Metric) { \
+	const size_t csz_Dim = cpm_Corpus->sz_Height; \
+	const type* cp_Corpus = (const type*)cpm_Corpus->p_StorageBuffer; \
+	const type* cp_Queries = (const type*)cpm_Queries->p_StorageBuffer; \
+	const size_t csz_CorpusRowStride = MATRIX_ROW_STRIDE(cpm_Corpus); \
+	const size_t csz_CorpusColStride = MATRIX_COL_STRIDE(cpm_Corpus); \
+	const size_t csz_QueryRowStride = MATRIX_ROW_STRIDE(cpm_Queries); \
+	const size_t csz_QueryColStride = MATRIX_COL_STRIDE(cpm_Queries); \
+	\
+	type* p_Tile = (type*)cpm_Corpus->pfn_Allocate(sizeof(type) * KNN_QUERY_BLOCK * (KNN_CORPUS_BLOCK + csz_Dim)); \
+	if (!CHECK_ALLOCATION(p_Tile)) { \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	type* p_Packed = p_Tile + KNN_QUERY_BLOCK * KNN_CORPUS_BLOCK; \
+	type* p_Heap = (type*)cpm_Corpus->pfn_Allocate(sizeof(type) * KNN_QUERY_BLOCK * csz_K); \
+	if (!CHECK_ALLOCATION(p_Heap)) { \
+		cpm_Corpus->pfn_Free(p_Tile); \
+		printf("MEMORY NOT FOUND!\n"); \
+		return -1; \
+	} \
+	\
+	/* Corpus norms are computed once per call: L2 needs squared norms, COSINE needs plain norms */ \
+	type* p_Norms = NULL; \
+	if (cs32_Metric != KNN_METRIC_DOT) { \
+		p_Norms = (type*)cpm_Corpus->pfn_Allocate(sizeof(type) * cpm_Corpus->sz_Width); \
+		if (!CHECK_ALLOCATION(p_Norms)) { \
+			cpm_Corpus->pfn_Free(p_Heap); \
+			cpm_Corpus->pfn_Free(p_Tile); \
+			printf("MEMORY NOT FOUND!\n"); \
+			return -1; \
+		} \
+		if (MATRIX_IS_ROW_MAJOR(cpm_Corpus)) { \
+			memset(p_Norms, 0, sizeof(type) * cpm_Corpus->sz_Width); \
+			for (size_t sz_Row = 0; sz_Row < csz_Dim; ++sz_Row) { \
+				const type* cp_Row = cp_Corpus + sz_Row * csz_CorpusRowStride; \
+				for (size_t sz_Col = 0; sz_Col < cpm_Corpus->sz_Width; ++sz_Col) { \
+					p_Norms[sz_Col] += cp_Row[sz_Col] * cp_Row[sz_Col]; \
+				} \
+			} \
+		} else { \
+			for (size_t sz_Col = 0; sz_Col < cpm_Corpus->sz_Width; ++sz_Col) { \
+				const type* cp_Column = cp_Corpus + sz_Col * csz_CorpusColStride; \
+				p_Norms[sz_Col] = knndot##abbr(cp_Column, cp_Column, csz_Dim); \
+			} \
+		} \
+		for (size_t sz_Col = 0; cs32_Metric == KNN_METRIC_COSINE && sz_Col < cpm_Corpus->sz_Width; ++sz_Col) { \
+			p_Norms[sz_Col] = fn_Sqrt(p_Norms[sz_Col]); \
+		} \
+	} \
+	\
+	for (size_t sz_Query0 = 0; sz_Query0 < cpm_Queries->sz_Width; sz_Query0 += KNN_QUERY_BLOCK) { \
+		const size_t csz_QueryCount = (cpm_Queries->sz_Width - sz_Query0 < KNN_QUERY_BLOCK) ? cpm_Queries->sz_Width - sz_Query0 : KNN_QUERY_BLOCK; \
+		size_t a_Filled[KNN_QUERY_BLOCK] = {0}; \
+		type a_QueryNorms[KNN_QUERY_BLOCK] = {0}; \
+		\
+		/* Packing walks the queries along whichever dimension their layout stores contiguously */ \
+		if (MATRIX_IS_ROW_MAJOR(cpm_Queries)) { \
+			for (size_t sz_Row = 0; sz_Row < csz_Dim; ++sz_Row) { \
+				const type* cp_Row = cp_Queries + sz_Row * csz_QueryRowStride + sz_Query0; \
+				for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+					p_Packed[sz_Q * csz_Dim + sz_Row] = cp_Row[sz_Q]; \
+				} \
+			} \
+		} else { \
+			for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+				memcpy(p_Packed + sz_Q * csz_Dim, cp_Queries + (sz_Query0 + sz_Q) * csz_QueryColStride, sizeof(type) * csz_Dim); \
+			} \
+		} \
+		\
+		if (cs32_Metric != KNN_METRIC_DOT) { \
+			for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+				const type* cp_Query = p_Packed + sz_Q * csz_Dim; \
+				a_QueryNorms[sz_Q] = knndot##abbr(cp_Query, cp_Query, csz_Dim); \
+				if (cs32_Metric == KNN_METRIC_COSINE) { \
+					a_QueryNorms[sz_Q] = fn_Sqrt(a_QueryNorms[sz_Q]); \
+				} \
+			} \
+		} \
+		\
+		for (size_t sz_Col0 = 0; sz_Col0 < cpm_Corpus->sz_Width; sz_Col0 += KNN_CORPUS_BLOCK) { \
+			const size_t csz_ColCount = (cpm_Corpus->sz_Width - sz_Col0 < KNN_CORPUS_BLOCK) ? cpm_Corpus->sz_Width - sz_Col0 : KNN_CORPUS_BLOCK; \
+			\
+			/* Each corpus element is read from memory once and reused from cache by every query in the block */ \
+			if (MATRIX_IS_ROW_MAJOR(cpm_Corpus)) { \
+				memset(p_Tile, 0, sizeof(type) * KNN_QUERY_BLOCK * KNN_CORPUS_BLOCK); \
+				for (size_t sz_Row = 0; sz_Row < csz_Dim; ++sz_Row) { \
+					const type* cp_Row = cp_Corpus + sz_Row * csz_CorpusRowStride + sz_Col0; \
+					for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+						const type ct_Coordinate = p_Packed[sz_Q * csz_Dim + sz_Row]; \
+						type* p_TileRow = p_Tile + sz_Q * KNN_CORPUS_BLOCK; \
+						for (size_t sz_C = 0; sz_C < csz_ColCount; ++sz_C) { \
+							p_TileRow[sz_C] += ct_Coordinate * cp_Row[sz_C]; \
+						} \
+					} \
+				} \
+			} else { \
+				for (size_t sz_C = 0; sz_C < csz_ColCount; ++sz_C) { \
+					const type* cp_Column = cp_Corpus + (sz_Col0 + sz_C) * csz_CorpusColStride; \
+					for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+						p_Tile[sz_Q * KNN_CORPUS_BLOCK + sz_C] = knndot##abbr(p_Packed + sz_Q * csz_Dim, cp_Column, csz_Dim); \
+					} \
+				} \
+			} \
+			\
+			for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+				type* p_QueryHeap = p_Heap + sz_Q * csz_K; \
+				size_t* psz_QueryIndices = psz_Indices + (sz_Query0 + sz_Q) * csz_K; \
+				\
+				for (size_t sz_C = 0; sz_C < csz_ColCount; ++sz_C) { \
+					type t_Score = p_Tile[sz_Q * KNN_CORPUS_BLOCK + sz_C]; \
+					\
+					if (cs32_Metric == KNN_METRIC_COSINE) { \
+						type t_Denominator = a_QueryNorms[sz_Q] * p_Norms[sz_Col0 + sz_C]; \
+						t_Score = (t_Denominator != 0) ? t_Score / t_Denominator : 0; \
+					} else if (cs32_Metric == KNN_METRIC_L2) { \
+						t_Score = 2 * t_Score - a_QueryNorms[sz_Q] - p_Norms[sz_Col0 + sz_C]; \
+					} \
+					\
+					knnoffer##abbr(p_QueryHeap, psz_QueryIndices, &a_Filled[sz_Q], csz_K, t_Score, sz_Col0 + sz_C); \
+				} \
+			} \
+		} \
+		\
+		/* Heap sort each min-heap in place, which leaves the best neighbour first */ \
+		for (size_t sz_Q = 0; sz_Q < csz_QueryCount; ++sz_Q) { \
+			type* p_QueryHeap = p_Heap + sz_Q * csz_K; \
+			size_t* psz_QueryIndices = psz_Indices + (sz_Query0 + sz_Q) * csz_K; \
+			\
+			for (size_t sz_End = csz_K - 1; sz_End > 0; --sz_End) { \
+				type t_Score = p_QueryHeap[0]; \
+				p_QueryHeap[0] = p_QueryHeap[sz_End]; \
+				p_QueryHeap[sz_End] = t_Score; \
+				\
+				size_t sz_Index = psz_QueryIndices[0]; \
+				psz_QueryIndices[0] = psz_QueryIndices[sz_End]; \
+				psz_QueryIndices[sz_End] = sz_Index; \
+				\
+				knnsiftdown##abbr(p_QueryHeap, psz_QueryIndices, sz_End, 0); \
+			} \
+			\
+			if (p_Scores != NULL) { \
+				type* p_QueryScores = p_Scores + (sz_Query0 + sz_Q) * csz_K; \
+				for (size_t sz_Idx = 0; sz_Idx < csz_K; ++sz_Idx) { \
+					/* Rounding can leave tiny negative squared distances for identical vectors */ \
+					p_QueryScores[sz_Idx] = (cs32_Metric == KNN_METRIC_L2) ? ((p_QueryHeap[sz_Idx] < 0) ? -p_QueryHeap[sz_Idx] : 0) : p_QueryHeap[sz_Idx]; \
+				} \
+			} \
+		} \
+	} \
+	\
+	if (p_Norms != NULL) { \
+		cpm_Corpus->pfn_Free(p_Norms); \
+	} \
+	cpm_Corpus->pfn_Free(p_Heap); \
+	cpm_Corpus->pfn_Free(p_Tile); \
+	\
+	return 0; \
+}
+
+KNN_KERNEL_DEF(float, FP32, sqrtf)
+KNN_KERNEL_DEF(double, FP64, sqrt)
+
+int mtxknn(size_t* psz_Indices, void* p_Scores, const matrix_t* cpm_Corpus, const matrix_t* cpm_Queries, const size_t csz_K, const int cs32_Metric) {
+	if (psz_Indices == NULL || cpm_Corpus == NULL || cpm_Queries == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(cpm_Corpus) != 0                      ||
+	mtxmemchk(cpm_Queries) != 0                         ||
+	cpm_Corpus->s32_Type != cpm_Queries->s32_Type       ||
+	cpm_Corpus->sz_Height != cpm_Queries->sz_Height     ||
+	csz_K == 0                                          ||
+	csz_K > cpm_Corpus->sz_Width) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (cs32_Metric != KNN_METRIC_DOT       &&
+	cs32_Metric != KNN_METRIC_COSINE        &&
+	cs32_Metric != KNN_METRIC_L2) {
+		printf("UNKNOWN METRIC!\n");
+		return -1;
+	}
+
+	switch (cpm_Corpus->s32_Type) {
+		case TYPE_FP32:
+			return knnsearchFP32(psz_Indices, (float*)p_Scores, cpm_Corpus, cpm_Queries, csz_K, cs32_Metric);
+		case TYPE_FP64:
+			return knnsearchFP64(psz_Indices, (double*)p_Scores, cpm_Corpus, cpm_Queries, csz_K, cs32_Metric);
+		default:
+			printf("TYPE NOT SUPPORTED!\n");
+			return -1;
+	}
+}
+
+int mtxknnvct(size_t* psz_Indices, void* p_Scores, const matrix_t* cpm_Corpus, const vector_t* cpv_Query, const size_t csz_K, const int cs32_Metric) {
+	if (cpv_Query == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(cpv_Query) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	// View the query as a one-column matrix; the buffer is borrowed, not copied
+	matrix_t m_Query;
+	mtxcolumnview(&m_Query, cpv_Query);
+
+	return mtxknn(psz_Indices, p_Scores, cpm_Corpus, &m_Query, csz_K, cs32_Metric);
+}
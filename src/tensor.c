@@ -0,0 +1,1416 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/vector.h"
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "lin99/tensor.h"
+#include "internal.h"
+
+// Elements handled per vectorised step of the native element-wise kernels
+#define TENSOR_LANES        	16
+// Elements worth handing to one thread in element-wise operations
+#define TENSOR_PARALLEL_WORK	65536
+// Multiply-adds worth handing to one thread in batched products
+#define TENSOR_PRODUCT_WORK 	(1 << 20)
+
+// Operation selectors for the element-wise engine
+#define TENSOR_OP_COPY	0
+#define TENSOR_OP_ADD 	1
+#define TENSOR_OP_SUB 	2
+#define TENSOR_OP_MUL 	3
+#define TENSOR_OP_DIV 	4
+
+// Elements spanned by the strides, one more than the offset of the last element; -1 on overflow
+static int tnsextent(const tensor_t* cpt_Tensor, size_t* psz_Extent) {
+	size_t sz_Extent = 1;
+
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Tensor->sz_Rank; ++sz_Axis) {
+		const size_t csz_Stride = cpt_Tensor->a_Strides[sz_Axis];
+		if (csz_Stride != 0 && cpt_Tensor->a_Shape[sz_Axis] - 1 > (SIZE_MAX - sz_Extent) / csz_Stride) {
+			return -1;
+		}
+		sz_Extent += (cpt_Tensor->a_Shape[sz_Axis] - 1) * csz_Stride;
+	}
+
+	*psz_Extent = sz_Extent;
+	return 0;
+}
+
+// Validates the rank and shape, filling in packed row-major strides when none were given
+static int tnsgeometry(tensor_t* pt_Tensor) {
+	size_t sz_Count = 1;
+	int s32_Strided = 0;
+
+	if (pt_Tensor->sz_Rank > TENSOR_MAX_RANK) {
+		printf("RANK EXCEEDS TENSOR_MAX_RANK!\n");
+		return -1;
+	}
+
+	for (size_t sz_Axis = 0; sz_Axis < pt_Tensor->sz_Rank; ++sz_Axis) {
+		if (pt_Tensor->a_Shape[sz_Axis] == 0) {
+			printf("TENSOR AXIS HAS NO EXTENT!\n");
+			return -1;
+		}
+		if (sz_Count > SIZE_MAX / pt_Tensor->a_Shape[sz_Axis]) {
+			printf("MULTIPLICATION OVERFLOW WHEN CALCULATING ELEMENT COUNT\n");
+			return -1;
+		}
+		sz_Count *= pt_Tensor->a_Shape[sz_Axis];
+		s32_Strided |= (pt_Tensor->a_Strides[sz_Axis] != 0);
+	}
+	pt_Tensor->sz_ElementCount = sz_Count;
+
+	if (!s32_Strided) {
+		size_t sz_Stride = 1;
+		for (size_t sz_Axis = pt_Tensor->sz_Rank; sz_Axis-- > 0;) {
+			pt_Tensor->a_Strides[sz_Axis] = sz_Stride;
+			sz_Stride *= pt_Tensor->a_Shape[sz_Axis];
+		}
+	}
+
+	size_t sz_Extent;
+	if (tnsextent(pt_Tensor, &sz_Extent) != 0 || sz_Extent > SIZE_MAX / pt_Tensor->sz_ElementSize) {
+		printf("MULTIPLICATION OVERFLOW WHEN CALCULATING BUFFER SIZE\n");
+		return -1;
+	}
+
+	pt_Tensor->sz_BufferSize = sz_Extent * pt_Tensor->sz_ElementSize;
+	return 0;
+}
+
+// Non-zero when the tensor is packed in row-major order; axes of extent 1 may carry any stride
+static int tnscontiguous(const tensor_t* cpt_Tensor) {
+	size_t sz_Expected = 1;
+
+	for (size_t sz_Axis = cpt_Tensor->sz_Rank; sz_Axis-- > 0;) {
+		if (cpt_Tensor->a_Shape[sz_Axis] == 1) {
+			continue;
+		}
+		if (cpt_Tensor->a_Strides[sz_Axis] != sz_Expected) {
+			return 0;
+		}
+		sz_Expected *= cpt_Tensor->a_Shape[sz_Axis];
+	}
+	return 1;
+}
+
+int tnscreate(tensor_t* pt_Tensor, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*)) {
+	if (pt_Tensor == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (pt_Tensor->sz_ElementSize == 0) {
+		return -1;
+	}
+
+	// Callbacks passed in win over callbacks already set on the struct, which win over calloc/free
+	pt_Tensor->pfn_Allocate = (pfn_AllocateMemory != NULL) ? pfn_AllocateMemory : ((pt_Tensor->pfn_Allocate != NULL) ? pt_Tensor->pfn_Allocate : zalloc);
+	pt_Tensor->pfn_Free = (pfn_FreeMemory != NULL) ? pfn_FreeMemory : ((pt_Tensor->pfn_Free != NULL) ? pt_Tensor->pfn_Free : free);
+
+	if (tnsgeometry(pt_Tensor) != 0) {
+		return -1;
+	}
+
+	pt_Tensor->s32_Borrowed = 0;
+	pt_Tensor->psz_References = NULL;
+	pt_Tensor->p_StorageBuffer = pt_Tensor->pfn_Allocate(pt_Tensor->sz_BufferSize);
+
+	if (!CHECK_ALLOCATION(pt_Tensor->p_StorageBuffer)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int tnswrap(tensor_t* pt_Tensor, void* p_Buffer, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*)) {
+	if (pt_Tensor == NULL || p_Buffer == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (pt_Tensor->sz_ElementSize == 0) {
+		return -1;
+	}
+
+	pt_Tensor->pfn_Allocate = (pfn_AllocateMemory != NULL) ? pfn_AllocateMemory : zalloc;
+	pt_Tensor->pfn_Free = (pfn_FreeMemory != NULL) ? pfn_FreeMemory : free;
+
+	if (tnsgeometry(pt_Tensor) != 0) {
+		return -1;
+	}
+
+	pt_Tensor->p_StorageBuffer = p_Buffer;
+	pt_Tensor->s32_Borrowed = 1;
+	pt_Tensor->psz_References = NULL;
+	return 0;
+}
+
+int tnsclone(tensor_t* pt_Clone, tensor_t* pt_Source) {
+	if (pt_Clone == NULL || pt_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (tnsmemchk(pt_Source) != 0) {
+		printf("TENSOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (pt_Clone == pt_Source) {
+		return 0;
+	}
+
+	if (pt_Source->s32_Borrowed) {
+		void* p_Copy = pt_Source->pfn_Allocate(pt_Source->sz_BufferSize);
+		if (!CHECK_ALLOCATION(p_Copy)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+		memcpy(p_Copy, pt_Source->p_StorageBuffer, pt_Source->sz_BufferSize);
+
+		*pt_Clone = *pt_Source;
+		pt_Clone->p_StorageBuffer = p_Copy;
+		pt_Clone->s32_Borrowed = 0;
+		pt_Clone->psz_References = NULL;
+		return 0;
+	}
+
+	if (bufshare(&pt_Source->psz_References, pt_Source->pfn_Allocate) != 0) {
+		return -1;
+	}
+
+	*pt_Clone = *pt_Source;
+	return 0;
+}
+
+int tnsunique(tensor_t* pt_Tensor) {
+	if (pt_Tensor == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	return bufunique(&pt_Tensor->p_StorageBuffer, &pt_Tensor->psz_References, pt_Tensor->sz_BufferSize, 1, pt_Tensor->pfn_Allocate, pt_Tensor->pfn_Free);
+}
+
+int tnsmemchk(const tensor_t* cpt_Tensor) {
+	size_t sz_Count = 1;
+	size_t sz_Extent;
+
+	if (cpt_Tensor->sz_Rank > TENSOR_MAX_RANK) {
+		return -1;
+	}
+
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Tensor->sz_Rank; ++sz_Axis) {
+		if (cpt_Tensor->a_Shape[sz_Axis] == 0 || sz_Count > SIZE_MAX / cpt_Tensor->a_Shape[sz_Axis]) {
+			return -1;
+		}
+		sz_Count *= cpt_Tensor->a_Shape[sz_Axis];
+	}
+
+	if (cpt_Tensor->p_StorageBuffer != NULL     &&
+	cpt_Tensor->sz_ElementSize != 0             &&
+	cpt_Tensor->sz_ElementCount == sz_Count     &&
+	cpt_Tensor->sz_BufferSize != 0              &&
+	cpt_Tensor->s32_Type != TYPE_NULL           &&
+	cpt_Tensor->pfn_Allocate != NULL            &&
+	cpt_Tensor->pfn_Free != NULL                &&
+	tnsextent(cpt_Tensor, &sz_Extent) == 0      &&
+	cpt_Tensor->sz_BufferSize / cpt_Tensor->sz_ElementSize >= sz_Extent) {
+		return 0;
+	}
+
+	return -1;
+}
+
+// Element offset of an index, or -1 when it falls outside the shape
+static int tnsoffset(size_t* psz_Offset, const tensor_t* cpt_Tensor, const size_t* csz_Index) {
+	size_t sz_Offset = 0;
+
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Tensor->sz_Rank; ++sz_Axis) {
+		if (csz_Index[sz_Axis] >= cpt_Tensor->a_Shape[sz_Axis]) {
+			printf("INDEX EXCEEDED TENSOR DIMENSIONS!\n");
+			return -1;
+		}
+		sz_Offset += csz_Index[sz_Axis] * cpt_Tensor->a_Strides[sz_Axis];
+	}
+
+	*psz_Offset = sz_Offset;
+	return 0;
+}
+
+void tnsread(void* p_Destination, const tensor_t* cpt_Tensor, const size_t* csz_Index) {
+	size_t sz_Offset;
+
+	if (p_Destination == NULL || cpt_Tensor == NULL || (csz_Index == NULL && cpt_Tensor->sz_Rank != 0)) {
+		printf("NULL REFERENCE PASSED!\n");
+		return;
+	}
+
+	if (tnsoffset(&sz_Offset, cpt_Tensor, csz_Index) != 0) {
+		return;
+	}
+
+	memcpy(p_Destination, (const uint8_t*)cpt_Tensor->p_StorageBuffer + sz_Offset * cpt_Tensor->sz_ElementSize, cpt_Tensor->sz_ElementSize);
+	return;
+}
+
+void tnswrite(tensor_t* pt_Tensor, const size_t* csz_Index, void* p_Data) {
+	size_t sz_Offset;
+
+	if (pt_Tensor == NULL || p_Data == NULL || (csz_Index == NULL && pt_Tensor->sz_Rank != 0)) {
+		printf("NULL REFERENCE PASSED!\n");
+		return;
+	}
+
+	if (tnsoffset(&sz_Offset, pt_Tensor, csz_Index) != 0 || tnsunique(pt_Tensor) != 0) {
+		return;
+	}
+
+	memcpy((uint8_t*)pt_Tensor->p_StorageBuffer + sz_Offset * pt_Tensor->sz_ElementSize, p_Data, pt_Tensor->sz_ElementSize);
+	return;
+}
+
+int tnsvctview(tensor_t* pt_View, const vector_t* cpv_Vector) {
+	if (pt_View == NULL || cpv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(cpv_Vector) != 0) {
+		printf("VECTORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	memset(pt_View, 0, sizeof(*pt_View));
+	pt_View->s32_Type            = cpv_Vector->s32_Type;
+	pt_View->p_StorageBuffer     = cpv_Vector->p_StorageBuffer;
+	pt_View->sz_BufferSize       = cpv_Vector->sz_BufferSize;
+	pt_View->sz_ElementSize      = cpv_Vector->sz_ElementSize;
+	pt_View->sz_ElementCount     = cpv_Vector->sz_ElementCount;
+	pt_View->sz_Rank             = 1;
+	pt_View->a_Shape[0]          = cpv_Vector->sz_ElementCount;
+	pt_View->a_Strides[0]        = 1;
+	pt_View->s32_Borrowed        = 1;
+	pt_View->pfn_ElementAdd      = cpv_Vector->pfn_ElementAdd;
+	pt_View->pfn_ElementSubtract = cpv_Vector->pfn_ElementSubtract;
+	pt_View->pfn_ElementMultiply = cpv_Vector->pfn_ElementMultiply;
+	pt_View->pfn_ElementDivide   = cpv_Vector->pfn_ElementDivide;
+	pt_View->pfn_Allocate        = cpv_Vector->pfn_Allocate;
+	pt_View->pfn_Free            = cpv_Vector->pfn_Free;
+	return 0;
+}
+
+int tnsmtxview(tensor_t* pt_View, const matrix_t* cpm_Matrix) {
+	if (pt_View == NULL || cpm_Matrix == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (mtxmemchk(cpm_Matrix) != 0) {
+		printf("MATRICES NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	memset(pt_View, 0, sizeof(*pt_View));
+	pt_View->s32_Type            = cpm_Matrix->s32_Type;
+	pt_View->p_StorageBuffer     = cpm_Matrix->p_StorageBuffer;
+	pt_View->sz_BufferSize       = cpm_Matrix->sz_BufferSize;
+	pt_View->sz_ElementSize      = cpm_Matrix->sz_ElementSize;
+	pt_View->sz_ElementCount     = cpm_Matrix->sz_ElementCount;
+	pt_View->sz_Rank             = 2;
+	pt_View->a_Shape[0]          = cpm_Matrix->sz_Height;
+	pt_View->a_Shape[1]          = cpm_Matrix->sz_Width;
+	pt_View->a_Strides[0]        = MATRIX_ROW_STRIDE(cpm_Matrix);
+	pt_View->a_Strides[1]        = MATRIX_COL_STRIDE(cpm_Matrix);
+	pt_View->s32_Borrowed        = 1;
+	pt_View->pfn_ElementAdd      = cpm_Matrix->pfn_ElementAdd;
+	pt_View->pfn_ElementSubtract = cpm_Matrix->pfn_ElementSubtract;
+	pt_View->pfn_ElementMultiply = cpm_Matrix->pfn_ElementMultiply;
+	pt_View->pfn_ElementDivide   = cpm_Matrix->pfn_ElementDivide;
+	pt_View->pfn_Allocate        = cpm_Matrix->pfn_Allocate;
+	pt_View->pfn_Free            = cpm_Matrix->pfn_Free;
+	return 0;
+}
+
+// Checks the source of a view; the view itself is built in a local copy so source and view may be the same struct
+static int tnsviewsource(const tensor_t* cpt_View, const tensor_t* cpt_Source) {
+	if (cpt_View == NULL || cpt_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (tnsmemchk(cpt_Source) != 0) {
+		printf("TENSOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+	return 0;
+}
+
+int tnsbroadcast(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Rank, const size_t* csz_Shape) {
+	if (tnsviewsource(pt_View, cpt_Source) != 0) {
+		return -1;
+	}
+
+	if (csz_Rank > TENSOR_MAX_RANK || csz_Rank < cpt_Source->sz_Rank || (csz_Shape == NULL && csz_Rank != 0)) {
+		printf("TENSOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	tensor_t s_View = *cpt_Source;
+	const size_t csz_Lead = csz_Rank - cpt_Source->sz_Rank;
+	size_t sz_Count = 1;
+
+	for (size_t sz_Axis = 0; sz_Axis < csz_Rank; ++sz_Axis) {
+		const size_t csz_Own = (sz_Axis < csz_Lead) ? 1 : cpt_Source->a_Shape[sz_Axis - csz_Lead];
+
+		if (csz_Shape[sz_Axis] == 0 || (csz_Own != 1 && csz_Own != csz_Shape[sz_Axis]) || sz_Count > SIZE_MAX / csz_Shape[sz_Axis]) {
+			printf("TENSOR NOT COMPATIBLE!\n");
+			return -1;
+		}
+
+		s_View.a_Shape[sz_Axis] = csz_Shape[sz_Axis];
+		s_View.a_Strides[sz_Axis] = (csz_Own == 1) ? 0 : cpt_Source->a_Strides[sz_Axis - csz_Lead];
+		sz_Count *= csz_Shape[sz_Axis];
+	}
+
+	s_View.sz_Rank = csz_Rank;
+	s_View.sz_ElementCount = sz_Count;
+	s_View.s32_Borrowed = 1;
+	s_View.psz_References = NULL;
+	*pt_View = s_View;
+	return 0;
+}
+
+int tnspermute(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t* csz_Axes) {
+	if (tnsviewsource(pt_View, cpt_Source) != 0) {
+		return -1;
+	}
+
+	if (csz_Axes == NULL && cpt_Source->sz_Rank != 0) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	tensor_t s_View = *cpt_Source;
+	int a_Seen[TENSOR_MAX_RANK] = { 0 };
+
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Source->sz_Rank; ++sz_Axis) {
+		if (csz_Axes[sz_Axis] >= cpt_Source->sz_Rank || a_Seen[csz_Axes[sz_Axis]]) {
+			printf("AXES ARE NOT A PERMUTATION!\n");
+			return -1;
+		}
+		a_Seen[csz_Axes[sz_Axis]] = 1;
+		s_View.a_Shape[sz_Axis] = cpt_Source->a_Shape[csz_Axes[sz_Axis]];
+		s_View.a_Strides[sz_Axis] = cpt_Source->a_Strides[csz_Axes[sz_Axis]];
+	}
+
+	s_View.s32_Borrowed = 1;
+	s_View.psz_References = NULL;
+	*pt_View = s_View;
+	return 0;
+}
+
+int tnsslice(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Axis, const size_t csz_Begin, const size_t csz_Count) {
+	if (tnsviewsource(pt_View, cpt_Source) != 0) {
+		return -1;
+	}
+
+	if (csz_Axis >= cpt_Source->sz_Rank ||
+	csz_Count == 0 ||
+	csz_Begin > cpt_Source->a_Shape[csz_Axis] ||
+	csz_Count > cpt_Source->a_Shape[csz_Axis] - csz_Begin) {
+		printf("INDEX EXCEEDED TENSOR DIMENSIONS!\n");
+		return -1;
+	}
+
+	tensor_t s_View = *cpt_Source;
+	const size_t csz_Skip = csz_Begin * cpt_Source->a_Strides[csz_Axis] * cpt_Source->sz_ElementSize;
+
+	s_View.p_StorageBuffer = (uint8_t*)cpt_Source->p_StorageBuffer + csz_Skip;
+	s_View.sz_BufferSize = cpt_Source->sz_BufferSize - csz_Skip;
+	s_View.sz_ElementCount = cpt_Source->sz_ElementCount / cpt_Source->a_Shape[csz_Axis] * csz_Count;
+	s_View.a_Shape[csz_Axis] = csz_Count;
+	s_View.s32_Borrowed = 1;
+	s_View.psz_References = NULL;
+	*pt_View = s_View;
+	return 0;
+}
+
+int tnsreshape(tensor_t* pt_View, const tensor_t* cpt_Source, const size_t csz_Rank, const size_t* csz_Shape) {
+	if (tnsviewsource(pt_View, cpt_Source) != 0) {
+		return -1;
+	}
+
+	if (!tnscontiguous(cpt_Source)) {
+		printf("TENSOR NOT CONTIGUOUS!\n");
+		return -1;
+	}
+
+	if (csz_Rank > TENSOR_MAX_RANK || (csz_Shape == NULL && csz_Rank != 0)) {
+		printf("TENSOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	tensor_t s_View = *cpt_Source;
+	size_t sz_Count = 1;
+
+	s_View.sz_Rank = csz_Rank;
+	for (size_t sz_Axis = 0; sz_Axis < csz_Rank; ++sz_Axis) {
+		if (csz_Shape[sz_Axis] == 0 || sz_Count > SIZE_MAX / csz_Shape[sz_Axis]) {
+			printf("TENSOR NOT COMPATIBLE!\n");
+			return -1;
+		}
+		s_View.a_Shape[sz_Axis] = csz_Shape[sz_Axis];
+		sz_Count *= csz_Shape[sz_Axis];
+	}
+
+	if (sz_Count != cpt_Source->sz_ElementCount) {
+		printf("TENSOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	size_t sz_Stride = 1;
+	for (size_t sz_Axis = csz_Rank; sz_Axis-- > 0;) {
+		s_View.a_Strides[sz_Axis] = sz_Stride;
+		sz_Stride *= csz_Shape[sz_Axis];
+	}
+
+	s_View.s32_Borrowed = 1;
+	s_View.psz_References = NULL;
+	*pt_View = s_View;
+	return 0;
+}
+
+/**
+ * tnsseek/tnsstep - Row-major walk over a set of axes, tracking the element offset of up to three tensors.
+ *
+ * tnsseek positions the walk on its csz_Position-th index and tnsstep advances it by one, carrying into
+ * outer axes as an odometer does, so consecutive positions cost no division.
+ */
+static void tnsseek(size_t* pa_Index, size_t* pa_Offset, const size_t csz_Rank, const size_t* cpa_Shape, const size_t (*cpa_Strides)[TENSOR_MAX_RANK], size_t sz_Position) {
+	pa_Offset[0] = pa_Offset[1] = pa_Offset[2] = 0;
+
+	for (size_t sz_Axis = csz_Rank; sz_Axis-- > 0;) {
+		pa_Index[sz_Axis] = sz_Position % cpa_Shape[sz_Axis];
+		sz_Position /= cpa_Shape[sz_Axis];
+		for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+			pa_Offset[sz_Tensor] += pa_Index[sz_Axis] * cpa_Strides[sz_Tensor][sz_Axis];
+		}
+	}
+	return;
+}
+
+static void tnsstep(size_t* pa_Index, size_t* pa_Offset, const size_t csz_Rank, const size_t* cpa_Shape, const size_t (*cpa_Strides)[TENSOR_MAX_RANK]) {
+	for (size_t sz_Axis = csz_Rank; sz_Axis-- > 0;) {
+		for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+			pa_Offset[sz_Tensor] += cpa_Strides[sz_Tensor][sz_Axis];
+		}
+		if (++pa_Index[sz_Axis] < cpa_Shape[sz_Axis]) {
+			return;
+		}
+		for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+			pa_Offset[sz_Tensor] -= cpa_Shape[sz_Axis] * cpa_Strides[sz_Tensor][sz_Axis];
+		}
+		pa_Index[sz_Axis] = 0;
+	}
+	return;
+}
+
+/**
+ * tnsloop_t - An element-wise operation over a result and up to two operands, with its loops ordered and fused.
+ *
+ * Members:
+ * - sz_Rank: Number of loops, at least 1; the last one is innermost.
+ * - a_Shape: Trip count of each loop.
+ * - a_Strides: Element strides of the result, A and B along each loop, 0 where an operand is broadcast.
+ * - pu8_R/cpu8_A/cpu8_B: First element of each tensor.
+ * - sz_Rows: Number of runs of the innermost loop, the product of every other trip count.
+ * - sz_ElementSize: Element size shared by the tensors.
+ * - pfn_Element: Callback applied by the generic kernel.
+ * - pfn_Inner: Kernel running the innermost loop once.
+ */
+typedef struct __tnsloop_t {
+	size_t sz_Rank;
+	size_t a_Shape[TENSOR_MAX_RANK];
+	size_t a_Strides[3][TENSOR_MAX_RANK];
+	uint8_t* pu8_R;
+	const uint8_t* cpu8_A;
+	const uint8_t* cpu8_B;
+	size_t sz_Rows;
+	size_t sz_ElementSize;
+	void (*pfn_Element)(void*, const void*, const void*);
+	void (*pfn_Inner)(const struct __tnsloop_t*, uint8_t*, const uint8_t*, const uint8_t*);
+} tnsloop_t;
+
+/**
+ * TENSOR_KERNEL_DEF - Generates the innermost loop of one native element-wise operation.
+ *
+ * Unit-stride runs, including those with one broadcast operand, are staged through local arrays
+ * TENSOR_LANES elements at a time, which keeps in-place updates well defined and lets the compiler
+ * vectorise without alias checks.  Everything else runs as a plain strided loop.
+ */
+#define TENSOR_KERNEL_DEF(type, abbr, name, op) \
+static void tnsinner##name##abbr(const tnsloop_t* cp_Loop, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) { \
+	const size_t csz_Inner = cp_Loop->sz_Rank - 1; \
+	const size_t csz_Count = cp_Loop->a_Shape[csz_Inner]; \
+	const size_t csz_StrideR = cp_Loop->a_Strides[0][csz_Inner]; \
+	const size_t csz_StrideA = cp_Loop->a_Strides[1][csz_Inner]; \
+	const size_t csz_StrideB = cp_Loop->a_Strides[2][csz_Inner]; \
+	type* p_R = (type*)pu8_R; \
+	const type* cp_A = (const type*)cpu8_A; \
+	const type* cp_B = (const type*)cpu8_B; \
+	size_t sz_Idx = 0; \
+	\
+	if (csz_StrideR == 1 && csz_StrideA == 1 && csz_StrideB == 1) { \
+		for (; sz_Idx + TENSOR_LANES <= csz_Count; sz_Idx += TENSOR_LANES) { \
+			type a_A[TENSOR_LANES]; \
+			type a_B[TENSOR_LANES]; \
+			memcpy(a_A, cp_A + sz_Idx, sizeof(a_A)); \
+			memcpy(a_B, cp_B + sz_Idx, sizeof(a_B)); \
+			for (size_t sz_Lane = 0; sz_Lane < TENSOR_LANES; ++sz_Lane) { \
+				a_A[sz_Lane] = a_A[sz_Lane] op a_B[sz_Lane]; \
+			} \
+			memcpy(p_R + sz_Idx, a_A, sizeof(a_A)); \
+		} \
+	} else if (csz_StrideR == 1 && csz_StrideA == 1 && csz_StrideB == 0) { \
+		const type ct_B = *cp_B; \
+		for (; sz_Idx + TENSOR_LANES <= csz_Count; sz_Idx += TENSOR_LANES) { \
+			type a_A[TENSOR_LANES]; \
+			memcpy(a_A, cp_A + sz_Idx, sizeof(a_A)); \
+			for (size_t sz_Lane = 0; sz_Lane < TENSOR_LANES; ++sz_Lane) { \
+				a_A[sz_Lane] = a_A[sz_Lane] op ct_B; \
+			} \
+			memcpy(p_R + sz_Idx, a_A, sizeof(a_A)); \
+		} \
+	} else if (csz_StrideR == 1 && csz_StrideA == 0 && csz_StrideB == 1) { \
+		const type ct_A = *cp_A; \
+		for (; sz_Idx + TENSOR_LANES <= csz_Count; sz_Idx += TENSOR_LANES) { \
+			type a_B[TENSOR_LANES]; \
+			memcpy(a_B, cp_B + sz_Idx, sizeof(a_B)); \
+			for (size_t sz_Lane = 0; sz_Lane < TENSOR_LANES; ++sz_Lane) { \
+				a_B[sz_Lane] = ct_A op a_B[sz_Lane]; \
+			} \
+			memcpy(p_R + sz_Idx, a_B, sizeof(a_B)); \
+		} \
+	} \
+	\
+	for (; sz_Idx < csz_Count; ++sz_Idx) { \
+		p_R[sz_Idx * csz_StrideR] = cp_A[sz_Idx * csz_StrideA] op cp_B[sz_Idx * csz_StrideB]; \
+	} \
+	return; \
+}
+
+#define TENSOR_OP_SET_DEF(type, abbr) \
+TENSOR_KERNEL_DEF(type, abbr, add, +) \
+TENSOR_KERNEL_DEF(type, abbr, sub, -) \
+TENSOR_KERNEL_DEF(type, abbr, mul, *) \
+TENSOR_KERNEL_DEF(type, abbr, div, /)
+
+TENSOR_OP_SET_DEF(float, FP32)
+TENSOR_OP_SET_DEF(double, FP64)
+
+// Native kernels indexed by [FP32/FP64][operation - TENSOR_OP_ADD]
+static void (*const a_Kernels[2][4])(const tnsloop_t*, uint8_t*, const uint8_t*, const uint8_t*) = {
+	{ tnsinneraddFP32, tnsinnersubFP32, tnsinnermulFP32, tnsinnerdivFP32 },
+	{ tnsinneraddFP64, tnsinnersubFP64, tnsinnermulFP64, tnsinnerdivFP64 }
+};
+
+// Copy of one run for an element width, broadcasting the source when its stride is 0
+#define TENSOR_COPY_DEF(type, abbr) \
+static void tnsinnercopy##abbr(const tnsloop_t* cp_Loop, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) { \
+	const size_t csz_Inner = cp_Loop->sz_Rank - 1; \
+	const size_t csz_Count = cp_Loop->a_Shape[csz_Inner]; \
+	const size_t csz_StrideR = cp_Loop->a_Strides[0][csz_Inner]; \
+	const size_t csz_StrideA = cp_Loop->a_Strides[1][csz_Inner]; \
+	type* p_R = (type*)pu8_R; \
+	const type* cp_A = (const type*)cpu8_A; \
+	(void)cpu8_B; \
+	\
+	if (csz_StrideR == 1 && csz_StrideA == 1) { \
+		memcpy(p_R, cp_A, csz_Count * sizeof(type)); \
+		return; \
+	} \
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) { \
+		p_R[sz_Idx * csz_StrideR] = cp_A[sz_Idx * csz_StrideA]; \
+	} \
+	return; \
+}
+
+TENSOR_COPY_DEF(uint8_t, U8)
+TENSOR_COPY_DEF(uint16_t, U16)
+TENSOR_COPY_DEF(uint32_t, U32)
+TENSOR_COPY_DEF(uint64_t, U64)
+
+// Copy of one run for element sizes without a native width
+static void tnsinnercopybytes(const tnsloop_t* cp_Loop, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) {
+	const size_t csz_Inner = cp_Loop->sz_Rank - 1;
+	const size_t csz_Size = cp_Loop->sz_ElementSize;
+	const size_t csz_StrideR = cp_Loop->a_Strides[0][csz_Inner] * csz_Size;
+	const size_t csz_StrideA = cp_Loop->a_Strides[1][csz_Inner] * csz_Size;
+	(void)cpu8_B;
+
+	for (size_t sz_Idx = 0; sz_Idx < cp_Loop->a_Shape[csz_Inner]; ++sz_Idx) {
+		memcpy(pu8_R + sz_Idx * csz_StrideR, cpu8_A + sz_Idx * csz_StrideA, csz_Size);
+	}
+	return;
+}
+
+// One run through the element callback, for types without native kernels
+static void tnsinnercallback(const tnsloop_t* cp_Loop, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) {
+	const size_t csz_Inner = cp_Loop->sz_Rank - 1;
+	const size_t csz_Size = cp_Loop->sz_ElementSize;
+	const size_t csz_StrideR = cp_Loop->a_Strides[0][csz_Inner] * csz_Size;
+	const size_t csz_StrideA = cp_Loop->a_Strides[1][csz_Inner] * csz_Size;
+	const size_t csz_StrideB = cp_Loop->a_Strides[2][csz_Inner] * csz_Size;
+
+	for (size_t sz_Idx = 0; sz_Idx < cp_Loop->a_Shape[csz_Inner]; ++sz_Idx) {
+		cp_Loop->pfn_Element(pu8_R + sz_Idx * csz_StrideR, cpu8_A + sz_Idx * csz_StrideA, cpu8_B + sz_Idx * csz_StrideB);
+	}
+	return;
+}
+
+static void tnsrows(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const tnsloop_t* cp_Loop = (const tnsloop_t*)p_Context;
+	const size_t csz_Size = cp_Loop->sz_ElementSize;
+	const size_t csz_Outer = cp_Loop->sz_Rank - 1;
+	size_t a_Index[TENSOR_MAX_RANK];
+	size_t a_Offset[3];
+	(void)sz_Chunk;
+
+	tnsseek(a_Index, a_Offset, csz_Outer, cp_Loop->a_Shape, (const size_t (*)[TENSOR_MAX_RANK])cp_Loop->a_Strides, sz_Begin);
+	for (size_t sz_Row = sz_Begin; sz_Row < sz_End; ++sz_Row) {
+		cp_Loop->pfn_Inner(cp_Loop, cp_Loop->pu8_R + a_Offset[0] * csz_Size, cp_Loop->cpu8_A + a_Offset[1] * csz_Size, cp_Loop->cpu8_B + a_Offset[2] * csz_Size);
+		tnsstep(a_Index, a_Offset, csz_Outer, cp_Loop->a_Shape, (const size_t (*)[TENSOR_MAX_RANK])cp_Loop->a_Strides);
+	}
+	return;
+}
+
+// Stride of an operand along axis csz_Axis of the result, 0 where it is broadcast; -1 when the shapes do not broadcast
+static int tnsalign(size_t* psz_Stride, const tensor_t* cpt_Operand, const tensor_t* cpt_Result, const size_t csz_Axis) {
+	if (csz_Axis + cpt_Operand->sz_Rank < cpt_Result->sz_Rank) {
+		*psz_Stride = 0;
+		return 0;
+	}
+
+	const size_t csz_Own = csz_Axis + cpt_Operand->sz_Rank - cpt_Result->sz_Rank;
+	if (cpt_Operand->a_Shape[csz_Own] == cpt_Result->a_Shape[csz_Axis]) {
+		*psz_Stride = (cpt_Operand->a_Shape[csz_Own] == 1) ? 0 : cpt_Operand->a_Strides[csz_Own];
+		return 0;
+	}
+	if (cpt_Operand->a_Shape[csz_Own] == 1) {
+		*psz_Stride = 0;
+		return 0;
+	}
+	return -1;
+}
+
+// Non-zero when axis csz_I of the loop should run outside axis csz_J: larger result stride first, operand strides breaking ties
+static int tnsouter(const tnsloop_t* cp_Loop, const size_t csz_I, const size_t csz_J) {
+	for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+		if (cp_Loop->a_Strides[sz_Tensor][csz_I] != cp_Loop->a_Strides[sz_Tensor][csz_J]) {
+			return cp_Loop->a_Strides[sz_Tensor][csz_I] > cp_Loop->a_Strides[sz_Tensor][csz_J];
+		}
+	}
+	return 0;
+}
+
+/**
+ * tnsloop - Plan an element-wise operation over every element of cpt_Result.
+ *
+ * Operand axes are aligned at the last axis, with stride 0 along broadcast axes.  Axes of extent 1 are dropped, the
+ * rest are sorted so the result's smallest stride is innermost, and neighbouring loops that are contiguous in every
+ * tensor are fused.  cpt_B may be NULL for copies.  Returns -1 when the operand shapes do not broadcast to the result.
+ */
+static int tnsloop(tnsloop_t* pt_Loop, const tensor_t* cpt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B) {
+	memset(pt_Loop, 0, sizeof(*pt_Loop));
+	if (cpt_A->sz_Rank > cpt_Result->sz_Rank || (cpt_B != NULL && cpt_B->sz_Rank > cpt_Result->sz_Rank)) {
+		return -1;
+	}
+
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Result->sz_Rank; ++sz_Axis) {
+		size_t sz_StrideA;
+		size_t sz_StrideB = 0;
+
+		if (tnsalign(&sz_StrideA, cpt_A, cpt_Result, sz_Axis) != 0 ||
+		(cpt_B != NULL && tnsalign(&sz_StrideB, cpt_B, cpt_Result, sz_Axis) != 0)) {
+			return -1;
+		}
+		if (cpt_Result->a_Shape[sz_Axis] == 1) {
+			continue;
+		}
+
+		// Insertion sort, so the loops end up outermost first
+		size_t sz_Slot = pt_Loop->sz_Rank++;
+		pt_Loop->a_Shape[sz_Slot] = cpt_Result->a_Shape[sz_Axis];
+		pt_Loop->a_Strides[0][sz_Slot] = cpt_Result->a_Strides[sz_Axis];
+		pt_Loop->a_Strides[1][sz_Slot] = sz_StrideA;
+		pt_Loop->a_Strides[2][sz_Slot] = sz_StrideB;
+		for (; sz_Slot > 0 && tnsouter(pt_Loop, sz_Slot, sz_Slot - 1); --sz_Slot) {
+			const size_t csz_Shape = pt_Loop->a_Shape[sz_Slot];
+			pt_Loop->a_Shape[sz_Slot] = pt_Loop->a_Shape[sz_Slot - 1];
+			pt_Loop->a_Shape[sz_Slot - 1] = csz_Shape;
+			for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+				const size_t csz_Stride = pt_Loop->a_Strides[sz_Tensor][sz_Slot];
+				pt_Loop->a_Strides[sz_Tensor][sz_Slot] = pt_Loop->a_Strides[sz_Tensor][sz_Slot - 1];
+				pt_Loop->a_Strides[sz_Tensor][sz_Slot - 1] = csz_Stride;
+			}
+		}
+	}
+
+	// Fuse each loop into the one outside it when stepping the outer loop is the same as running off the end of the inner one
+	size_t sz_Fused = 0;
+	for (size_t sz_Axis = 0; sz_Axis < pt_Loop->sz_Rank; ++sz_Axis) {
+		int s32_Contiguous = (sz_Fused != 0);
+		for (size_t sz_Tensor = 0; sz_Tensor < 3 && s32_Contiguous; ++sz_Tensor) {
+			s32_Contiguous = pt_Loop->a_Strides[sz_Tensor][sz_Fused - 1] == pt_Loop->a_Strides[sz_Tensor][sz_Axis] * pt_Loop->a_Shape[sz_Axis];
+		}
+
+		const size_t csz_Slot = s32_Contiguous ? sz_Fused - 1 : sz_Fused++;
+		pt_Loop->a_Shape[csz_Slot] = s32_Contiguous ? pt_Loop->a_Shape[csz_Slot] * pt_Loop->a_Shape[sz_Axis] : pt_Loop->a_Shape[sz_Axis];
+		for (size_t sz_Tensor = 0; sz_Tensor < 3; ++sz_Tensor) {
+			pt_Loop->a_Strides[sz_Tensor][csz_Slot] = pt_Loop->a_Strides[sz_Tensor][sz_Axis];
+		}
+	}
+
+	// A single element still runs one loop of one iteration
+	if (sz_Fused == 0) {
+		pt_Loop->a_Shape[0] = 1;
+		sz_Fused = 1;
+	}
+	pt_Loop->sz_Rank = sz_Fused;
+
+	pt_Loop->sz_Rows = 1;
+	for (size_t sz_Axis = 0; sz_Axis + 1 < pt_Loop->sz_Rank; ++sz_Axis) {
+		pt_Loop->sz_Rows *= pt_Loop->a_Shape[sz_Axis];
+	}
+
+	pt_Loop->pu8_R = (uint8_t*)cpt_Result->p_StorageBuffer;
+	pt_Loop->cpu8_A = (const uint8_t*)cpt_A->p_StorageBuffer;
+	pt_Loop->cpu8_B = (const uint8_t*)((cpt_B != NULL) ? cpt_B->p_StorageBuffer : cpt_A->p_StorageBuffer);
+	pt_Loop->sz_ElementSize = cpt_Result->sz_ElementSize;
+	return 0;
+}
+
+static int tnsrun(tnsloop_t* pt_Loop) {
+	const size_t csz_Inner = pt_Loop->a_Shape[pt_Loop->sz_Rank - 1];
+	return parfor(pt_Loop->sz_Rows, (TENSOR_PARALLEL_WORK + csz_Inner - 1) / csz_Inner, tnsrows, pt_Loop);
+}
+
+// Results must reach every element through its own address, which rules out broadcast views
+static int tnswritable(const tensor_t* cpt_Tensor) {
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Tensor->sz_Rank; ++sz_Axis) {
+		if (cpt_Tensor->a_Shape[sz_Axis] != 1 && cpt_Tensor->a_Strides[sz_Axis] == 0) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+// Element-wise results may share storage with an operand only by being exactly that operand
+static int tnsdisjoint(const tensor_t* cpt_Result, const tensor_t* cpt_Operand) {
+	if (!mtxoverlap(cpt_Result->p_StorageBuffer, cpt_Result->sz_BufferSize, cpt_Operand->p_StorageBuffer, cpt_Operand->sz_BufferSize)) {
+		return 0;
+	}
+
+	if (cpt_Result->p_StorageBuffer != cpt_Operand->p_StorageBuffer || cpt_Result->sz_Rank != cpt_Operand->sz_Rank) {
+		return -1;
+	}
+	for (size_t sz_Axis = 0; sz_Axis < cpt_Result->sz_Rank; ++sz_Axis) {
+		if (cpt_Result->a_Shape[sz_Axis] != cpt_Operand->a_Shape[sz_Axis] ||
+		(cpt_Result->a_Shape[sz_Axis] != 1 && cpt_Result->a_Strides[sz_Axis] != cpt_Operand->a_Strides[sz_Axis])) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+int tnscopy(tensor_t* pt_Result, const tensor_t* cpt_Source) {
+	tnsloop_t s_Loop;
+
+	if (pt_Result == NULL || cpt_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (tnsunique(pt_Result) != 0) {
+		return -1;
+	}
+
+	if (tnsmemchk(pt_Result) != 0                              ||
+	tnsmemchk(cpt_Source) != 0                                 ||
+	pt_Result->sz_ElementSize != cpt_Source->sz_ElementSize    ||
+	tnswritable(pt_Result) != 0                                ||
+	tnsdisjoint(pt_Result, cpt_Source) != 0                    ||
+	tnsloop(&s_Loop, pt_Result, cpt_Source, NULL) != 0) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	// Copying a tensor onto itself
+	if (pt_Result->p_StorageBuffer == cpt_Source->p_StorageBuffer) {
+		return 0;
+	}
+
+	switch (pt_Result->sz_ElementSize) {
+		case sizeof(uint8_t):
+			s_Loop.pfn_Inner = tnsinnercopyU8;
+			break;
+		case sizeof(uint16_t):
+			s_Loop.pfn_Inner = tnsinnercopyU16;
+			break;
+		case sizeof(uint32_t):
+			s_Loop.pfn_Inner = tnsinnercopyU32;
+			break;
+		case sizeof(uint64_t):
+			s_Loop.pfn_Inner = tnsinnercopyU64;
+			break;
+		default:
+			s_Loop.pfn_Inner = tnsinnercopybytes;
+			break;
+	}
+	return tnsrun(&s_Loop);
+}
+
+static int tnselementwise(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B, const int cs32_Op) {
+	tnsloop_t s_Loop;
+
+	if (pt_Result == NULL || cpt_A == NULL || cpt_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	// A result cloned from an operand gets its own buffer first, so the two no longer count as overlapping
+	if (tnsunique(pt_Result) != 0) {
+		return -1;
+	}
+
+	if (tnsmemchk(pt_Result) != 0                           ||
+	tnsmemchk(cpt_A) != 0                                   ||
+	tnsmemchk(cpt_B) != 0                                   ||
+	cpt_A->s32_Type != cpt_B->s32_Type                      ||
+	pt_Result->s32_Type != cpt_A->s32_Type                  ||
+	cpt_A->sz_ElementSize != cpt_B->sz_ElementSize          ||
+	pt_Result->sz_ElementSize != cpt_A->sz_ElementSize      ||
+	tnswritable(pt_Result) != 0                             ||
+	tnsdisjoint(pt_Result, cpt_A) != 0                      ||
+	tnsdisjoint(pt_Result, cpt_B) != 0                      ||
+	tnsloop(&s_Loop, pt_Result, cpt_A, cpt_B) != 0) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (cpt_A->s32_Type == TYPE_FP32 && cpt_A->sz_ElementSize == sizeof(float)) {
+		s_Loop.pfn_Inner = a_Kernels[0][cs32_Op - TENSOR_OP_ADD];
+		return tnsrun(&s_Loop);
+	}
+	if (cpt_A->s32_Type == TYPE_FP64 && cpt_A->sz_ElementSize == sizeof(double)) {
+		s_Loop.pfn_Inner = a_Kernels[1][cs32_Op - TENSOR_OP_ADD];
+		return tnsrun(&s_Loop);
+	}
+
+	switch (cs32_Op) {
+		case TENSOR_OP_ADD:
+			s_Loop.pfn_Element = cpt_A->pfn_ElementAdd;
+			break;
+		case TENSOR_OP_SUB:
+			s_Loop.pfn_Element = cpt_A->pfn_ElementSubtract;
+			break;
+		case TENSOR_OP_MUL:
+			s_Loop.pfn_Element = cpt_A->pfn_ElementMultiply;
+			break;
+		default:
+			s_Loop.pfn_Element = cpt_A->pfn_ElementDivide;
+			break;
+	}
+
+	if (s_Loop.pfn_Element == NULL) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	s_Loop.pfn_Inner = tnsinnercallback;
+	return tnsrun(&s_Loop);
+}
+
+#define TENSOR_ELEMENTWISE_OP_DEF(fn_Name, s32_Op) \
+int fn_Name(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B) { \
+	return tnselementwise(pt_Result, cpt_A, cpt_B, s32_Op); \
+}
+
+TENSOR_ELEMENTWISE_OP_DEF(tnsadd, TENSOR_OP_ADD)
+TENSOR_ELEMENTWISE_OP_DEF(tnssub, TENSOR_OP_SUB)
+TENSOR_ELEMENTWISE_OP_DEF(tnselemul, TENSOR_OP_MUL)
+TENSOR_ELEMENTWISE_OP_DEF(tnselediv, TENSOR_OP_DIV)
+
+/**
+ * tnsproduct_t - A batch of matrix products R = A * B, each read in place through element strides.
+ *
+ * Members:
+ * - sz_M/sz_N/sz_K: Every product is (sz_M x sz_K) * (sz_K x sz_N).
+ * - sz_RowA/sz_ColA, sz_RowB/sz_ColB, sz_RowR/sz_ColR: Element strides between rows and between columns of each matrix.
+ * - sz_BatchRank/a_BatchShape/a_BatchStrides: Batch axes, with the strides of R, A and B along them (0 where broadcast).
+ * - sz_Batches: Number of products, the product of the batch extents.
+ * - pu8_R/cpu8_A/cpu8_B: First element of each tensor.
+ * - s32_PackA/s32_PackB/s32_PackR: Set for a matrix that has no GEMM layout and goes through packed column-major scratch.
+ * - s32_TransA/sz_LdA, s32_TransB/sz_LdB: GEMM form of each operand, or of its packed copy.
+ * - s32_TransR/sz_LdR: GEMM_NORMAL when R is stored like a column-major matrix, GEMM_TRANSPOSE when stored like a row-major one.
+ * - pu8_Scratch/sz_Scratch: Scratch memory, sz_Scratch bytes per chunk.
+ * - pfn_ElementAdd/pfn_ElementMultiply: Callbacks used when there is no native kernel.
+ * - pfn_Kernel: Computes one product.
+ */
+typedef struct __tnsproduct_t {
+	size_t sz_M;
+	size_t sz_N;
+	size_t sz_K;
+	size_t sz_RowA;
+	size_t sz_ColA;
+	size_t sz_RowB;
+	size_t sz_ColB;
+	size_t sz_RowR;
+	size_t sz_ColR;
+
+	size_t sz_BatchRank;
+	size_t a_BatchShape[TENSOR_MAX_RANK];
+	size_t a_BatchStrides[3][TENSOR_MAX_RANK];
+	size_t sz_Batches;
+
+	uint8_t* pu8_R;
+	const uint8_t* cpu8_A;
+	const uint8_t* cpu8_B;
+	size_t sz_ElementSize;
+
+	int s32_PackA;
+	int s32_PackB;
+	int s32_PackR;
+	int s32_TransA;
+	int s32_TransB;
+	int s32_TransR;
+	size_t sz_LdA;
+	size_t sz_LdB;
+	size_t sz_LdR;
+
+	uint8_t* pu8_Scratch;
+	size_t sz_Scratch;
+
+	void (*pfn_ElementAdd)(void*, const void*, const void*);
+	void (*pfn_ElementMultiply)(void*, const void*, const void*);
+	void (*pfn_Kernel)(const struct __tnsproduct_t*, uint8_t*, uint8_t*, const uint8_t*, const uint8_t*);
+} tnsproduct_t;
+
+// GEMM form of a rows x cols matrix with the given element strides; -1 when neither orientation is unit-stride
+static int tnsgemmform(const size_t csz_Rows, const size_t csz_RowStride, const size_t csz_Cols, const size_t csz_ColStride, int* ps32_Trans, size_t* psz_Ld) {
+	if ((csz_Rows == 1 || csz_RowStride == 1) && (csz_Cols == 1 || csz_ColStride >= csz_Rows)) {
+		*ps32_Trans = GEMM_NORMAL;
+		*psz_Ld = (csz_Cols == 1) ? csz_Rows : csz_ColStride;
+		return 0;
+	}
+	if ((csz_Cols == 1 || csz_ColStride == 1) && (csz_Rows == 1 || csz_RowStride >= csz_Cols)) {
+		*ps32_Trans = GEMM_TRANSPOSE;
+		*psz_Ld = (csz_Rows == 1) ? csz_Cols : csz_RowStride;
+		return 0;
+	}
+	return -1;
+}
+
+/**
+ * TENSOR_PRODUCT_DEF - Generates the native kernel computing one product of a batch.
+ *
+ * A matrix stored with unit row stride is column-major and one with unit column stride is the column-major
+ * storage of its transpose, so either is handed to the GEMM in place with the matching transpose flag.  A
+ * row-major R is computed as R^T = op(B)^T op(A)^T, as in mtxproduct.  Matrices with neither unit stride are
+ * packed into scratch first (and R unpacked after).
+ */
+#define TENSOR_PRODUCT_DEF(type, abbr) \
+static void tnspack##abbr(type* p_Packed, const type* cp_Source, const size_t csz_Rows, const size_t csz_RowStride, const size_t csz_Cols, const size_t csz_ColStride) { \
+	for (size_t sz_Col = 0; sz_Col < csz_Cols; ++sz_Col) { \
+		for (size_t sz_Row = 0; sz_Row < csz_Rows; ++sz_Row) { \
+			p_Packed[sz_Row + sz_Col * csz_Rows] = cp_Source[sz_Row * csz_RowStride + sz_Col * csz_ColStride]; \
+		} \
+	} \
+	return; \
+} \
+\
+static void tnsunpack##abbr(type* p_Target, const size_t csz_RowStride, const size_t csz_ColStride, const type* cp_Packed, const size_t csz_Rows, const size_t csz_Cols) { \
+	for (size_t sz_Col = 0; sz_Col < csz_Cols; ++sz_Col) { \
+		for (size_t sz_Row = 0; sz_Row < csz_Rows; ++sz_Row) { \
+			p_Target[sz_Row * csz_RowStride + sz_Col * csz_ColStride] = cp_Packed[sz_Row + sz_Col * csz_Rows]; \
+		} \
+	} \
+	return; \
+} \
+\
+static void tnsgemm##abbr(const tnsproduct_t* cp_Product, uint8_t* pu8_Scratch, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) { \
+	const size_t csz_M = cp_Product->sz_M; \
+	const size_t csz_N = cp_Product->sz_N; \
+	const size_t csz_K = cp_Product->sz_K; \
+	const type* cp_A = (const type*)cpu8_A; \
+	const type* cp_B = (const type*)cpu8_B; \
+	type* p_Scratch = (type*)pu8_Scratch; \
+	\
+	if (cp_Product->s32_PackA) { \
+		tnspack##abbr(p_Scratch, cp_A, csz_M, cp_Product->sz_RowA, csz_K, cp_Product->sz_ColA); \
+		cp_A = p_Scratch; \
+		p_Scratch += csz_M * csz_K; \
+	} \
+	if (cp_Product->s32_PackB) { \
+		tnspack##abbr(p_Scratch, cp_B, csz_K, cp_Product->sz_RowB, csz_N, cp_Product->sz_ColB); \
+		cp_B = p_Scratch; \
+		p_Scratch += csz_K * csz_N; \
+	} \
+	\
+	type* p_C = cp_Product->s32_PackR ? p_Scratch : (type*)pu8_R; \
+	if (cp_Product->s32_TransR == GEMM_NORMAL) { \
+		gemm##abbr(cp_Product->s32_TransA, cp_Product->s32_TransB, csz_M, csz_N, csz_K, (type)1, cp_A, cp_Product->sz_LdA, \
+			cp_B, cp_Product->sz_LdB, (type)0, p_C, cp_Product->sz_LdR); \
+	} else { \
+		gemm##abbr((cp_Product->s32_TransB == GEMM_NORMAL) ? GEMM_TRANSPOSE : GEMM_NORMAL, (cp_Product->s32_TransA == GEMM_NORMAL) ? GEMM_TRANSPOSE : GEMM_NORMAL, \
+			csz_N, csz_M, csz_K, (type)1, cp_B, cp_Product->sz_LdB, cp_A, cp_Product->sz_LdA, (type)0, p_C, cp_Product->sz_LdR); \
+	} \
+	\
+	if (cp_Product->s32_PackR) { \
+		tnsunpack##abbr((type*)pu8_R, cp_Product->sz_RowR, cp_Product->sz_ColR, p_C, csz_M, csz_N); \
+	} \
+	return; \
+}
+
+TENSOR_PRODUCT_DEF(float, FP32)
+TENSOR_PRODUCT_DEF(double, FP64)
+
+// One product through the element callbacks, with the innermost loop along the smaller stride of R
+static void tnsgemmcallback(const tnsproduct_t* cp_Product, uint8_t* pu8_Scratch, uint8_t* pu8_R, const uint8_t* cpu8_A, const uint8_t* cpu8_B) {
+	const size_t csz_Size = cp_Product->sz_ElementSize;
+	const size_t csz_RowA = cp_Product->sz_RowA * csz_Size, csz_ColA = cp_Product->sz_ColA * csz_Size;
+	const size_t csz_RowB = cp_Product->sz_RowB * csz_Size, csz_ColB = cp_Product->sz_ColB * csz_Size;
+	const size_t csz_RowR = cp_Product->sz_RowR * csz_Size, csz_ColR = cp_Product->sz_ColR * csz_Size;
+
+	if (cp_Product->sz_RowR <= cp_Product->sz_ColR) {
+		for (size_t sz_J = 0; sz_J < cp_Product->sz_N; ++sz_J) {
+			for (size_t sz_P = 0; sz_P < cp_Product->sz_K; ++sz_P) {
+				const uint8_t* cpu8_Right = cpu8_B + sz_P * csz_RowB + sz_J * csz_ColB;
+				for (size_t sz_I = 0; sz_I < cp_Product->sz_M; ++sz_I) {
+					uint8_t* pu8_Out = pu8_R + sz_I * csz_RowR + sz_J * csz_ColR;
+					cp_Product->pfn_ElementMultiply((sz_P == 0) ? pu8_Out : pu8_Scratch, cpu8_A + sz_I * csz_RowA + sz_P * csz_ColA, cpu8_Right);
+					if (sz_P != 0) {
+						cp_Product->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Scratch);
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	for (size_t sz_I = 0; sz_I < cp_Product->sz_M; ++sz_I) {
+		for (size_t sz_P = 0; sz_P < cp_Product->sz_K; ++sz_P) {
+			const uint8_t* cpu8_Left = cpu8_A + sz_I * csz_RowA + sz_P * csz_ColA;
+			for (size_t sz_J = 0; sz_J < cp_Product->sz_N; ++sz_J) {
+				uint8_t* pu8_Out = pu8_R + sz_I * csz_RowR + sz_J * csz_ColR;
+				cp_Product->pfn_ElementMultiply((sz_P == 0) ? pu8_Out : pu8_Scratch, cpu8_Left, cpu8_B + sz_P * csz_RowB + sz_J * csz_ColB);
+				if (sz_P != 0) {
+					cp_Product->pfn_ElementAdd(pu8_Out, pu8_Out, pu8_Scratch);
+				}
+			}
+		}
+	}
+	return;
+}
+
+static void tnsbatches(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	const tnsproduct_t* cp_Product = (const tnsproduct_t*)p_Context;
+	const size_t csz_Size = cp_Product->sz_ElementSize;
+	uint8_t* pu8_Scratch = (cp_Product->pu8_Scratch != NULL) ? cp_Product->pu8_Scratch + sz_Chunk * cp_Product->sz_Scratch : NULL;
+	size_t a_Index[TENSOR_MAX_RANK];
+	size_t a_Offset[3];
+
+	tnsseek(a_Index, a_Offset, cp_Product->sz_BatchRank, cp_Product->a_BatchShape, (const size_t (*)[TENSOR_MAX_RANK])cp_Product->a_BatchStrides, sz_Begin);
+	for (size_t sz_Batch = sz_Begin; sz_Batch < sz_End; ++sz_Batch) {
+		cp_Product->pfn_Kernel(cp_Product, pu8_Scratch, cp_Product->pu8_R + a_Offset[0] * csz_Size,
+			cp_Product->cpu8_A + a_Offset[1] * csz_Size, cp_Product->cpu8_B + a_Offset[2] * csz_Size);
+		tnsstep(a_Index, a_Offset, cp_Product->sz_BatchRank, cp_Product->a_BatchShape, (const size_t (*)[TENSOR_MAX_RANK])cp_Product->a_BatchStrides);
+	}
+	return;
+}
+
+// Picks the kernel and GEMM forms, sizes the scratch and runs the batch, splitting it across threads when it is worth it
+static int tnsproduct(tnsproduct_t* pt_Product, const tensor_t* cpt_Result, const tensor_t* cpt_A) {
+	const size_t csz_Size = cpt_Result->sz_ElementSize;
+	size_t sz_Scratch = 0;
+
+	if (cpt_A->s32_Type == TYPE_FP32 || cpt_A->s32_Type == TYPE_FP64) {
+		pt_Product->pfn_Kernel = (cpt_A->s32_Type == TYPE_FP32) ? tnsgemmFP32 : tnsgemmFP64;
+
+		pt_Product->s32_PackA = tnsgemmform(pt_Product->sz_M, pt_Product->sz_RowA, pt_Product->sz_K, pt_Product->sz_ColA, &pt_Product->s32_TransA, &pt_Product->sz_LdA) != 0;
+		if (pt_Product->s32_PackA) {
+			pt_Product->s32_TransA = GEMM_NORMAL;
+			pt_Product->sz_LdA = pt_Product->sz_M;
+			sz_Scratch += pt_Product->sz_M * pt_Product->sz_K;
+		}
+
+		pt_Product->s32_PackB = tnsgemmform(pt_Product->sz_K, pt_Product->sz_RowB, pt_Product->sz_N, pt_Product->sz_ColB, &pt_Product->s32_TransB, &pt_Product->sz_LdB) != 0;
+		if (pt_Product->s32_PackB) {
+			pt_Product->s32_TransB = GEMM_NORMAL;
+			pt_Product->sz_LdB = pt_Product->sz_K;
+			sz_Scratch += pt_Product->sz_K * pt_Product->sz_N;
+		}
+
+		pt_Product->s32_PackR = tnsgemmform(pt_Product->sz_M, pt_Product->sz_RowR, pt_Product->sz_N, pt_Product->sz_ColR, &pt_Product->s32_TransR, &pt_Product->sz_LdR) != 0;
+		if (pt_Product->s32_PackR) {
+			pt_Product->s32_TransR = GEMM_NORMAL;
+			pt_Product->sz_LdR = pt_Product->sz_M;
+			sz_Scratch += pt_Product->sz_M * pt_Product->sz_N;
+		}
+	} else {
+		if (cpt_A->pfn_ElementAdd == NULL || cpt_A->pfn_ElementMultiply == NULL) {
+			printf("TENSORS NOT COMPATIBLE!\n");
+			return -1;
+		}
+		pt_Product->pfn_ElementAdd = cpt_A->pfn_ElementAdd;
+		pt_Product->pfn_ElementMultiply = cpt_A->pfn_ElementMultiply;
+		pt_Product->pfn_Kernel = tnsgemmcallback;
+		sz_Scratch = 1;
+	}
+	pt_Product->sz_ElementSize = csz_Size;
+	pt_Product->sz_Scratch = sz_Scratch * csz_Size;
+
+	// A single large product is left to the GEMM, which splits it across threads itself
+	const size_t csz_Work = pt_Product->sz_M * pt_Product->sz_K;
+	const size_t csz_Grain = (csz_Work > TENSOR_PRODUCT_WORK / pt_Product->sz_N) ? 1 : TENSOR_PRODUCT_WORK / (csz_Work * pt_Product->sz_N);
+	const size_t csz_Chunks = parchunks(pt_Product->sz_Batches, csz_Grain);
+
+	pt_Product->pu8_Scratch = NULL;
+	if (pt_Product->sz_Scratch != 0) {
+		if (pt_Product->sz_Scratch > SIZE_MAX / csz_Chunks) {
+			printf("MULTIPLICATION OVERFLOW WHEN CALCULATING BUFFER SIZE\n");
+			return -1;
+		}
+		pt_Product->pu8_Scratch = (uint8_t*)cpt_Result->pfn_Allocate(csz_Chunks * pt_Product->sz_Scratch);
+		if (!CHECK_ALLOCATION(pt_Product->pu8_Scratch)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+	}
+
+	const int cs32_Status = parfor(pt_Product->sz_Batches, csz_Grain, tnsbatches, pt_Product);
+	if (pt_Product->pu8_Scratch != NULL) {
+		cpt_Result->pfn_Free(pt_Product->pu8_Scratch);
+	}
+	return cs32_Status;
+}
+
+// Validation shared by the products; the operand shapes are checked by the callers
+static int tnsproductcheck(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B) {
+	if (pt_Result == NULL || cpt_A == NULL || cpt_B == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (tnsunique(pt_Result) != 0) {
+		return -1;
+	}
+
+	if (tnsmemchk(pt_Result) != 0                           ||
+	tnsmemchk(cpt_A) != 0                                   ||
+	tnsmemchk(cpt_B) != 0                                   ||
+	cpt_A->s32_Type != cpt_B->s32_Type                      ||
+	pt_Result->s32_Type != cpt_A->s32_Type                  ||
+	cpt_A->sz_ElementSize != cpt_B->sz_ElementSize          ||
+	pt_Result->sz_ElementSize != cpt_A->sz_ElementSize      ||
+	((cpt_A->s32_Type == TYPE_FP32 && cpt_A->sz_ElementSize != sizeof(float)) || (cpt_A->s32_Type == TYPE_FP64 && cpt_A->sz_ElementSize != sizeof(double))) ||
+	tnswritable(pt_Result) != 0                             ||
+	mtxoverlap(pt_Result->p_StorageBuffer, pt_Result->sz_BufferSize, cpt_A->p_StorageBuffer, cpt_A->sz_BufferSize) ||
+	mtxoverlap(pt_Result->p_StorageBuffer, pt_Result->sz_BufferSize, cpt_B->p_StorageBuffer, cpt_B->sz_BufferSize)) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+	return 0;
+}
+
+// Extent and stride of axes [csz_First, csz_First + csz_Count) flattened in row-major order; -1 when they cannot be
+static int tnsflatten(const tensor_t* cpt_Tensor, const size_t csz_First, const size_t csz_Count, size_t* psz_Extent, size_t* psz_Stride) {
+	size_t sz_Extent = 1;
+	size_t sz_Stride = 0;
+
+	for (size_t sz_Axis = csz_First + csz_Count; sz_Axis-- > csz_First;) {
+		if (cpt_Tensor->a_Shape[sz_Axis] == 1) {
+			continue;
+		}
+		if (sz_Extent == 1) {
+			sz_Stride = cpt_Tensor->a_Strides[sz_Axis];
+		} else if (cpt_Tensor->a_Strides[sz_Axis] != sz_Stride * sz_Extent) {
+			return -1;
+		}
+		sz_Extent *= cpt_Tensor->a_Shape[sz_Axis];
+	}
+
+	*psz_Extent = sz_Extent;
+	*psz_Stride = sz_Stride;
+	return 0;
+}
+
+// Packed row-major scratch tensor shaped like cpt_Like, allocated through the result's callbacks
+static int tnsscratch(tensor_t* pt_Scratch, const tensor_t* cpt_Like, const tensor_t* cpt_Result) {
+	*pt_Scratch = *cpt_Like;
+	memset(pt_Scratch->a_Strides, 0, sizeof(pt_Scratch->a_Strides));
+	return tnscreate(pt_Scratch, cpt_Result->pfn_Allocate, cpt_Result->pfn_Free);
+}
+
+int tnscontract(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B, const size_t csz_Axes) {
+	if (tnsproductcheck(pt_Result, cpt_A, cpt_B) != 0) {
+		return -1;
+	}
+
+	const size_t csz_FreeA = cpt_A->sz_Rank - ((csz_Axes <= cpt_A->sz_Rank) ? csz_Axes : 0);
+	int s32_Compatible = csz_Axes <= cpt_A->sz_Rank && csz_Axes <= cpt_B->sz_Rank &&
+		pt_Result->sz_Rank == cpt_A->sz_Rank + cpt_B->sz_Rank - 2 * csz_Axes;
+
+	for (size_t sz_Axis = 0; s32_Compatible && sz_Axis < csz_Axes; ++sz_Axis) {
+		s32_Compatible = cpt_A->a_Shape[csz_FreeA + sz_Axis] == cpt_B->a_Shape[sz_Axis];
+	}
+	for (size_t sz_Axis = 0; s32_Compatible && sz_Axis < pt_Result->sz_Rank; ++sz_Axis) {
+		s32_Compatible = pt_Result->a_Shape[sz_Axis] == ((sz_Axis < csz_FreeA) ? cpt_A->a_Shape[sz_Axis] : cpt_B->a_Shape[sz_Axis - csz_FreeA + csz_Axes]);
+	}
+	if (!s32_Compatible) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	tensor_t s_A = *cpt_A;
+	tensor_t s_B = *cpt_B;
+	tensor_t s_R = *pt_Result;
+	tnsproduct_t s_Product;
+	size_t sz_Extent;
+	int s32_Status = -1;
+
+	memset(&s_Product, 0, sizeof(s_Product));
+	s_A.p_StorageBuffer = NULL;
+	s_B.p_StorageBuffer = NULL;
+	s_R.p_StorageBuffer = NULL;
+
+	// Operands whose groups of axes do not flatten in place are packed; packed tensors always flatten
+	if (tnsflatten(cpt_A, 0, csz_FreeA, &sz_Extent, &s_Product.sz_RowA) != 0 || tnsflatten(cpt_A, csz_FreeA, csz_Axes, &sz_Extent, &s_Product.sz_ColA) != 0) {
+		if (tnsscratch(&s_A, cpt_A, pt_Result) != 0 || tnscopy(&s_A, cpt_A) != 0) {
+			goto cleanup;
+		}
+		tnsflatten(&s_A, 0, csz_FreeA, &sz_Extent, &s_Product.sz_RowA);
+		tnsflatten(&s_A, csz_FreeA, csz_Axes, &sz_Extent, &s_Product.sz_ColA);
+	}
+	if (tnsflatten(cpt_B, 0, csz_Axes, &sz_Extent, &s_Product.sz_RowB) != 0 || tnsflatten(cpt_B, csz_Axes, cpt_B->sz_Rank - csz_Axes, &sz_Extent, &s_Product.sz_ColB) != 0) {
+		if (tnsscratch(&s_B, cpt_B, pt_Result) != 0 || tnscopy(&s_B, cpt_B) != 0) {
+			goto cleanup;
+		}
+		tnsflatten(&s_B, 0, csz_Axes, &sz_Extent, &s_Product.sz_RowB);
+		tnsflatten(&s_B, csz_Axes, cpt_B->sz_Rank - csz_Axes, &sz_Extent, &s_Product.sz_ColB);
+	}
+	if (tnsflatten(pt_Result, 0, csz_FreeA, &s_Product.sz_M, &s_Product.sz_RowR) != 0 || tnsflatten(pt_Result, csz_FreeA, pt_Result->sz_Rank - csz_FreeA, &s_Product.sz_N, &s_Product.sz_ColR) != 0) {
+		if (tnsscratch(&s_R, pt_Result, pt_Result) != 0) {
+			goto cleanup;
+		}
+		tnsflatten(&s_R, 0, csz_FreeA, &s_Product.sz_M, &s_Product.sz_RowR);
+		tnsflatten(&s_R, csz_FreeA, pt_Result->sz_Rank - csz_FreeA, &s_Product.sz_N, &s_Product.sz_ColR);
+	}
+	s_Product.sz_K = 1;
+	for (size_t sz_Axis = 0; sz_Axis < csz_Axes; ++sz_Axis) {
+		s_Product.sz_K *= cpt_B->a_Shape[sz_Axis];
+	}
+
+	s_Product.sz_Batches = 1;
+	s_Product.pu8_R = (uint8_t*)((s_R.p_StorageBuffer != NULL) ? s_R.p_StorageBuffer : pt_Result->p_StorageBuffer);
+	s_Product.cpu8_A = (const uint8_t*)((s_A.p_StorageBuffer != NULL) ? s_A.p_StorageBuffer : cpt_A->p_StorageBuffer);
+	s_Product.cpu8_B = (const uint8_t*)((s_B.p_StorageBuffer != NULL) ? s_B.p_StorageBuffer : cpt_B->p_StorageBuffer);
+
+	s32_Status = tnsproduct(&s_Product, pt_Result, cpt_A);
+	if (s32_Status == 0 && s_R.p_StorageBuffer != NULL) {
+		s32_Status = tnscopy(pt_Result, &s_R);
+	}
+
+cleanup:
+	if (s_A.p_StorageBuffer != NULL) {
+		tnsdstry(&s_A);
+	}
+	if (s_B.p_StorageBuffer != NULL) {
+		tnsdstry(&s_B);
+	}
+	if (s_R.p_StorageBuffer != NULL) {
+		tnsdstry(&s_R);
+	}
+	return s32_Status;
+}
+
+int tnsmatmul(tensor_t* pt_Result, const tensor_t* cpt_A, const tensor_t* cpt_B) {
+	if (tnsproductcheck(pt_Result, cpt_A, cpt_B) != 0) {
+		return -1;
+	}
+
+	if (cpt_A->sz_Rank < 2 || cpt_B->sz_Rank < 2 || pt_Result->sz_Rank < cpt_A->sz_Rank || pt_Result->sz_Rank < cpt_B->sz_Rank) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	const size_t csz_RankR = pt_Result->sz_Rank;
+	const size_t csz_RankA = cpt_A->sz_Rank;
+	const size_t csz_RankB = cpt_B->sz_Rank;
+	tnsproduct_t s_Product;
+
+	memset(&s_Product, 0, sizeof(s_Product));
+	s_Product.sz_M = cpt_A->a_Shape[csz_RankA - 2];
+	s_Product.sz_K = cpt_A->a_Shape[csz_RankA - 1];
+	s_Product.sz_N = cpt_B->a_Shape[csz_RankB - 1];
+
+	if (cpt_B->a_Shape[csz_RankB - 2] != s_Product.sz_K ||
+	pt_Result->a_Shape[csz_RankR - 2] != s_Product.sz_M ||
+	pt_Result->a_Shape[csz_RankR - 1] != s_Product.sz_N) {
+		printf("TENSORS NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	s_Product.sz_RowA = cpt_A->a_Strides[csz_RankA - 2];
+	s_Product.sz_ColA = cpt_A->a_Strides[csz_RankA - 1];
+	s_Product.sz_RowB = cpt_B->a_Strides[csz_RankB - 2];
+	s_Product.sz_ColB = cpt_B->a_Strides[csz_RankB - 1];
+	s_Product.sz_RowR = pt_Result->a_Strides[csz_RankR - 2];
+	s_Product.sz_ColR = pt_Result->a_Strides[csz_RankR - 1];
+
+	// Batch axes broadcast exactly like element-wise axes, with the two matrix axes left out
+	s_Product.sz_Batches = 1;
+	for (size_t sz_Axis = 0; sz_Axis + 2 < csz_RankR; ++sz_Axis) {
+		size_t sz_StrideA;
+		size_t sz_StrideB;
+
+		if (tnsalign(&sz_StrideA, cpt_A, pt_Result, sz_Axis) != 0 || tnsalign(&sz_StrideB, cpt_B, pt_Result, sz_Axis) != 0) {
+			printf("TENSORS NOT COMPATIBLE!\n");
+			return -1;
+		}
+		if (pt_Result->a_Shape[sz_Axis] == 1) {
+			continue;
+		}
+
+		s_Product.a_BatchShape[s_Product.sz_BatchRank] = pt_Result->a_Shape[sz_Axis];
+		s_Product.a_BatchStrides[0][s_Product.sz_BatchRank] = pt_Result->a_Strides[sz_Axis];
+		s_Product.a_BatchStrides[1][s_Product.sz_BatchRank] = sz_StrideA;
+		s_Product.a_BatchStrides[2][s_Product.sz_BatchRank] = sz_StrideB;
+		s_Product.sz_Batches *= pt_Result->a_Shape[sz_Axis];
+		++s_Product.sz_BatchRank;
+	}
+
+	s_Product.pu8_R = (uint8_t*)pt_Result->p_StorageBuffer;
+	s_Product.cpu8_A = (const uint8_t*)cpt_A->p_StorageBuffer;
+	s_Product.cpu8_B = (const uint8_t*)cpt_B->p_StorageBuffer;
+	return tnsproduct(&s_Product, pt_Result, cpt_A);
+}
+
+void tnsdstry(tensor_t* pt_Tensor) {
+	if (pt_Tensor == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return;
+	}
+
+	if (pt_Tensor->p_StorageBuffer != NULL && !pt_Tensor->s32_Borrowed) {
+		bufrelease(pt_Tensor->p_StorageBuffer, &pt_Tensor->psz_References, pt_Tensor->pfn_Free);
+		pt_Tensor->sz_BufferSize = 0;
+	}
+	return;
+}
@@ -0,0 +1,451 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin99/matrix.h"
+#include "lin99/parallel.h"
+#include "internal.h"
+
+// Matrices processed side by side by the batched kernels; each formula runs once per lane in a fixed-length loop
+#define TINY_LANES          	16
+// Fewest matrices worth handing to another thread
+#define TINY_PARALLEL_GRAIN 	16384
+
+/**
+ * TINY_SINGLE/TINY_TILED - Accessors for element (r, c) of a column-major matrix of order n.
+ *
+ * TINY_SINGLE addresses one matrix stored as n * n consecutive elements.  TINY_TILED addresses lane sz_Lane
+ * of a tile holding TINY_LANES matrices element by element, so that one element of every lane is contiguous
+ * and the loop over lanes vectorises across matrices.  Vectors are read as n x 1 matrices and scalars as 1 x 1.
+ */
+#define TINY_SINGLE(p, n, r, c) 	(p)[(r) + (c) * (n)]
+#define TINY_TILED(p, n, r, c)  	(p)[((r) + (c) * (n)) * TINY_LANES + sz_Lane]
+
+/**
+ * TINY_* - Fully unrolled formulas, written once and expanded with either accessor.
+ *
+ * Every input is loaded into a named constant (ct_A01 is row 0, column 1 of the left operand) before any
+ * output is stored, so single calls may pass the same array as input and output.
+ */
+#define TINY_LOAD2(type, at, src, name) \
+	const type ct_##name##00 = at(src, 2, 0, 0); \
+	const type ct_##name##10 = at(src, 2, 1, 0); \
+	const type ct_##name##01 = at(src, 2, 0, 1); \
+	const type ct_##name##11 = at(src, 2, 1, 1);
+
+#define TINY_LOAD3(type, at, src, name) \
+	const type ct_##name##00 = at(src, 3, 0, 0); \
+	const type ct_##name##10 = at(src, 3, 1, 0); \
+	const type ct_##name##20 = at(src, 3, 2, 0); \
+	const type ct_##name##01 = at(src, 3, 0, 1); \
+	const type ct_##name##11 = at(src, 3, 1, 1); \
+	const type ct_##name##21 = at(src, 3, 2, 1); \
+	const type ct_##name##02 = at(src, 3, 0, 2); \
+	const type ct_##name##12 = at(src, 3, 1, 2); \
+	const type ct_##name##22 = at(src, 3, 2, 2);
+
+#define TINY_LOAD4(type, at, src, name) \
+	const type ct_##name##00 = at(src, 4, 0, 0); \
+	const type ct_##name##10 = at(src, 4, 1, 0); \
+	const type ct_##name##20 = at(src, 4, 2, 0); \
+	const type ct_##name##30 = at(src, 4, 3, 0); \
+	const type ct_##name##01 = at(src, 4, 0, 1); \
+	const type ct_##name##11 = at(src, 4, 1, 1); \
+	const type ct_##name##21 = at(src, 4, 2, 1); \
+	const type ct_##name##31 = at(src, 4, 3, 1); \
+	const type ct_##name##02 = at(src, 4, 0, 2); \
+	const type ct_##name##12 = at(src, 4, 1, 2); \
+	const type ct_##name##22 = at(src, 4, 2, 2); \
+	const type ct_##name##32 = at(src, 4, 3, 2); \
+	const type ct_##name##03 = at(src, 4, 0, 3); \
+	const type ct_##name##13 = at(src, 4, 1, 3); \
+	const type ct_##name##23 = at(src, 4, 2, 3); \
+	const type ct_##name##33 = at(src, 4, 3, 3);
+
+#define TINY_LOADV2(type, at, src, name) \
+	const type ct_##name##0 = at(src, 2, 0, 0); \
+	const type ct_##name##1 = at(src, 2, 1, 0);
+
+#define TINY_LOADV3(type, at, src, name) \
+	const type ct_##name##0 = at(src, 3, 0, 0); \
+	const type ct_##name##1 = at(src, 3, 1, 0); \
+	const type ct_##name##2 = at(src, 3, 2, 0);
+
+#define TINY_LOADV4(type, at, src, name) \
+	const type ct_##name##0 = at(src, 4, 0, 0); \
+	const type ct_##name##1 = at(src, 4, 1, 0); \
+	const type ct_##name##2 = at(src, 4, 2, 0); \
+	const type ct_##name##3 = at(src, 4, 3, 0);
+
+#define TINY_MUL2(type, at, out, lhs, rhs) \
+	TINY_LOAD2(type, at, lhs, A) \
+	TINY_LOAD2(type, at, rhs, B) \
+	at(out, 2, 0, 0) = ct_A00 * ct_B00 + ct_A01 * ct_B10; \
+	at(out, 2, 1, 0) = ct_A10 * ct_B00 + ct_A11 * ct_B10; \
+	at(out, 2, 0, 1) = ct_A00 * ct_B01 + ct_A01 * ct_B11; \
+	at(out, 2, 1, 1) = ct_A10 * ct_B01 + ct_A11 * ct_B11;
+
+#define TINY_MUL3(type, at, out, lhs, rhs) \
+	TINY_LOAD3(type, at, lhs, A) \
+	TINY_LOAD3(type, at, rhs, B) \
+	at(out, 3, 0, 0) = ct_A00 * ct_B00 + ct_A01 * ct_B10 + ct_A02 * ct_B20; \
+	at(out, 3, 1, 0) = ct_A10 * ct_B00 + ct_A11 * ct_B10 + ct_A12 * ct_B20; \
+	at(out, 3, 2, 0) = ct_A20 * ct_B00 + ct_A21 * ct_B10 + ct_A22 * ct_B20; \
+	at(out, 3, 0, 1) = ct_A00 * ct_B01 + ct_A01 * ct_B11 + ct_A02 * ct_B21; \
+	at(out, 3, 1, 1) = ct_A10 * ct_B01 + ct_A11 * ct_B11 + ct_A12 * ct_B21; \
+	at(out, 3, 2, 1) = ct_A20 * ct_B01 + ct_A21 * ct_B11 + ct_A22 * ct_B21; \
+	at(out, 3, 0, 2) = ct_A00 * ct_B02 + ct_A01 * ct_B12 + ct_A02 * ct_B22; \
+	at(out, 3, 1, 2) = ct_A10 * ct_B02 + ct_A11 * ct_B12 + ct_A12 * ct_B22; \
+	at(out, 3, 2, 2) = ct_A20 * ct_B02 + ct_A21 * ct_B12 + ct_A22 * ct_B22;
+
+#define TINY_MUL4(type, at, out, lhs, rhs) \
+	TINY_LOAD4(type, at, lhs, A) \
+	TINY_LOAD4(type, at, rhs, B) \
+	at(out, 4, 0, 0) = ct_A00 * ct_B00 + ct_A01 * ct_B10 + ct_A02 * ct_B20 + ct_A03 * ct_B30; \
+	at(out, 4, 1, 0) = ct_A10 * ct_B00 + ct_A11 * ct_B10 + ct_A12 * ct_B20 + ct_A13 * ct_B30; \
+	at(out, 4, 2, 0) = ct_A20 * ct_B00 + ct_A21 * ct_B10 + ct_A22 * ct_B20 + ct_A23 * ct_B30; \
+	at(out, 4, 3, 0) = ct_A30 * ct_B00 + ct_A31 * ct_B10 + ct_A32 * ct_B20 + ct_A33 * ct_B30; \
+	at(out, 4, 0, 1) = ct_A00 * ct_B01 + ct_A01 * ct_B11 + ct_A02 * ct_B21 + ct_A03 * ct_B31; \
+	at(out, 4, 1, 1) = ct_A10 * ct_B01 + ct_A11 * ct_B11 + ct_A12 * ct_B21 + ct_A13 * ct_B31; \
+	at(out, 4, 2, 1) = ct_A20 * ct_B01 + ct_A21 * ct_B11 + ct_A22 * ct_B21 + ct_A23 * ct_B31; \
+	at(out, 4, 3, 1) = ct_A30 * ct_B01 + ct_A31 * ct_B11 + ct_A32 * ct_B21 + ct_A33 * ct_B31; \
+	at(out, 4, 0, 2) = ct_A00 * ct_B02 + ct_A01 * ct_B12 + ct_A02 * ct_B22 + ct_A03 * ct_B32; \
+	at(out, 4, 1, 2) = ct_A10 * ct_B02 + ct_A11 * ct_B12 + ct_A12 * ct_B22 + ct_A13 * ct_B32; \
+	at(out, 4, 2, 2) = ct_A20 * ct_B02 + ct_A21 * ct_B12 + ct_A22 * ct_B22 + ct_A23 * ct_B32; \
+	at(out, 4, 3, 2) = ct_A30 * ct_B02 + ct_A31 * ct_B12 + ct_A32 * ct_B22 + ct_A33 * ct_B32; \
+	at(out, 4, 0, 3) = ct_A00 * ct_B03 + ct_A01 * ct_B13 + ct_A02 * ct_B23 + ct_A03 * ct_B33; \
+	at(out, 4, 1, 3) = ct_A10 * ct_B03 + ct_A11 * ct_B13 + ct_A12 * ct_B23 + ct_A13 * ct_B33; \
+	at(out, 4, 2, 3) = ct_A20 * ct_B03 + ct_A21 * ct_B13 + ct_A22 * ct_B23 + ct_A23 * ct_B33; \
+	at(out, 4, 3, 3) = ct_A30 * ct_B03 + ct_A31 * ct_B13 + ct_A32 * ct_B23 + ct_A33 * ct_B33;
+
+#define TINY_MULVCT2(type, at, out, lhs, rhs) \
+	TINY_LOAD2(type, at, lhs, A) \
+	TINY_LOADV2(type, at, rhs, X) \
+	at(out, 2, 0, 0) = ct_A00 * ct_X0 + ct_A01 * ct_X1; \
+	at(out, 2, 1, 0) = ct_A10 * ct_X0 + ct_A11 * ct_X1;
+
+#define TINY_MULVCT3(type, at, out, lhs, rhs) \
+	TINY_LOAD3(type, at, lhs, A) \
+	TINY_LOADV3(type, at, rhs, X) \
+	at(out, 3, 0, 0) = ct_A00 * ct_X0 + ct_A01 * ct_X1 + ct_A02 * ct_X2; \
+	at(out, 3, 1, 0) = ct_A10 * ct_X0 + ct_A11 * ct_X1 + ct_A12 * ct_X2; \
+	at(out, 3, 2, 0) = ct_A20 * ct_X0 + ct_A21 * ct_X1 + ct_A22 * ct_X2;
+
+#define TINY_MULVCT4(type, at, out, lhs, rhs) \
+	TINY_LOAD4(type, at, lhs, A) \
+	TINY_LOADV4(type, at, rhs, X) \
+	at(out, 4, 0, 0) = ct_A00 * ct_X0 + ct_A01 * ct_X1 + ct_A02 * ct_X2 + ct_A03 * ct_X3; \
+	at(out, 4, 1, 0) = ct_A10 * ct_X0 + ct_A11 * ct_X1 + ct_A12 * ct_X2 + ct_A13 * ct_X3; \
+	at(out, 4, 2, 0) = ct_A20 * ct_X0 + ct_A21 * ct_X1 + ct_A22 * ct_X2 + ct_A23 * ct_X3; \
+	at(out, 4, 3, 0) = ct_A30 * ct_X0 + ct_A31 * ct_X1 + ct_A32 * ct_X2 + ct_A33 * ct_X3;
+
+#define TINY_DET2(type, at, out, src) \
+	TINY_LOAD2(type, at, src, A) \
+	at(out, 1, 0, 0) = ct_A00 * ct_A11 - ct_A01 * ct_A10;
+
+#define TINY_DET3(type, at, out, src) \
+	TINY_LOAD3(type, at, src, A) \
+	at(out, 1, 0, 0) = ct_A00 * (ct_A11 * ct_A22 - ct_A12 * ct_A21) - ct_A01 * (ct_A10 * ct_A22 - ct_A12 * ct_A20) + ct_A02 * (ct_A10 * ct_A21 - ct_A11 * ct_A20);
+
+/**
+ * TINY_MINORS4 - The twelve 2x2 minors of a loaded 4x4 matrix, paired top/bottom for the Laplace expansion.
+ *
+ * ct_S* are minors of rows 0-1 and ct_C* the complementary minors of rows 2-3, so that
+ * det = S0 C5 - S1 C4 + S2 C3 + S3 C2 - S4 C1 + S5 C0 and every cofactor is a three-term sum.
+ */
+#define TINY_MINORS4(type) \
+	const type ct_S0 = ct_A00 * ct_A11 - ct_A10 * ct_A01; \
+	const type ct_S1 = ct_A00 * ct_A12 - ct_A10 * ct_A02; \
+	const type ct_S2 = ct_A00 * ct_A13 - ct_A10 * ct_A03; \
+	const type ct_S3 = ct_A01 * ct_A12 - ct_A11 * ct_A02; \
+	const type ct_S4 = ct_A01 * ct_A13 - ct_A11 * ct_A03; \
+	const type ct_S5 = ct_A02 * ct_A13 - ct_A12 * ct_A03; \
+	const type ct_C5 = ct_A22 * ct_A33 - ct_A32 * ct_A23; \
+	const type ct_C4 = ct_A21 * ct_A33 - ct_A31 * ct_A23; \
+	const type ct_C3 = ct_A21 * ct_A32 - ct_A31 * ct_A22; \
+	const type ct_C2 = ct_A20 * ct_A33 - ct_A30 * ct_A23; \
+	const type ct_C1 = ct_A20 * ct_A32 - ct_A30 * ct_A22; \
+	const type ct_C0 = ct_A20 * ct_A31 - ct_A30 * ct_A21; \
+	const type ct_Det = ct_S0 * ct_C5 - ct_S1 * ct_C4 + ct_S2 * ct_C3 + ct_S3 * ct_C2 - ct_S4 * ct_C1 + ct_S5 * ct_C0;
+
+#define TINY_DET4(type, at, out, src) \
+	TINY_LOAD4(type, at, src, A) \
+	TINY_MINORS4(type) \
+	at(out, 1, 0, 0) = ct_Det;
+
+// A singular matrix gets a zero scale, so its inverse comes out as zeros.  The scale is built from
+// comparisons converted to the element type rather than from branches, and the determinant is handed back
+// in the element type, so the tiled lane loop stays straight-line code the compiler can vectorise.
+#define TINY_SCALE(type, det) \
+	const type ct_Scale = (type)(ct_Det != 0) / (ct_Det + (type)(ct_Det == 0)); \
+	det = ct_Det;
+
+#define TINY_INV2(type, at, out, src, det) \
+	TINY_LOAD2(type, at, src, A) \
+	const type ct_Det = ct_A00 * ct_A11 - ct_A01 * ct_A10; \
+	TINY_SCALE(type, det) \
+	at(out, 2, 0, 0) = ct_A11 * ct_Scale; \
+	at(out, 2, 1, 0) = -ct_A10 * ct_Scale; \
+	at(out, 2, 0, 1) = -ct_A01 * ct_Scale; \
+	at(out, 2, 1, 1) = ct_A00 * ct_Scale;
+
+#define TINY_INV3(type, at, out, src, det) \
+	TINY_LOAD3(type, at, src, A) \
+	const type ct_I00 = ct_A11 * ct_A22 - ct_A12 * ct_A21; \
+	const type ct_I10 = ct_A12 * ct_A20 - ct_A10 * ct_A22; \
+	const type ct_I20 = ct_A10 * ct_A21 - ct_A11 * ct_A20; \
+	const type ct_Det = ct_A00 * ct_I00 + ct_A01 * ct_I10 + ct_A02 * ct_I20; \
+	TINY_SCALE(type, det) \
+	at(out, 3, 0, 0) = ct_I00 * ct_Scale; \
+	at(out, 3, 1, 0) = ct_I10 * ct_Scale; \
+	at(out, 3, 2, 0) = ct_I20 * ct_Scale; \
+	at(out, 3, 0, 1) = (ct_A02 * ct_A21 - ct_A01 * ct_A22) * ct_Scale; \
+	at(out, 3, 1, 1) = (ct_A00 * ct_A22 - ct_A02 * ct_A20) * ct_Scale; \
+	at(out, 3, 2, 1) = (ct_A01 * ct_A20 - ct_A00 * ct_A21) * ct_Scale; \
+	at(out, 3, 0, 2) = (ct_A01 * ct_A12 - ct_A02 * ct_A11) * ct_Scale; \
+	at(out, 3, 1, 2) = (ct_A02 * ct_A10 - ct_A00 * ct_A12) * ct_Scale; \
+	at(out, 3, 2, 2) = (ct_A00 * ct_A11 - ct_A01 * ct_A10) * ct_Scale;
+
+#define TINY_INV4(type, at, out, src, det) \
+	TINY_LOAD4(type, at, src, A) \
+	TINY_MINORS4(type) \
+	TINY_SCALE(type, det) \
+	at(out, 4, 0, 0) = ( ct_A11 * ct_C5 - ct_A12 * ct_C4 + ct_A13 * ct_C3) * ct_Scale; \
+	at(out, 4, 0, 1) = (-ct_A01 * ct_C5 + ct_A02 * ct_C4 - ct_A03 * ct_C3) * ct_Scale; \
+	at(out, 4, 0, 2) = ( ct_A31 * ct_S5 - ct_A32 * ct_S4 + ct_A33 * ct_S3) * ct_Scale; \
+	at(out, 4, 0, 3) = (-ct_A21 * ct_S5 + ct_A22 * ct_S4 - ct_A23 * ct_S3) * ct_Scale; \
+	at(out, 4, 1, 0) = (-ct_A10 * ct_C5 + ct_A12 * ct_C2 - ct_A13 * ct_C1) * ct_Scale; \
+	at(out, 4, 1, 1) = ( ct_A00 * ct_C5 - ct_A02 * ct_C2 + ct_A03 * ct_C1) * ct_Scale; \
+	at(out, 4, 1, 2) = (-ct_A30 * ct_S5 + ct_A32 * ct_S2 - ct_A33 * ct_S1) * ct_Scale; \
+	at(out, 4, 1, 3) = ( ct_A20 * ct_S5 - ct_A22 * ct_S2 + ct_A23 * ct_S1) * ct_Scale; \
+	at(out, 4, 2, 0) = ( ct_A10 * ct_C4 - ct_A11 * ct_C2 + ct_A13 * ct_C0) * ct_Scale; \
+	at(out, 4, 2, 1) = (-ct_A00 * ct_C4 + ct_A01 * ct_C2 - ct_A03 * ct_C0) * ct_Scale; \
+	at(out, 4, 2, 2) = ( ct_A30 * ct_S4 - ct_A31 * ct_S2 + ct_A33 * ct_S0) * ct_Scale; \
+	at(out, 4, 2, 3) = (-ct_A20 * ct_S4 + ct_A21 * ct_S2 - ct_A23 * ct_S0) * ct_Scale; \
+	at(out, 4, 3, 0) = (-ct_A10 * ct_C3 + ct_A11 * ct_C1 - ct_A12 * ct_C0) * ct_Scale; \
+	at(out, 4, 3, 1) = ( ct_A00 * ct_C3 - ct_A01 * ct_C1 + ct_A02 * ct_C0) * ct_Scale; \
+	at(out, 4, 3, 2) = (-ct_A30 * ct_S3 + ct_A31 * ct_S1 - ct_A32 * ct_S0) * ct_Scale; \
+	at(out, 4, 3, 3) = ( ct_A20 * ct_S3 - ct_A21 * ct_S1 + ct_A22 * ct_S0) * ct_Scale;
+
+/**
+ * TINY_TILE_DEF - Generates the tile transposition helpers for one floating point type.
+ *
+ * tinygather copies csz_Lanes consecutive operands of csz_Elements elements into tile form, zeroing the
+ * unused lanes of a partial tile (every kernel handles zeros without dividing by zero).  tinyscatter
+ * copies the first csz_Lanes lanes of a tile back out.
+ */
+#define TINY_TILE_DEF(type, abbr) \
+static void tinygather##abbr(type* p_Tile, const type* cp_Source, const size_t csz_Elements, const size_t csz_Lanes) { \
+	for (size_t sz_Lane = 0; sz_Lane < csz_Lanes; ++sz_Lane) { \
+		for (size_t sz_Elem = 0; sz_Elem < csz_Elements; ++sz_Elem) { \
+			p_Tile[sz_Elem * TINY_LANES + sz_Lane] = cp_Source[sz_Lane * csz_Elements + sz_Elem]; \
+		} \
+	} \
+	for (size_t sz_Lane = csz_Lanes; sz_Lane < TINY_LANES; ++sz_Lane) { \
+		for (size_t sz_Elem = 0; sz_Elem < csz_Elements; ++sz_Elem) { \
+			p_Tile[sz_Elem * TINY_LANES + sz_Lane] = 0; \
+		} \
+	} \
+	return; \
+} \
+\
+static void tinyscatter##abbr(type* p_Destination, const type* cp_Tile, const size_t csz_Elements, const size_t csz_Lanes) { \
+	for (size_t sz_Lane = 0; sz_Lane < csz_Lanes; ++sz_Lane) { \
+		for (size_t sz_Elem = 0; sz_Elem < csz_Elements; ++sz_Elem) { \
+			p_Destination[sz_Lane * csz_Elements + sz_Elem] = cp_Tile[sz_Elem * TINY_LANES + sz_Lane]; \
+		} \
+	} \
+	return; \
+}
+
+TINY_TILE_DEF(float, FP32)
+TINY_TILE_DEF(double, FP64)
+
+/**
+ * tinyargs_t - One batched call, shared by every chunk.
+ *
+ * Members:
+ * - pfn_Tile: Tile kernel computing up to TINY_LANES consecutive operands.
+ * - p_Out/cp_A/cp_B: First output and operands of the batch.  cp_B is NULL for unary kernels.
+ * - sz_OutSize/sz_ASize/sz_BSize: Bytes between consecutive outputs and operands.
+ * - a_Singular: Whether each chunk met a singular matrix.
+ */
+typedef struct __tinyargs_t {
+	void (*pfn_Tile)(void*, const void*, const void*, const size_t, int*);
+	void* p_Out;
+	const void* cp_A;
+	const void* cp_B;
+	size_t sz_OutSize;
+	size_t sz_ASize;
+	size_t sz_BSize;
+	int a_Singular[PAR_MAX_THREADS];
+} tinyargs_t;
+
+static void tinychunk(void* p_Context, size_t sz_Chunk, size_t sz_Begin, size_t sz_End) {
+	tinyargs_t* p_Args = (tinyargs_t*)p_Context;
+	int s32_Singular = 0;
+
+	for (size_t sz_Base = sz_Begin; sz_Base < sz_End; sz_Base += TINY_LANES) {
+		const size_t csz_Lanes = (sz_End - sz_Base < TINY_LANES) ? sz_End - sz_Base : TINY_LANES;
+		int s32_Tile = 0;
+
+		p_Args->pfn_Tile((uint8_t*)p_Args->p_Out + sz_Base * p_Args->sz_OutSize,
+			(const uint8_t*)p_Args->cp_A + sz_Base * p_Args->sz_ASize,
+			(p_Args->cp_B != NULL) ? (const uint8_t*)p_Args->cp_B + sz_Base * p_Args->sz_BSize : NULL,
+			csz_Lanes, &s32_Tile);
+		s32_Singular |= s32_Tile;
+	}
+
+	p_Args->a_Singular[sz_Chunk] = s32_Singular;
+	return;
+}
+
+// Runs a tile kernel over a whole batch.  Returns 0, or -1 when the parallel backend failed or any matrix was singular.
+static int tinybatch(void (*pfn_Tile)(void*, const void*, const void*, const size_t, int*), void* p_Out, const size_t csz_OutSize,
+	const void* cp_A, const size_t csz_ASize, const void* cp_B, const size_t csz_BSize, const size_t csz_Count) {
+	tinyargs_t s_Args;
+	const size_t csz_Chunks = parchunks(csz_Count, TINY_PARALLEL_GRAIN);
+	int s32_Singular = 0;
+
+	s_Args.pfn_Tile = pfn_Tile;
+	s_Args.p_Out = p_Out;
+	s_Args.cp_A = cp_A;
+	s_Args.cp_B = cp_B;
+	s_Args.sz_OutSize = csz_OutSize;
+	s_Args.sz_ASize = csz_ASize;
+	s_Args.sz_BSize = csz_BSize;
+	memset(s_Args.a_Singular, 0, sizeof(int) * ((csz_Chunks != 0) ? csz_Chunks : 1));
+
+	if (parfor(csz_Count, TINY_PARALLEL_GRAIN, tinychunk, &s_Args) != 0) {
+		return -1;
+	}
+
+	for (size_t sz_Chunk = 0; sz_Chunk < csz_Chunks; ++sz_Chunk) {
+		s32_Singular |= s_Args.a_Singular[sz_Chunk];
+	}
+	return s32_Singular ? -1 : 0;
+}
+
+/**
+ * TINY_KERNEL_DEF - Generates the single and batched kernels for one order and floating point type.
+ *
+ * Products are memory-bound and their unrolled formulas already fill the vector registers within one matrix,
+ * so the batched products expand them once per matrix rather than calling the exported kernel.  Routing them
+ * through tiles like the inverse made 3x3 and 4x4 batches 1.5-2x slower, as the transposes cost more than the
+ * multiply-adds they save.  Determinants and inverses do enough arithmetic per byte to gain from vectorising
+ * across matrices: their tile kernels gather operands into local tiles, which the compiler knows do not
+ * alias, run the unrolled formula once per lane and scatter the results.  Each tile is gathered whole before
+ * anything is scattered, so a batch may be computed in place.
+ */
+#define TINY_KERNEL_DEF(n, type, abbr) \
+void mtx##n##mul##abbr(type* p_C, const type* cp_A, const type* cp_B) { \
+	TINY_MUL##n(type, TINY_SINGLE, p_C, cp_A, cp_B) \
+	return; \
+} \
+\
+void mtx##n##mulvct##abbr(type* p_Y, const type* cp_A, const type* cp_X) { \
+	TINY_MULVCT##n(type, TINY_SINGLE, p_Y, cp_A, cp_X) \
+	return; \
+} \
+\
+type mtx##n##det##abbr(const type* cp_A) { \
+	type a_Det[1]; \
+	TINY_DET##n(type, TINY_SINGLE, a_Det, cp_A) \
+	return a_Det[0]; \
+} \
+\
+int mtx##n##inv##abbr(type* p_Inverse, const type* cp_A) { \
+	type t_Det; \
+	TINY_INV##n(type, TINY_SINGLE, p_Inverse, cp_A, t_Det) \
+	return (t_Det == 0) ? -1 : 0; \
+} \
+\
+static void tinymul##n##abbr(void* p_Out, const void* cp_A, const void* cp_B, const size_t csz_Lanes, int* ps32_Singular) { \
+	(void)ps32_Singular; \
+	for (size_t sz_Lane = 0; sz_Lane < csz_Lanes; ++sz_Lane) { \
+		type* p_C = (type*)p_Out + sz_Lane * n * n; \
+		const type* cp_Lhs = (const type*)cp_A + sz_Lane * n * n; \
+		const type* cp_Rhs = (const type*)cp_B + sz_Lane * n * n; \
+		TINY_MUL##n(type, TINY_SINGLE, p_C, cp_Lhs, cp_Rhs) \
+	} \
+	return; \
+} \
+\
+static void tinymulvct##n##abbr(void* p_Out, const void* cp_A, const void* cp_B, const size_t csz_Lanes, int* ps32_Singular) { \
+	(void)ps32_Singular; \
+	for (size_t sz_Lane = 0; sz_Lane < csz_Lanes; ++sz_Lane) { \
+		type* p_Y = (type*)p_Out + sz_Lane * n; \
+		const type* cp_Lhs = (const type*)cp_A + sz_Lane * n * n; \
+		const type* cp_X = (const type*)cp_B + sz_Lane * n; \
+		TINY_MULVCT##n(type, TINY_SINGLE, p_Y, cp_Lhs, cp_X) \
+	} \
+	return; \
+} \
+\
+static void tinydet##n##abbr(void* p_Out, const void* cp_A, const void* cp_B, const size_t csz_Lanes, int* ps32_Singular) { \
+	type a_Out[TINY_LANES], a_A[n * n * TINY_LANES]; \
+	(void)cp_B; \
+	(void)ps32_Singular; \
+	tinygather##abbr(a_A, (const type*)cp_A, n * n, csz_Lanes); \
+	for (size_t sz_Lane = 0; sz_Lane < TINY_LANES; ++sz_Lane) { \
+		TINY_DET##n(type, TINY_TILED, a_Out, a_A) \
+	} \
+	tinyscatter##abbr((type*)p_Out, a_Out, 1, csz_Lanes); \
+	return; \
+} \
+\
+static void tinyinv##n##abbr(void* p_Out, const void* cp_A, const void* cp_B, const size_t csz_Lanes, int* ps32_Singular) { \
+	type a_Out[n * n * TINY_LANES], a_A[n * n * TINY_LANES]; \
+	type a_Det[TINY_LANES]; \
+	(void)cp_B; \
+	tinygather##abbr(a_A, (const type*)cp_A, n * n, csz_Lanes); \
+	for (size_t sz_Lane = 0; sz_Lane < TINY_LANES; ++sz_Lane) { \
+		TINY_INV##n(type, TINY_TILED, a_Out, a_A, a_Det[sz_Lane]) \
+	} \
+	/* Padding lanes are all zeros and always singular, so only the real lanes are reported */ \
+	for (size_t sz_Lane = 0; sz_Lane < csz_Lanes; ++sz_Lane) { \
+		*ps32_Singular |= (a_Det[sz_Lane] == 0); \
+	} \
+	tinyscatter##abbr((type*)p_Out, a_Out, n * n, csz_Lanes); \
+	return; \
+} \
+\
+int mtx##n##mulbatch##abbr(type* p_C, const type* cp_A, const type* cp_B, const size_t csz_Count) { \
+	if (p_C == NULL || cp_A == NULL || cp_B == NULL) { \
+		printf("NULL REFERENCE PASSED!\n"); \
+		return -1; \
+	} \
+	return tinybatch(tinymul##n##abbr, p_C, sizeof(type) * n * n, cp_A, sizeof(type) * n * n, cp_B, sizeof(type) * n * n, csz_Count); \
+} \
+\
+int mtx##n##mulvctbatch##abbr(type* p_Y, const type* cp_A, const type* cp_X, const size_t csz_Count) { \
+	if (p_Y == NULL || cp_A == NULL || cp_X == NULL) { \
+		printf("NULL REFERENCE PASSED!\n"); \
+		return -1; \
+	} \
+	return tinybatch(tinymulvct##n##abbr, p_Y, sizeof(type) * n, cp_A, sizeof(type) * n * n, cp_X, sizeof(type) * n, csz_Count); \
+} \
+\
+int mtx##n##detbatch##abbr(type* p_Det, const type* cp_A, const size_t csz_Count) { \
+	if (p_Det == NULL || cp_A == NULL) { \
+		printf("NULL REFERENCE PASSED!\n"); \
+		return -1; \
+	} \
+	return tinybatch(tinydet##n##abbr, p_Det, sizeof(type), cp_A, sizeof(type) * n * n, NULL, 0, csz_Count); \
+} \
+\
+int mtx##n##invbatch##abbr(type* p_Inverse, const type* cp_A, const size_t csz_Count) { \
+	if (p_Inverse == NULL || cp_A == NULL) { \
+		printf("NULL REFERENCE PASSED!\n"); \
+		return -1; \
+	} \
+	return tinybatch(tinyinv##n##abbr, p_Inverse, sizeof(type) * n * n, cp_A, sizeof(type) * n * n, NULL, 0, csz_Count); \
+}
+
+TINY_KERNEL_DEF(2, float, FP32)
+TINY_KERNEL_DEF(3, float, FP32)
+TINY_KERNEL_DEF(4, float, FP32)
+TINY_KERNEL_DEF(2, double, FP64)
+TINY_KERNEL_DEF(3, double, FP64)
+TINY_KERNEL_DEF(4, double, FP64)
@@ -3,7 +3,78 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "lin99/vector.h"
+#include "internal.h"
+
+// Reference counts are updated by whichever thread clones, copies or destroys a holder, so they are atomic
+#if defined(__GNUC__) || defined(__clang__)
+#define REFERENCE_ADD(psz) 	__atomic_add_fetch((psz), 1, __ATOMIC_RELAXED)
+#define REFERENCE_DROP(psz)	__atomic_sub_fetch((psz), 1, __ATOMIC_ACQ_REL)
+#define REFERENCE_LOAD(psz)	__atomic_load_n((psz), __ATOMIC_ACQUIRE)
+#else
+#define REFERENCE_ADD(psz) 	(++*(psz))
+#define REFERENCE_DROP(psz)	(--*(psz))
+#define REFERENCE_LOAD(psz)	(*(psz))
+#endif
+
+int bufshare(size_t** ppsz_References, void* (*pfn_Allocate)(size_t)) {
+	if (*ppsz_References == NULL) {
+		*ppsz_References = (size_t*)pfn_Allocate(sizeof(size_t));
+		if (!CHECK_ALLOCATION(*ppsz_References)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+		**ppsz_References = 1;
+	}
+
+	REFERENCE_ADD(*ppsz_References);
+	return 0;
+}
+
+void bufrelease(void* p_Buffer, size_t** ppsz_References, void (*pfn_Free)(void*)) {
+	if (*ppsz_References == NULL) {
+		pfn_Free(p_Buffer);
+		return;
+	}
+
+	if (REFERENCE_DROP(*ppsz_References) == 0) {
+		pfn_Free(*ppsz_References);
+		pfn_Free(p_Buffer);
+	}
+	*ppsz_References = NULL;
+	return;
+}
+
+int bufunique(void** pp_Buffer, size_t** ppsz_References, const size_t csz_Size, const int cs32_Keep, void* (*pfn_Allocate)(size_t), void (*pfn_Free)(void*)) {
+	if (*ppsz_References == NULL) {
+		return 0;
+	}
+
+	// No other holder is left to clone from, so the last one keeps the buffer as it is
+	if (REFERENCE_LOAD(*ppsz_References) == 1) {
+		pfn_Free(*ppsz_References);
+		*ppsz_References = NULL;
+		return 0;
+	}
+
+	void* p_Copy = pfn_Allocate(csz_Size);
+	if (!CHECK_ALLOCATION(p_Copy)) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+	if (cs32_Keep) {
+		memcpy(p_Copy, *pp_Buffer, csz_Size);
+	}
+
+	// The other holders may have let go in the meantime, in which case the old buffer is freed here
+	bufrelease(*pp_Buffer, ppsz_References, pfn_Free);
+	*pp_Buffer = p_Copy;
+	return 0;
+}
 
 int vctcreate(vector_t* pv_Vector, void* (*pfn_AllocateMemory)(size_t), void (*pfn_FreeMemory)(void*)) {
   if(pv_Vector == NULL) {
@@ -11,19 +82,22 @@ int vctcreate(vector_t* pv_Vector, void* (*pfn_AllocateMemory)(size_t), void (*p
 	return -1;
   }
  
-  if (pv_Vector->sz_ElementCount == 0 ||
+  if ((pv_Vector->sz_ElementCount == 0 && pv_Vector->sz_Capacity == 0) ||
   	pv_Vector->sz_ElementSize  == 0) {
   	return -1;  
   }
  
   // We can't use aligned_alloc here since this project is intended to be strictly C99, and aligned_alloc wasn't introduced until C11
-	pv_Vector->pfn_Allocate = ((pfn_AllocateMemory != NULL) || (pv_Vector->pfn_Allocate != NULL)) ? pfn_AllocateMemory : zalloc;
-	pv_Vector->pfn_Free = ((pfn_FreeMemory != NULL) || (pv_Vector->pfn_Free != NULL)) ? pfn_FreeMemory : free;
+	// Callbacks passed in win over callbacks already set on the struct, which win over calloc/free
+	pv_Vector->pfn_Allocate = (pfn_AllocateMemory != NULL) ? pfn_AllocateMemory : ((pv_Vector->pfn_Allocate != NULL) ? pv_Vector->pfn_Allocate : zalloc);
+	pv_Vector->pfn_Free = (pfn_FreeMemory != NULL) ? pfn_FreeMemory : ((pv_Vector->pfn_Free != NULL) ? pv_Vector->pfn_Free : free);
  
-	pv_Vector->sz_BufferSize = pv_Vector->sz_ElementSize * pv_Vector->sz_ElementCount;
+	pv_Vector->sz_Capacity = (pv_Vector->sz_Capacity > pv_Vector->sz_ElementCount) ? pv_Vector->sz_Capacity : pv_Vector->sz_ElementCount;
+	pv_Vector->sz_BufferSize = pv_Vector->sz_ElementSize * pv_Vector->sz_Capacity;
+	pv_Vector->psz_References = NULL;
 	pv_Vector->p_StorageBuffer = pv_Vector->pfn_Allocate(pv_Vector->sz_BufferSize);
 
-  if (!CHECK_ALLOCATION(pv_Vector->p_StorageBuffer) || pv_Vector->sz_BufferSize < pv_Vector->sz_ElementCount) {
+  if (!CHECK_ALLOCATION(pv_Vector->p_StorageBuffer) || pv_Vector->sz_BufferSize / pv_Vector->sz_ElementSize != pv_Vector->sz_Capacity) {
 	pv_Vector->pfn_Free(pv_Vector->p_StorageBuffer);
 	printf("MULTIPLICATION OVERFLOW WHEN CALCULATING BUFFER SIZE\n");
   	return -1;
@@ -45,6 +119,38 @@ int vctmemchk(const vector_t* cpv_Vector) {
   return -1;
 }
 
+int vctclone(vector_t* pv_Clone, vector_t* pv_Source) {
+	if (pv_Clone == NULL || pv_Source == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctmemchk(pv_Source) != 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (pv_Clone == pv_Source) {
+		return 0;
+	}
+
+	if (bufshare(&pv_Source->psz_References, pv_Source->pfn_Allocate) != 0) {
+		return -1;
+	}
+
+	*pv_Clone = *pv_Source;
+	return 0;
+}
+
+int vctunique(vector_t* pv_Vector) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	return bufunique(&pv_Vector->p_StorageBuffer, &pv_Vector->psz_References, pv_Vector->sz_BufferSize, 1, pv_Vector->pfn_Allocate, pv_Vector->pfn_Free);
+}
+
 void vctread(void* p_Destination, const vector_t* cpv_Vector, const size_t csz_Idx) {
   if(cpv_Vector == NULL) {
 	printf("NULL REFERENCE PASSED!\n");
@@ -70,10 +176,176 @@ void vctwrite(vector_t* pv_Vector, const size_t csz_Idx, void* p_Data) {
     	return;
 	}
 
+	if (vctunique(pv_Vector) != 0) {
+		return;
+	}
+
 	memcpy((uint8_t*)pv_Vector->p_StorageBuffer + (csz_Idx * pv_Vector->sz_ElementSize), p_Data, pv_Vector->sz_ElementSize);
 	return;
 }
 
+// Capacity a growing vector starts from, so pushes onto tiny vectors do not reallocate every time
+#define VECTOR_MIN_CAPACITY	8
+
+// Vectors assembled by hand (views, literals) may leave sz_Capacity at 0; their buffer holds at least sz_ElementCount
+#define VECTOR_CAPACITY(cpv) (((cpv)->sz_Capacity > (cpv)->sz_ElementCount) ? (cpv)->sz_Capacity : (cpv)->sz_ElementCount)
+
+// Move the buffer to one holding exactly csz_Capacity elements, keeping the first min(count, capacity) of them
+static int vctrealloc(vector_t* pv_Vector, const size_t csz_Capacity) {
+	const size_t csz_Size = pv_Vector->sz_ElementSize;
+
+	if (csz_Capacity > SIZE_MAX / csz_Size) {
+		printf("MULTIPLICATION OVERFLOW WHEN CALCULATING BUFFER SIZE\n");
+		return -1;
+	}
+
+	// A shared buffer is copied into the new one and left to its other holders, so it is never reallocated in place
+	void* p_Buffer;
+	if (pv_Vector->pfn_Reallocate != NULL && pv_Vector->psz_References == NULL) {
+		p_Buffer = pv_Vector->pfn_Reallocate(pv_Vector->p_StorageBuffer, (pv_Vector->p_StorageBuffer != NULL) ? pv_Vector->sz_BufferSize : 0, csz_Capacity * csz_Size);
+		if (!CHECK_ALLOCATION(p_Buffer)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+	} else {
+		p_Buffer = pv_Vector->pfn_Allocate(csz_Capacity * csz_Size);
+		if (!CHECK_ALLOCATION(p_Buffer)) {
+			printf("MEMORY NOT FOUND!\n");
+			return -1;
+		}
+		if (pv_Vector->p_StorageBuffer != NULL) {
+			const size_t csz_Kept = (pv_Vector->sz_ElementCount < csz_Capacity) ? pv_Vector->sz_ElementCount : csz_Capacity;
+			memcpy(p_Buffer, pv_Vector->p_StorageBuffer, csz_Kept * csz_Size);
+			bufrelease(pv_Vector->p_StorageBuffer, &pv_Vector->psz_References, pv_Vector->pfn_Free);
+		}
+	}
+
+	pv_Vector->p_StorageBuffer = p_Buffer;
+	pv_Vector->sz_BufferSize = csz_Capacity * csz_Size;
+	pv_Vector->sz_Capacity = csz_Capacity;
+	return 0;
+}
+
+// A vector that was never created gets the same default callbacks vctcreate would have given it
+static int vctgrowable(vector_t* pv_Vector) {
+	if (pv_Vector->sz_ElementSize == 0) {
+		printf("VECTOR NOT COMPATIBLE!\n");
+		return -1;
+	}
+
+	if (pv_Vector->pfn_Allocate == NULL || pv_Vector->pfn_Free == NULL) {
+		pv_Vector->pfn_Allocate = zalloc;
+		pv_Vector->pfn_Free = free;
+	}
+	return 0;
+}
+
+// Grow to at least csz_Required elements, doubling so that repeated growth costs amortised O(1) per element
+static int vctgrow(vector_t* pv_Vector, const size_t csz_Required) {
+	if (vctgrowable(pv_Vector) != 0) {
+		return -1;
+	}
+
+	// Callers write into the grown range next, so a shared buffer that is already large enough is copied instead
+	if (pv_Vector->p_StorageBuffer != NULL && csz_Required <= VECTOR_CAPACITY(pv_Vector)) {
+		return vctunique(pv_Vector);
+	}
+
+	size_t sz_Capacity = (pv_Vector->p_StorageBuffer != NULL) ? VECTOR_CAPACITY(pv_Vector) : 0;
+	sz_Capacity = (sz_Capacity < VECTOR_MIN_CAPACITY) ? VECTOR_MIN_CAPACITY : sz_Capacity;
+	while (sz_Capacity < csz_Required) {
+		sz_Capacity = (sz_Capacity > SIZE_MAX / 2) ? csz_Required : 2 * sz_Capacity;
+	}
+
+	return vctrealloc(pv_Vector, sz_Capacity);
+}
+
+int vctreserve(vector_t* pv_Vector, const size_t csz_Capacity) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (vctgrowable(pv_Vector) != 0) {
+		return -1;
+	}
+
+	// An explicit reservation is honoured exactly; only implicit growth rounds up
+	if (pv_Vector->p_StorageBuffer != NULL && csz_Capacity <= VECTOR_CAPACITY(pv_Vector)) {
+		return 0;
+	}
+
+	return vctrealloc(pv_Vector, (csz_Capacity != 0) ? csz_Capacity : 1);
+}
+
+int vctappend(vector_t* pv_Vector, const void* cp_Elements, const size_t csz_Count) {
+	if (pv_Vector == NULL || (cp_Elements == NULL && csz_Count != 0)) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (csz_Count > SIZE_MAX - pv_Vector->sz_ElementCount) {
+		printf("ADDITION OVERFLOW WHEN CALCULATING ELEMENT COUNT\n");
+		return -1;
+	}
+
+	// Appending a vector to itself must survive the buffer moving, so the source is tracked as an offset
+	const uintptr_t cu_Buffer = (uintptr_t)pv_Vector->p_StorageBuffer;
+	const uintptr_t cu_Source = (uintptr_t)cp_Elements;
+	const int cs32_Inside = pv_Vector->p_StorageBuffer != NULL && cu_Source >= cu_Buffer && cu_Source < cu_Buffer + pv_Vector->sz_BufferSize;
+	const size_t csz_Offset = (size_t)(cu_Source - cu_Buffer);
+
+	if (vctgrow(pv_Vector, pv_Vector->sz_ElementCount + csz_Count) != 0) {
+		return -1;
+	}
+
+	const void* cp_Source = cs32_Inside ? (const void*)((uint8_t*)pv_Vector->p_StorageBuffer + csz_Offset) : cp_Elements;
+	memmove((uint8_t*)pv_Vector->p_StorageBuffer + pv_Vector->sz_ElementCount * pv_Vector->sz_ElementSize, cp_Source, csz_Count * pv_Vector->sz_ElementSize);
+	pv_Vector->sz_ElementCount += csz_Count;
+	return 0;
+}
+
+int vctpush(vector_t* pv_Vector, const void* cp_Element) {
+	return vctappend(pv_Vector, cp_Element, 1);
+}
+
+int vctresize(vector_t* pv_Vector, const size_t csz_Count) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (csz_Count > pv_Vector->sz_ElementCount) {
+		if (vctgrow(pv_Vector, csz_Count) != 0) {
+			return -1;
+		}
+		memset((uint8_t*)pv_Vector->p_StorageBuffer + pv_Vector->sz_ElementCount * pv_Vector->sz_ElementSize, 0,
+			(csz_Count - pv_Vector->sz_ElementCount) * pv_Vector->sz_ElementSize);
+	}
+
+	pv_Vector->sz_ElementCount = csz_Count;
+	return 0;
+}
+
+int vctshrink(vector_t* pv_Vector) {
+	if (pv_Vector == NULL) {
+		printf("NULL REFERENCE PASSED!\n");
+		return -1;
+	}
+
+	if (pv_Vector->p_StorageBuffer == NULL || pv_Vector->pfn_Allocate == NULL || pv_Vector->pfn_Free == NULL) {
+		printf("MEMORY NOT FOUND!\n");
+		return -1;
+	}
+
+	const size_t csz_Target = (pv_Vector->sz_ElementCount != 0) ? pv_Vector->sz_ElementCount : 1;
+	if (csz_Target >= VECTOR_CAPACITY(pv_Vector)) {
+		return 0;
+	}
+
+	return vctrealloc(pv_Vector, csz_Target);
+}
+
 int vctcmp(const vector_t* cpv_A, const vector_t* cpv_B) {
   if(cpv_A == NULL || cpv_B == NULL) {
 	printf("NULL REFERENCE PASSED!\n");
@@ -91,7 +363,249 @@ int vctcmp(const vector_t* cpv_A, const vector_t* cpv_B) {
 	return 0;
 }
 
-#define ELEMENTWISE_OP_DEF(fn_Name, pfn_Name) \
+/**
+ * Built-in integer kernels
+ *
+ * Every kernel computes cp_A[i] (op) cp_B[i * csz_StrideB] into p_R[i], where a csz_StrideB of 0 broadcasts
+ * a single right operand for the scale operations.  Results are either clamped (INTEGER_MODE_SATURATE) or
+ * wrapped with overflow accumulated into a flag (INTEGER_MODE_CHECKED).  Add, subtract and multiply are
+ * written without per-element branches so compilers can lower them to packed saturating/widening instructions.
+ *
+ * Returns:
+ *  - Overflow occurred (INTEGER_MODE_CHECKED only): 1
+ *  - No overflow: 0
+ */
+
+// Lower-bound test of a wide result; an unsigned wide type cannot fall below an unsigned element's minimum of 0
+#define WIDE_BELOW_MIN_0(wide, min, w) 0
+#define WIDE_BELOW_MIN_1(wide, min, w) ((w) < (wide)(min))
+
+// 8 and 16-bit saturating add/subtract map directly onto padds/paddus/psubs/psubus; the widening loop below only
+// reaches pminsw/pmaxsw, so SSE2 builds run the contiguous or broadcast prefix packed and leave the tail to it
+#if defined(__SSE2__)
+#define PACKED_SATURATE_DEF(type, abbr, lane, set1, add, sub) \
+static size_t intpacked##abbr(type* p_R, const type* cp_A, const type* cp_B, const size_t csz_StrideB, const size_t csz_Count, const int cs32_Op) { \
+	const size_t csz_Lanes = sizeof(__m128i) / sizeof(type); \
+	size_t sz_Idx = 0; \
+	\
+	if (csz_StrideB > 1 || (cs32_Op != INTEGER_OP_ADD && cs32_Op != INTEGER_OP_SUB)) { \
+		return 0; \
+	} \
+	\
+	const __m128i cv_Broadcast = set1((lane)cp_B[0]); \
+	for (; sz_Idx + csz_Lanes <= csz_Count; sz_Idx += csz_Lanes) { \
+		__m128i v_A = _mm_loadu_si128((const __m128i*)(cp_A + sz_Idx)); \
+		__m128i v_B = (csz_StrideB == 0) ? cv_Broadcast : _mm_loadu_si128((const __m128i*)(cp_B + sz_Idx)); \
+		__m128i v_R = (cs32_Op == INTEGER_OP_ADD) ? add(v_A, v_B) : sub(v_A, v_B); \
+		_mm_storeu_si128((__m128i*)(p_R + sz_Idx), v_R); \
+	} \
+	\
+	return sz_Idx; \
+}
+
+PACKED_SATURATE_DEF(int8_t, S8, char, _mm_set1_epi8, _mm_adds_epi8, _mm_subs_epi8)
+PACKED_SATURATE_DEF(uint8_t, U8, char, _mm_set1_epi8, _mm_adds_epu8, _mm_subs_epu8)
+PACKED_SATURATE_DEF(int16_t, S16, short, _mm_set1_epi16, _mm_adds_epi16, _mm_subs_epi16)
+PACKED_SATURATE_DEF(uint16_t, U16, short, _mm_set1_epi16, _mm_adds_epu16, _mm_subs_epu16)
+
+#define INTEGER_PACKED_S8(...)	intpackedS8(__VA_ARGS__)
+#define INTEGER_PACKED_U8(...)	intpackedU8(__VA_ARGS__)
+#define INTEGER_PACKED_S16(...)	intpackedS16(__VA_ARGS__)
+#define INTEGER_PACKED_U16(...)	intpackedU16(__VA_ARGS__)
+#else
+#define INTEGER_PACKED_S8(...)	0
+#define INTEGER_PACKED_U8(...)	0
+#define INTEGER_PACKED_S16(...)	0
+#define INTEGER_PACKED_U16(...)	0
+#endif
+#define INTEGER_PACKED_S32(...)	0
+#define INTEGER_PACKED_U32(...)	0
+
+// Evaluate expr in a type wide enough to hold any result, then clamp or flag it against the element range
+#define WIDE_INTEGER_LOOP(type, wide, min, max, expr, signed_wide) \
+	if (cs32_Mode == INTEGER_MODE_SATURATE) { \
+		for (size_t sz_Idx = sz_Packed; sz_Idx < csz_Count; ++sz_Idx) { \
+			wide w_A = cp_A[sz_Idx]; \
+			wide w_B = cp_B[sz_Idx * csz_StrideB]; \
+			wide w_R = (expr); \
+			w_R = (w_R > (wide)(max)) ? (wide)(max) : w_R; \
+			w_R = WIDE_BELOW_MIN_##signed_wide(wide, min, w_R) ? (wide)(min) : w_R; \
+			p_R[sz_Idx] = (type)w_R; \
+		} \
+	} else { \
+		for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) { \
+			wide w_A = cp_A[sz_Idx]; \
+			wide w_B = cp_B[sz_Idx * csz_StrideB]; \
+			wide w_R = (expr); \
+			s32_Overflow |= (w_R > (wide)(max)) | WIDE_BELOW_MIN_##signed_wide(wide, min, w_R); \
+			p_R[sz_Idx] = (type)w_R; \
+		} \
+	}
+
+// Division cannot be widened away: only x / 0 and MIN / -1 overflow, so those divisors are replaced before dividing
+#define DIVIDE_INTEGER_LOOP(type, min, max, is_signed) \
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) { \
+		type t_A = cp_A[sz_Idx]; \
+		type t_B = cp_B[sz_Idx * csz_StrideB]; \
+		int s32_Zero = (t_B == 0); \
+		int s32_Edge = (is_signed) && (t_A == (type)(min)) && (t_B == (type)-1); \
+		type t_R = (type)(t_A / ((s32_Zero | s32_Edge) ? (type)1 : t_B)); \
+		t_R = s32_Zero ? (type)0 : t_R; \
+		t_R = (s32_Edge && cs32_Mode == INTEGER_MODE_SATURATE) ? (type)(max) : t_R; \
+		s32_Overflow |= s32_Zero | s32_Edge; \
+		p_R[sz_Idx] = t_R; \
+	}
+
+// Types of at most 32 bits have a wider type to compute in; unsigned subtraction is carried out in the signed wide type
+#define NARROW_INTEGER_KERNEL_DEF(type, wide, swide, abbr, min, max, is_signed) \
+static int intkernel##abbr(type* p_R, const type* cp_A, const type* cp_B, const size_t csz_StrideB, const size_t csz_Count, const int cs32_Op, const int cs32_Mode) { \
+	int s32_Overflow = 0; \
+	const size_t sz_Packed = (cs32_Mode == INTEGER_MODE_SATURATE) ? \
+		INTEGER_PACKED_##abbr(p_R, cp_A, cp_B, csz_StrideB, csz_Count, cs32_Op) : 0; \
+	\
+	switch (cs32_Op) { \
+		case INTEGER_OP_ADD: \
+			WIDE_INTEGER_LOOP(type, wide, min, max, w_A + w_B, is_signed) \
+			break; \
+		case INTEGER_OP_SUB: \
+			WIDE_INTEGER_LOOP(type, swide, min, max, w_A - w_B, 1) \
+			break; \
+		case INTEGER_OP_MUL: \
+			WIDE_INTEGER_LOOP(type, wide, min, max, w_A * w_B, is_signed) \
+			break; \
+		default: \
+			DIVIDE_INTEGER_LOOP(type, min, max, is_signed) \
+			break; \
+	} \
+	\
+	return (cs32_Mode == INTEGER_MODE_CHECKED) ? s32_Overflow : 0; \
+}
+
+NARROW_INTEGER_KERNEL_DEF(int8_t, int16_t, int16_t, S8, INT8_MIN, INT8_MAX, 1)
+NARROW_INTEGER_KERNEL_DEF(uint8_t, uint16_t, int16_t, U8, 0, UINT8_MAX, 0)
+NARROW_INTEGER_KERNEL_DEF(int16_t, int32_t, int32_t, S16, INT16_MIN, INT16_MAX, 1)
+NARROW_INTEGER_KERNEL_DEF(uint16_t, uint32_t, int32_t, U16, 0, UINT16_MAX, 0)
+NARROW_INTEGER_KERNEL_DEF(int32_t, int64_t, int64_t, S32, INT32_MIN, INT32_MAX, 1)
+NARROW_INTEGER_KERNEL_DEF(uint32_t, uint64_t, int64_t, U32, 0, UINT32_MAX, 0)
+
+// High 64 bits of a 64x64-bit unsigned product, built from 32-bit halves since C99 has no 128-bit type
+static uint64_t mulhiU64(const uint64_t cu64_A, const uint64_t cu64_B) {
+	uint64_t u64_ALo = cu64_A & 0xFFFFFFFFu, u64_AHi = cu64_A >> 32;
+	uint64_t u64_BLo = cu64_B & 0xFFFFFFFFu, u64_BHi = cu64_B >> 32;
+
+	uint64_t u64_LoLo = u64_ALo * u64_BLo;
+	uint64_t u64_LoHi = u64_ALo * u64_BHi;
+	uint64_t u64_HiLo = u64_AHi * u64_BLo;
+	uint64_t u64_Mid = (u64_LoLo >> 32) + (u64_LoHi & 0xFFFFFFFFu) + (u64_HiLo & 0xFFFFFFFFu);
+
+	return u64_AHi * u64_BHi + (u64_LoHi >> 32) + (u64_HiLo >> 32) + (u64_Mid >> 32);
+}
+
+// 64-bit types detect overflow from the wrapped result (add/subtract) or the high half of the product (multiply)
+static int intkernelS64(int64_t* p_R, const int64_t* cp_A, const int64_t* cp_B, const size_t csz_StrideB, const size_t csz_Count, const int cs32_Op, const int cs32_Mode) {
+	int s32_Overflow = 0;
+	const int cs32_Saturate = (cs32_Mode == INTEGER_MODE_SATURATE);
+
+	if (cs32_Op == INTEGER_OP_DIV) {
+		DIVIDE_INTEGER_LOOP(int64_t, INT64_MIN, INT64_MAX, 1)
+		return (cs32_Mode == INTEGER_MODE_CHECKED) ? s32_Overflow : 0;
+	}
+
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+		int64_t s64_A = cp_A[sz_Idx];
+		int64_t s64_B = cp_B[sz_Idx * csz_StrideB];
+		int64_t s64_R, s64_Limit;
+		int s32_Lane;
+
+		if (cs32_Op == INTEGER_OP_MUL) {
+			int s32_Negative = (s64_A < 0) ^ (s64_B < 0);
+			uint64_t u64_A = (s64_A < 0) ? 0 - (uint64_t)s64_A : (uint64_t)s64_A;
+			uint64_t u64_B = (s64_B < 0) ? 0 - (uint64_t)s64_B : (uint64_t)s64_B;
+
+			s32_Lane = (mulhiU64(u64_A, u64_B) != 0) | (u64_A * u64_B > (uint64_t)INT64_MAX + (uint64_t)s32_Negative);
+			s64_R = (int64_t)((uint64_t)s64_A * (uint64_t)s64_B);
+			s64_Limit = s32_Negative ? INT64_MIN : INT64_MAX;
+		} else if (cs32_Op == INTEGER_OP_SUB) {
+			s64_R = (int64_t)((uint64_t)s64_A - (uint64_t)s64_B);
+			s32_Lane = ((s64_A ^ s64_B) & (s64_A ^ s64_R)) < 0;
+			s64_Limit = (s64_A < 0) ? INT64_MIN : INT64_MAX;
+		} else {
+			s64_R = (int64_t)((uint64_t)s64_A + (uint64_t)s64_B);
+			s32_Lane = ((s64_A ^ s64_R) & (s64_B ^ s64_R)) < 0;
+			s64_Limit = (s64_A < 0) ? INT64_MIN : INT64_MAX;
+		}
+
+		s32_Overflow |= s32_Lane;
+		p_R[sz_Idx] = (cs32_Saturate && s32_Lane) ? s64_Limit : s64_R;
+	}
+
+	return (cs32_Mode == INTEGER_MODE_CHECKED) ? s32_Overflow : 0;
+}
+
+static int intkernelU64(uint64_t* p_R, const uint64_t* cp_A, const uint64_t* cp_B, const size_t csz_StrideB, const size_t csz_Count, const int cs32_Op, const int cs32_Mode) {
+	int s32_Overflow = 0;
+	const int cs32_Saturate = (cs32_Mode == INTEGER_MODE_SATURATE);
+
+	switch (cs32_Op) {
+		case INTEGER_OP_ADD:
+			for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+				uint64_t u64_R = cp_A[sz_Idx] + cp_B[sz_Idx * csz_StrideB];
+				int s32_Lane = (u64_R < cp_A[sz_Idx]);
+				s32_Overflow |= s32_Lane;
+				p_R[sz_Idx] = (cs32_Saturate && s32_Lane) ? UINT64_MAX : u64_R;
+			}
+			break;
+		case INTEGER_OP_SUB:
+			for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+				uint64_t u64_B = cp_B[sz_Idx * csz_StrideB];
+				int s32_Lane = (cp_A[sz_Idx] < u64_B);
+				s32_Overflow |= s32_Lane;
+				p_R[sz_Idx] = (cs32_Saturate && s32_Lane) ? 0 : cp_A[sz_Idx] - u64_B;
+			}
+			break;
+		case INTEGER_OP_MUL:
+			for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+				uint64_t u64_B = cp_B[sz_Idx * csz_StrideB];
+				int s32_Lane = (mulhiU64(cp_A[sz_Idx], u64_B) != 0);
+				s32_Overflow |= s32_Lane;
+				p_R[sz_Idx] = (cs32_Saturate && s32_Lane) ? UINT64_MAX : cp_A[sz_Idx] * u64_B;
+			}
+			break;
+		default:
+			DIVIDE_INTEGER_LOOP(uint64_t, 0, UINT64_MAX, 0)
+			break;
+	}
+
+	return (cs32_Mode == INTEGER_MODE_CHECKED) ? s32_Overflow : 0;
+}
+
+// Dispatches on the element type; declared in internal.h so prepared plans can reuse the kernels
+int intkernel(void* p_R, const void* cp_A, const void* cp_B, const size_t csz_StrideB, const size_t csz_Count, const TYPE cs32_Type, const int cs32_Op, const int cs32_Mode) {
+	if (cs32_Mode != INTEGER_MODE_SATURATE && cs32_Mode != INTEGER_MODE_CHECKED) {
+		return -1;
+	}
+
+	switch (cs32_Type) {
+		case TYPE_S8:  return intkernelS8((int8_t*)p_R, (const int8_t*)cp_A, (const int8_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_U8:  return intkernelU8((uint8_t*)p_R, (const uint8_t*)cp_A, (const uint8_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_S16: return intkernelS16((int16_t*)p_R, (const int16_t*)cp_A, (const int16_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_U16: return intkernelU16((uint16_t*)p_R, (const uint16_t*)cp_A, (const uint16_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_S32: return intkernelS32((int32_t*)p_R, (const int32_t*)cp_A, (const int32_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_U32: return intkernelU32((uint32_t*)p_R, (const uint32_t*)cp_A, (const uint32_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_S64: return intkernelS64((int64_t*)p_R, (const int64_t*)cp_A, (const int64_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_U64: return intkernelU64((uint64_t*)p_R, (const uint64_t*)cp_A, (const uint64_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		case TYPE_SZ:
+			// size_t is unsigned and matches one of the fixed-width unsigned types on every supported platform
+			if (sizeof(size_t) == sizeof(uint64_t)) {
+				return intkernelU64((uint64_t*)p_R, (const uint64_t*)cp_A, (const uint64_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+			}
+			return intkernelU32((uint32_t*)p_R, (const uint32_t*)cp_A, (const uint32_t*)cp_B, csz_StrideB, csz_Count, cs32_Op, cs32_Mode);
+		default:
+			return -1;
+	}
+}
+
+#define ELEMENTWISE_OP_DEF(fn_Name, pfn_Name, s32_IntegerOp) \
  void fn_Name(vector_t* pv_Result, const vector_t* cpv_A, const vector_t* cpv_B) { \
   if(cpv_A == NULL || cpv_B == NULL || pv_Result == NULL) { \
 	printf("NULL REFERENCE PASSED!\n"); \
@@ -106,6 +620,20 @@ int vctcmp(const vector_t* cpv_A, const vector_t* cpv_B) {
     	printf("VECTORS NOT COMPATIBLE!\n"); \
     	return; \
 	} \
+  \
+	if (vctunique(pv_Result) != 0) { \
+		return; \
+	} \
+  \
+	if (pv_Result->s32_IntegerMode != INTEGER_MODE_WRAP && \
+	pv_Result->s32_Type == cpv_A->s32_Type && \
+	pv_Result->sz_ElementCount >= cpv_A->sz_ElementCount) { \
+  	int s32_Status = intkernel(pv_Result->p_StorageBuffer, cpv_A->p_StorageBuffer, cpv_B->p_StorageBuffer, 1, cpv_A->sz_ElementCount, cpv_A->s32_Type, s32_IntegerOp, pv_Result->s32_IntegerMode); \
+  	if (s32_Status >= 0) { \
+    	pv_Result->s32_OverflowFlag |= s32_Status; \
+    	return; \
+  	} \
+	} \
   \
 	uint8_t* pu8_A = (uint8_t*)cpv_A->pfn_Allocate(cpv_A->sz_ElementSize); \
 	if (!CHECK_ALLOCATION(pu8_A)) { \
@@ -142,10 +670,10 @@ int vctcmp(const vector_t* cpv_A, const vector_t* cpv_B) {
 	return; \
 }
 
-ELEMENTWISE_OP_DEF(vctadd, pfn_ElementAdd)
-ELEMENTWISE_OP_DEF(vctsub, pfn_ElementSubtract)
-ELEMENTWISE_OP_DEF(vctelemul, pfn_ElementMultiply)
-ELEMENTWISE_OP_DEF(vctelediv, pfn_ElementDivide)
+ELEMENTWISE_OP_DEF(vctadd, pfn_ElementAdd, INTEGER_OP_ADD)
+ELEMENTWISE_OP_DEF(vctsub, pfn_ElementSubtract, INTEGER_OP_SUB)
+ELEMENTWISE_OP_DEF(vctelemul, pfn_ElementMultiply, INTEGER_OP_MUL)
+ELEMENTWISE_OP_DEF(vctelediv, pfn_ElementDivide, INTEGER_OP_DIV)
 
 void vctdot(void* p_Product, const vector_t* cpv_A, const vector_t* cpv_B) {
     if (cpv_A == NULL || cpv_B == NULL || p_Product == NULL) {
@@ -202,7 +730,7 @@ void vctdot(void* p_Product, const vector_t* cpv_A, const vector_t* cpv_B) {
     return;
 }
 
-#define SCALE_OP_DEF(fn_Name, pfn_Name) \
+#define SCALE_OP_DEF(fn_Name, pfn_Name, s32_IntegerOp) \
 void fn_Name(void* pv_Scaled, const vector_t* cpv_Vector, const void* cp_Scalar) { \
   if(cpv_Vector == NULL || cp_Scalar == NULL || pv_Scaled == NULL) { \
     printf("NULL REFERENCE PASSED!\n"); \
@@ -215,6 +743,21 @@ void fn_Name(void* pv_Scaled, const vector_t* cpv_Vector, const void* cp_Scalar)
         return; \
     } \
   \
+  vector_t* pv_Result = (vector_t*)pv_Scaled; \
+  if (vctunique(pv_Result) != 0) { \
+    return; \
+  } \
+  if (pv_Result->s32_IntegerMode != INTEGER_MODE_WRAP && \
+      pv_Result->s32_Type == cpv_Vector->s32_Type && \
+      pv_Result->p_StorageBuffer != NULL && \
+      pv_Result->sz_ElementCount >= cpv_Vector->sz_ElementCount) { \
+    int s32_Status = intkernel(pv_Result->p_StorageBuffer, cpv_Vector->p_StorageBuffer, cp_Scalar, 0, cpv_Vector->sz_ElementCount, cpv_Vector->s32_Type, s32_IntegerOp, pv_Result->s32_IntegerMode); \
+    if (s32_Status >= 0) { \
+      pv_Result->s32_OverflowFlag |= s32_Status; \
+      return; \
+    } \
+  } \
+  \
   uint8_t* pu8_Element = (uint8_t*)cpv_Vector->pfn_Allocate(cpv_Vector->sz_ElementSize); \
   if (!CHECK_ALLOCATION(pu8_Element)) { \
     printf("MEMORY NOT FOUND!\n"); \
@@ -241,8 +784,8 @@ void fn_Name(void* pv_Scaled, const vector_t* cpv_Vector, const void* cp_Scalar)
     return; \
 }
 
-SCALE_OP_DEF(vctscale, pfn_ElementMultiply)
-SCALE_OP_DEF(vctscaleinv, pfn_ElementDivide)
+SCALE_OP_DEF(vctscale, pfn_ElementMultiply, INTEGER_OP_MUL)
+SCALE_OP_DEF(vctscaleinv, pfn_ElementDivide, INTEGER_OP_DIV)
 
 // Since there is no abstract way to take square roots AFAIK, we will return the squared magnitude
 void vctmagsq(void* p_Magnitude, const vector_t* cpv_Vector) {
@@ -300,6 +843,25 @@ void vctnorm(vector_t* pv_Normalized, const vector_t* cpv_Vector, void (*pfn_Squ
     return;
 }
 
+int vctovfchk(const vector_t* cpv_Vector) {
+    if (cpv_Vector == NULL) {
+        printf("NULL REFERENCE PASSED!\n");
+        return -1;
+    }
+
+    return (cpv_Vector->s32_OverflowFlag != 0) ? 1 : 0;
+}
+
+void vctovfclr(vector_t* pv_Vector) {
+    if (pv_Vector == NULL) {
+        printf("NULL REFERENCE PASSED!\n");
+        return;
+    }
+
+    pv_Vector->s32_OverflowFlag = 0;
+    return;
+}
+
 void vctdstry(vector_t* pv_Vector) {
     if (pv_Vector == NULL) {
         printf("NULL REFERENCE PASSED!\n");
@@ -307,7 +869,7 @@ void vctdstry(vector_t* pv_Vector) {
     }
 
     if (pv_Vector->p_StorageBuffer != NULL) {
-        pv_Vector->pfn_Free(pv_Vector->p_StorageBuffer);
+        bufrelease(pv_Vector->p_StorageBuffer, &pv_Vector->psz_References, pv_Vector->pfn_Free);
         pv_Vector->sz_BufferSize = 0;
     }
     return;
@@ -1,16 +1,1758 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 #include <lin99/matrix.h>
+#include <lin99/search.h>
+#include <lin99/quant.h>
+#include <lin99/plan.h>
+#include <lin99/parallel.h>
+#include <lin99/memory.h>
+#include <lin99/fill.h>
+#include <lin99/async.h>
+#include <lin99/conv.h>
+#include <lin99/tensor.h>
 
 USE_ARITHMETIC_OP_SET_FP32
+USE_ARITHMETIC_OP_SET_FP64
+USE_ARITHMETIC_OP_SET_S8
+USE_ARITHMETIC_OP_SET_U8
+USE_ARITHMETIC_OP_SET_S16
+USE_ARITHMETIC_OP_SET_U16
+USE_ARITHMETIC_OP_SET_U32
 
 #define VECTOR_LEN 32
 
+static int s32_Failures = 0;
+
+// Records a failed check and keeps going, so one run reports every broken area
+#define CHECK(cond) \
+do { \
+	if (!(cond)) { \
+		printf("CHECK FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		++s32_Failures; \
+	} \
+} while (0)
+
+// Close enough for values produced by a few dozen floating-point operations
+#define CHECK_NEAR(a, b, tol) CHECK(fabs((double)(a) - (double)(b)) <= (tol) * (1.0 + fabs((double)(b))))
+
+// Copies sz_ElementCount elements of the vector's type from cp_Values into the vector
+static void vctset(vector_t* pv_Vector, const void* cp_Values) {
+	for (size_t sz_Idx = 0; sz_Idx < pv_Vector->sz_ElementCount; ++sz_Idx) {
+		vctwrite(pv_Vector, sz_Idx, (void*)((const uint8_t*)cp_Values + sz_Idx * pv_Vector->sz_ElementSize));
+	}
+}
+
+// Non-zero when every element of the vector matches cp_Expected bit for bit
+static int vctequals(const vector_t* cpv_Vector, const void* cp_Expected) {
+	uint8_t a_Element[16];
+
+	for (size_t sz_Idx = 0; sz_Idx < cpv_Vector->sz_ElementCount; ++sz_Idx) {
+		vctread(a_Element, cpv_Vector, sz_Idx);
+		if (memcmp(a_Element, (const uint8_t*)cp_Expected + sz_Idx * cpv_Vector->sz_ElementSize, cpv_Vector->sz_ElementSize) != 0) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Deterministic values in [-1, 1) from a 32-bit LCG, so every run sees the same "random" operands
+static double testnoise(uint32_t* pu32_State) {
+	*pu32_State = *pu32_State * 1664525u + 1013904223u;
+	return (double)(*pu32_State >> 8) / 8388608.0 - 1.0;
+}
+
+// Recreates a matrix made by MAKE_MATRIX_FAST with another layout and leading dimension (0 for packed)
+static void mtxrelayout(matrix_t* pm_Matrix, const int cs32_Layout, const size_t csz_LeadingDim) {
+	mtxdstry(pm_Matrix);
+	pm_Matrix->s32_Layout = cs32_Layout;
+	pm_Matrix->sz_LeadingDim = csz_LeadingDim;
+	mtxcreate(pm_Matrix, NULL, NULL);
+}
+
+/*
+ * Five 3-dimensional embeddings whose top 3 differ between metrics:
+ * for q0 = (1, 1, 0) DOT and COSINE rank columns 2, 1, 0 while L2 ranks 0, 1, 3,
+ * for q1 = (0.1, 0, -2) DOT ranks 3, 2, 0, COSINE 3, 0, 2 and L2 3, 0, 1.
+ */
+static const double a_Corpus[5][3] = { { 1, 0, 0 }, { 0.2, 2, 0 }, { 3, 3, 0 }, { 0, 0, -1 }, { 0.25, 0.5, 2 } };
+static const double a_Queries[2][3] = { { 1, 1, 0 }, { 0.1, 0, -2 } };
+
+static void testknn(void) {
+	const size_t a_Expected[3][2][3] = {
+		{ { 2, 1, 0 }, { 3, 2, 0 } },
+		{ { 2, 1, 0 }, { 3, 0, 2 } },
+		{ { 0, 1, 3 }, { 3, 0, 1 } }
+	};
+	const double a_Scores[3][2][3] = {
+		{ { 6, 2.2, 1 }, { 2, 0.3, 0.1 } },
+		{ { 1, 0.77395, 0.70711 }, { 0.99875, 0.04994, 0.03531 } },
+		{ { 1, 1.64, 3 }, { 1.01, 4.81, 8.01 } }
+	};
+	const int a_Metrics[3] = { KNN_METRIC_DOT, KNN_METRIC_COSINE, KNN_METRIC_L2 };
+
+	MAKE_MATRIX_FAST(m_Corpus64, double, 5, 3, FP64)
+	MAKE_MATRIX_FAST(m_Queries64, double, 2, 3, FP64)
+	MAKE_MATRIX_FAST(m_Corpus32, float, 5, 3, FP32)
+	MAKE_VECTOR_FAST(v_Query32, float, 3, FP32)
+
+	for (size_t sz_Col = 0; sz_Col < 5; ++sz_Col) {
+		for (size_t sz_Row = 0; sz_Row < 3; ++sz_Row) {
+			double f64_Value = a_Corpus[sz_Col][sz_Row];
+			float f32_Value = (float)f64_Value;
+			mtxwrite(&m_Corpus64, sz_Row, sz_Col, &f64_Value);
+			mtxwrite(&m_Corpus32, sz_Row, sz_Col, &f32_Value);
+		}
+	}
+	for (size_t sz_Row = 0; sz_Row < 3; ++sz_Row) {
+		double f64_Value = a_Queries[0][sz_Row];
+		float f32_Value = (float)f64_Value;
+		mtxwrite(&m_Queries64, sz_Row, 0, &f64_Value);
+		f64_Value = a_Queries[1][sz_Row];
+		mtxwrite(&m_Queries64, sz_Row, 1, &f64_Value);
+		vctwrite(&v_Query32, sz_Row, &f32_Value);
+	}
+
+	for (size_t sz_Metric = 0; sz_Metric < 3; ++sz_Metric) {
+		size_t a_Indices[6];
+		double a_Found64[6];
+		float a_Found32[3];
+
+		CHECK(mtxknn(a_Indices, a_Found64, &m_Corpus64, &m_Queries64, 3, a_Metrics[sz_Metric]) == 0);
+		for (size_t sz_Query = 0; sz_Query < 2; ++sz_Query) {
+			for (size_t sz_Rank = 0; sz_Rank < 3; ++sz_Rank) {
+				CHECK(a_Indices[sz_Query * 3 + sz_Rank] == a_Expected[sz_Metric][sz_Query][sz_Rank]);
+				CHECK_NEAR(a_Found64[sz_Query * 3 + sz_Rank], a_Scores[sz_Metric][sz_Query][sz_Rank], 1e-4);
+			}
+		}
+
+		CHECK(mtxknnvct(a_Indices, a_Found32, &m_Corpus32, &v_Query32, 3, a_Metrics[sz_Metric]) == 0);
+		for (size_t sz_Rank = 0; sz_Rank < 3; ++sz_Rank) {
+			CHECK(a_Indices[sz_Rank] == a_Expected[sz_Metric][0][sz_Rank]);
+			CHECK_NEAR(a_Found32[sz_Rank], a_Scores[sz_Metric][0][sz_Rank], 1e-4);
+		}
+	}
+
+	// k larger than the corpus and mismatched embedding sizes are rejected
+	size_t a_Indices[6];
+	CHECK(mtxknn(a_Indices, NULL, &m_Corpus64, &m_Queries64, 6, KNN_METRIC_DOT) != 0);
+	CHECK(mtxknnvct(a_Indices, NULL, &m_Corpus64, &v_Query32, 3, KNN_METRIC_DOT) != 0);
+
+	mtxdstry(&m_Corpus64);
+	mtxdstry(&m_Queries64);
+	mtxdstry(&m_Corpus32);
+	vctdstry(&v_Query32);
+}
+
+static void testintegermodes(void) {
+	const int16_t a_A16[5] = { 32767, -32768, 300, -5, -32768 };
+	const int16_t a_B16[5] = { 1, 1, 200, 0, -1 };
+	const int16_t a_Add16[5] = { 32767, -32767, 500, -5, -32768 };
+	const int16_t a_Sub16[5] = { 32766, -32768, 100, -5, -32767 };
+	const int16_t a_Mul16[5] = { 32767, -32768, 32767, 0, 32767 };
+	const int16_t a_Div16[5] = { 32767, -32768, 1, 0, 32767 };
+	const int16_t a_Wrap16[5] = { -32768, -32767, 500, -5, 32767 };
+
+	MAKE_VECTOR_FAST(v_A16, int16_t, 5, S16)
+	MAKE_VECTOR_FAST(v_B16, int16_t, 5, S16)
+	MAKE_VECTOR_FAST(v_R16, int16_t, 5, S16)
+	vctset(&v_A16, a_A16);
+	vctset(&v_B16, a_B16);
+
+	v_R16.s32_IntegerMode = INTEGER_MODE_SATURATE;
+	vctadd(&v_R16, &v_A16, &v_B16);
+	CHECK(vctequals(&v_R16, a_Add16));
+	vctsub(&v_R16, &v_A16, &v_B16);
+	CHECK(vctequals(&v_R16, a_Sub16));
+	vctelemul(&v_R16, &v_A16, &v_B16);
+	CHECK(vctequals(&v_R16, a_Mul16));
+	vctelediv(&v_R16, &v_A16, &v_B16);
+	CHECK(vctequals(&v_R16, a_Div16));
+	CHECK(vctovfchk(&v_R16) == 0);
+
+	v_R16.s32_IntegerMode = INTEGER_MODE_CHECKED;
+	vctadd(&v_R16, &v_A16, &v_B16);
+	CHECK(vctequals(&v_R16, a_Wrap16));
+	CHECK(vctovfchk(&v_R16) == 1);
+	vctovfclr(&v_R16);
+	CHECK(vctovfchk(&v_R16) == 0);
+	vctadd(&v_R16, &v_B16, &v_B16);
+	CHECK(vctovfchk(&v_R16) == 0);
+	vctelediv(&v_R16, &v_B16, &v_B16);
+	CHECK(vctovfchk(&v_R16) == 1);
+
+	const uint8_t a_A8[4] = { 250, 3, 16, 9 };
+	const uint8_t a_B8[4] = { 10, 5, 16, 0 };
+	const uint8_t a_Add8[4] = { 255, 8, 32, 9 };
+	const uint8_t a_Sub8[4] = { 240, 0, 0, 9 };
+	const uint8_t a_Mul8[4] = { 255, 15, 255, 0 };
+	const uint8_t a_Div8[4] = { 25, 0, 1, 0 };
+	const uint8_t a_Wrap8[4] = { 240, 254, 0, 9 };
+
+	MAKE_VECTOR_FAST(v_A8, uint8_t, 4, U8)
+	MAKE_VECTOR_FAST(v_B8, uint8_t, 4, U8)
+	MAKE_VECTOR_FAST(v_R8, uint8_t, 4, U8)
+	vctset(&v_A8, a_A8);
+	vctset(&v_B8, a_B8);
+
+	v_R8.s32_IntegerMode = INTEGER_MODE_SATURATE;
+	vctadd(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Add8));
+	vctsub(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Sub8));
+	vctelemul(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Mul8));
+	vctelediv(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Div8));
+
+	v_R8.s32_IntegerMode = INTEGER_MODE_CHECKED;
+	vctsub(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Wrap8));
+	CHECK(vctovfchk(&v_R8) == 1);
+	vctovfclr(&v_R8);
+	vctelediv(&v_R8, &v_A8, &v_B8);
+	CHECK(vctequals(&v_R8, a_Div8));
+	CHECK(vctovfchk(&v_R8) == 1);
+
+	// The unsigned 32-bit product only fits the unsigned 64-bit wide type
+	const uint32_t a_A32[2] = { UINT32_MAX, 65536 };
+	const uint32_t a_B32[2] = { 2, 65535 };
+	const uint32_t a_Mul32[2] = { UINT32_MAX, 4294901760u };
+	const uint32_t u32_Two = 2;
+
+	MAKE_VECTOR_FAST(v_A32, uint32_t, 2, U32)
+	MAKE_VECTOR_FAST(v_B32, uint32_t, 2, U32)
+	MAKE_VECTOR_FAST(v_R32, uint32_t, 2, U32)
+	vctset(&v_A32, a_A32);
+	vctset(&v_B32, a_B32);
+
+	v_R32.s32_IntegerMode = INTEGER_MODE_SATURATE;
+	vctelemul(&v_R32, &v_A32, &v_B32);
+	CHECK(vctequals(&v_R32, a_Mul32));
+	v_R32.s32_IntegerMode = INTEGER_MODE_CHECKED;
+	vctscale(&v_R32, &v_B32, &u32_Two);
+	CHECK(vctovfchk(&v_R32) == 0);
+	vctscale(&v_R32, &v_A32, &u32_Two);
+	CHECK(vctovfchk(&v_R32) == 1);
+
+	// 37 elements run the packed 8/16-bit saturating path over whole registers and the widening loop on the tail
+	int8_t a_LongA8[37], a_LongB8[37], a_LongAdd8[37], a_LongSub8[37];
+	uint16_t a_LongA16[37], a_LongB16[37], a_LongAdd16[37], a_LongSub16[37];
+	for (int s32_Idx = 0; s32_Idx < 37; ++s32_Idx) {
+		const int cs32_A8 = (s32_Idx * 53) % 256 - 128, cs32_B8 = (s32_Idx * 97 + 31) % 256 - 128;
+		const long cl_A16 = (s32_Idx * 40009L) % 65536, cl_B16 = (s32_Idx * 25013L + 7919) % 65536;
+		a_LongA8[s32_Idx] = (int8_t)cs32_A8;
+		a_LongB8[s32_Idx] = (int8_t)cs32_B8;
+		a_LongAdd8[s32_Idx] = (int8_t)((cs32_A8 + cs32_B8 > 127) ? 127 : ((cs32_A8 + cs32_B8 < -128) ? -128 : cs32_A8 + cs32_B8));
+		a_LongSub8[s32_Idx] = (int8_t)((cs32_A8 - cs32_B8 > 127) ? 127 : ((cs32_A8 - cs32_B8 < -128) ? -128 : cs32_A8 - cs32_B8));
+		a_LongA16[s32_Idx] = (uint16_t)cl_A16;
+		a_LongB16[s32_Idx] = (uint16_t)cl_B16;
+		a_LongAdd16[s32_Idx] = (uint16_t)((cl_A16 + cl_B16 > 65535) ? 65535 : cl_A16 + cl_B16);
+		a_LongSub16[s32_Idx] = (uint16_t)((cl_A16 < cl_B16) ? 0 : cl_A16 - cl_B16);
+	}
+
+	MAKE_VECTOR_FAST(v_LongA8, int8_t, 37, S8)
+	MAKE_VECTOR_FAST(v_LongB8, int8_t, 37, S8)
+	MAKE_VECTOR_FAST(v_LongR8, int8_t, 37, S8)
+	MAKE_VECTOR_FAST(v_LongA16, uint16_t, 37, U16)
+	MAKE_VECTOR_FAST(v_LongB16, uint16_t, 37, U16)
+	MAKE_VECTOR_FAST(v_LongR16, uint16_t, 37, U16)
+	vctset(&v_LongA8, a_LongA8);
+	vctset(&v_LongB8, a_LongB8);
+	vctset(&v_LongA16, a_LongA16);
+	vctset(&v_LongB16, a_LongB16);
+
+	v_LongR8.s32_IntegerMode = INTEGER_MODE_SATURATE;
+	v_LongR16.s32_IntegerMode = INTEGER_MODE_SATURATE;
+	vctadd(&v_LongR8, &v_LongA8, &v_LongB8);
+	CHECK(vctequals(&v_LongR8, a_LongAdd8));
+	vctsub(&v_LongR8, &v_LongA8, &v_LongB8);
+	CHECK(vctequals(&v_LongR8, a_LongSub8));
+	vctadd(&v_LongR16, &v_LongA16, &v_LongB16);
+	CHECK(vctequals(&v_LongR16, a_LongAdd16));
+	vctsub(&v_LongR16, &v_LongA16, &v_LongB16);
+	CHECK(vctequals(&v_LongR16, a_LongSub16));
+
+	vctdstry(&v_LongA8);
+	vctdstry(&v_LongB8);
+	vctdstry(&v_LongR8);
+	vctdstry(&v_LongA16);
+	vctdstry(&v_LongB16);
+	vctdstry(&v_LongR16);
+	vctdstry(&v_A16);
+	vctdstry(&v_B16);
+	vctdstry(&v_R16);
+	vctdstry(&v_A8);
+	vctdstry(&v_B8);
+	vctdstry(&v_R8);
+	vctdstry(&v_A32);
+	vctdstry(&v_B32);
+	vctdstry(&v_R32);
+}
+
+// Codes are read back through mtxread, so the expected product is computed independently of the kernels
+static double qreference(const matrix_t* cpm_A, const size_t csz_ColA, const float cf32_ScaleA, const int32_t cs32_ZeroPointA,
+	const matrix_t* cpm_B, const size_t csz_ColB, const float cf32_ScaleB, const int32_t cs32_ZeroPointB) {
+	double f64_Sum = 0.0;
+
+	for (size_t sz_Row = 0; sz_Row < cpm_A->sz_Height; ++sz_Row) {
+		uint8_t u8_A, u8_B;
+		mtxread(&u8_A, cpm_A, sz_Row, csz_ColA);
+		mtxread(&u8_B, cpm_B, sz_Row, csz_ColB);
+		const int32_t cs32_A = (cpm_A->s32_Type == TYPE_S8) ? (int32_t)(int8_t)u8_A : (int32_t)u8_A;
+		const int32_t cs32_B = (cpm_B->s32_Type == TYPE_S8) ? (int32_t)(int8_t)u8_B : (int32_t)u8_B;
+		f64_Sum += (double)(cs32_A - cs32_ZeroPointA) * (double)(cs32_B - cs32_ZeroPointB);
+	}
+	return f64_Sum * cf32_ScaleA * cf32_ScaleB;
+}
+
+static void testquant(void) {
+	MAKE_VECTOR_FAST(v_Source, float, 64, FP32)
+	MAKE_VECTOR_FAST(v_Signed, int8_t, 64, S8)
+	MAKE_VECTOR_FAST(v_Unsigned, uint8_t, 64, U8)
+	float f32_Scale, f32_ScaleU;
+	int32_t s32_ZeroPoint;
+
+	// Symmetric S8: the largest magnitude maps to 127 and every value comes back within half a step
+	for (size_t sz_Idx = 0; sz_Idx < 64; ++sz_Idx) {
+		float f32_Value = (float)sz_Idx / 63.0f * 2.7f - 1.5f;
+		vctwrite(&v_Source, sz_Idx, &f32_Value);
+	}
+	CHECK(vctquantize(&v_Signed, &f32_Scale, NULL, &v_Source) == 0);
+	CHECK_NEAR(f32_Scale, 1.5 / 127.0, 1e-6);
+	for (size_t sz_Idx = 0; sz_Idx < 64; ++sz_Idx) {
+		float f32_Value;
+		int8_t s8_Code;
+		vctread(&f32_Value, &v_Source, sz_Idx);
+		vctread(&s8_Code, &v_Signed, sz_Idx);
+		CHECK(fabs(f32_Scale * s8_Code - f32_Value) <= 0.5 * f32_Scale + 1e-6);
+	}
+
+	// Asymmetric U8: 0.0 is represented exactly by the zero point
+	for (size_t sz_Idx = 0; sz_Idx < 64; ++sz_Idx) {
+		float f32_Value = (float)sz_Idx / 63.0f * 2.5f - 0.5f;
+		vctwrite(&v_Source, sz_Idx, &f32_Value);
+	}
+	CHECK(vctquantize(&v_Unsigned, &f32_ScaleU, NULL, &v_Source) != 0);
+	CHECK(vctquantize(&v_Unsigned, &f32_ScaleU, &s32_ZeroPoint, &v_Source) == 0);
+	CHECK_NEAR(f32_ScaleU, 2.5 / 255.0, 1e-6);
+	CHECK(s32_ZeroPoint == 51);
+	for (size_t sz_Idx = 0; sz_Idx < 64; ++sz_Idx) {
+		float f32_Value;
+		uint8_t u8_Code;
+		vctread(&f32_Value, &v_Source, sz_Idx);
+		vctread(&u8_Code, &v_Unsigned, sz_Idx);
+		CHECK(fabs(f32_ScaleU * ((int32_t)u8_Code - s32_ZeroPoint) - f32_Value) <= 0.5 * f32_ScaleU + 1e-6);
+	}
+
+	// The dequantized dot product equals the dot product of the represented values
+	float f32_Product;
+	double f64_Expected = 0.0;
+	for (size_t sz_Idx = 0; sz_Idx < 64; ++sz_Idx) {
+		int8_t s8_Code;
+		uint8_t u8_Code;
+		vctread(&s8_Code, &v_Signed, sz_Idx);
+		vctread(&u8_Code, &v_Unsigned, sz_Idx);
+		f64_Expected += (double)f32_Scale * s8_Code * (double)f32_ScaleU * ((int32_t)u8_Code - s32_ZeroPoint);
+	}
+	CHECK(vctqdot(&f32_Product, &v_Unsigned, f32_ScaleU, s32_ZeroPoint, &v_Signed, f32_Scale, 0) == 0);
+	CHECK_NEAR(f32_Product, f64_Expected, 1e-5);
+
+	// 32-bit accumulation: sums far beyond the element range stay exact, and saturate past INT32_MAX
+	MAKE_VECTOR_FAST(v_Long, uint8_t, 40000, U8)
+	MAKE_VECTOR_FAST(v_LongS, int8_t, 40000, S8)
+	const uint8_t cu8_Max = 255;
+	const int8_t cs8_Min = -128;
+	int32_t s32_Dot;
+	for (size_t sz_Idx = 0; sz_Idx < 40000; ++sz_Idx) {
+		vctwrite(&v_Long, sz_Idx, (void*)&cu8_Max);
+		vctwrite(&v_LongS, sz_Idx, (void*)&cs8_Min);
+	}
+	CHECK(vctdots32(&s32_Dot, &v_LongS, &v_LongS) == 0);
+	CHECK(s32_Dot == 128 * 128 * 40000);
+	CHECK(vctdots32(&s32_Dot, &v_Long, &v_LongS) == 0);
+	CHECK(s32_Dot == -255 * 128 * 40000);
+	CHECK(vctdots32(&s32_Dot, &v_Long, &v_Long) == 0);
+	CHECK(s32_Dot == INT32_MAX);
+	CHECK(vctdots32(&s32_Dot, &v_Long, &v_Signed) != 0);
+
+	// A column-major U8 corpus against a row-major S8 query block with a partial tile and a tail
+	MAKE_MATRIX_FAST(m_CorpusF, float, 37, 100, FP32)
+	MAKE_MATRIX_FAST(m_Corpus, uint8_t, 37, 100, U8)
+	matrix_t m_QueriesF = {0};
+	m_QueriesF.s32_Type = TYPE_FP32;
+	m_QueriesF.sz_ElementSize = sizeof(float);
+	m_QueriesF.sz_Width = 11;
+	m_QueriesF.sz_Height = 100;
+	m_QueriesF.s32_Layout = MATRIX_LAYOUT_ROW_MAJOR;
+	mtxcreate(&m_QueriesF, NULL, NULL);
+	matrix_t m_Queries = m_QueriesF;
+	m_Queries.s32_Type = TYPE_S8;
+	m_Queries.sz_ElementSize = sizeof(int8_t);
+	m_Queries.sz_LeadingDim = 0;
+	mtxcreate(&m_Queries, NULL, NULL);
+	MAKE_MATRIX_FAST(m_Scores, float, 11, 37, FP32)
+	float a_ScalesA[37], a_ScalesB[11];
+	int32_t a_ZeroPointsA[37];
+
+	for (size_t sz_Row = 0; sz_Row < 100; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 37; ++sz_Col) {
+			float f32_Value = (float)((sz_Row * 7 + sz_Col * 13) % 29) / 7.0f - 1.0f;
+			mtxwrite(&m_CorpusF, sz_Row, sz_Col, &f32_Value);
+		}
+		for (size_t sz_Col = 0; sz_Col < 11; ++sz_Col) {
+			float f32_Value = (float)((sz_Row * 5 + sz_Col * 3) % 17) / 4.0f - 2.0f;
+			mtxwrite(&m_QueriesF, sz_Row, sz_Col, &f32_Value);
+		}
+	}
+	CHECK(mtxquantize(&m_Corpus, a_ScalesA, a_ZeroPointsA, &m_CorpusF) == 0);
+	CHECK(mtxquantize(&m_Queries, a_ScalesB, NULL, &m_QueriesF) == 0);
+	for (size_t sz_Row = 0; sz_Row < 100; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 11; ++sz_Col) {
+			float f32_Value;
+			int8_t s8_Code;
+			mtxread(&f32_Value, &m_QueriesF, sz_Row, sz_Col);
+			mtxread(&s8_Code, &m_Queries, sz_Row, sz_Col);
+			CHECK(fabs(a_ScalesB[sz_Col] * s8_Code - f32_Value) <= 0.5 * a_ScalesB[sz_Col] + 1e-6);
+		}
+	}
+
+	CHECK(mtxqgemm(&m_Scores, &m_Corpus, a_ScalesA, a_ZeroPointsA, &m_Queries, a_ScalesB, NULL) == 0);
+	for (size_t sz_Row = 0; sz_Row < 37; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 11; ++sz_Col) {
+			float f32_Score;
+			mtxread(&f32_Score, &m_Scores, sz_Row, sz_Col);
+			CHECK_NEAR(f32_Score, qreference(&m_Corpus, sz_Row, a_ScalesA[sz_Row], a_ZeroPointsA[sz_Row], &m_Queries, sz_Col, a_ScalesB[sz_Col], 0), 1e-5);
+		}
+	}
+	CHECK(mtxqgemm(&m_Scores, &m_Queries, a_ScalesB, NULL, &m_Corpus, a_ScalesA, a_ZeroPointsA) != 0);
+
+	vctdstry(&v_Source);
+	vctdstry(&v_Signed);
+	vctdstry(&v_Unsigned);
+	vctdstry(&v_Long);
+	vctdstry(&v_LongS);
+	mtxdstry(&m_CorpusF);
+	mtxdstry(&m_Corpus);
+	mtxdstry(&m_QueriesF);
+	mtxdstry(&m_Queries);
+	mtxdstry(&m_Scores);
+}
+
+// Every pairing of 8-bit types, at lengths around the 32-element lane width and past one QDOT_BLOCK spill, against
+// a naive sum: configured with LIN99_NATIVE this runs the AVX2/VNNI kernels, otherwise the portable loop
+static void testqdots(void) {
+	static uint8_t a_BytesA[2 * 16384 + 45], a_BytesB[2 * 16384 + 45];
+	const size_t a_Lengths[6] = { 1, 31, 32, 33, 100, 2 * 16384 + 45 };
+	const uint8_t a_Extremes[4] = { 0x00, 0x7F, 0x80, 0xFF };
+	uint32_t u32_State = 28;
+
+	for (size_t sz_Idx = 0; sz_Idx < 2 * 16384 + 45; ++sz_Idx) {
+		a_BytesA[sz_Idx] = (uint8_t)((testnoise(&u32_State) + 1.0) * 128.0);
+		a_BytesB[sz_Idx] = (sz_Idx % 5 == 0) ? a_Extremes[(sz_Idx / 5) % 4] : (uint8_t)((testnoise(&u32_State) + 1.0) * 128.0);
+	}
+
+	for (size_t sz_Length = 0; sz_Length < 6; ++sz_Length) {
+		const size_t csz_N = a_Lengths[sz_Length];
+		MAKE_VECTOR_FAST(v_SA, int8_t, csz_N, S8)
+		MAKE_VECTOR_FAST(v_UA, uint8_t, csz_N, U8)
+		MAKE_VECTOR_FAST(v_SB, int8_t, csz_N, S8)
+		MAKE_VECTOR_FAST(v_UB, uint8_t, csz_N, U8)
+		const vector_t* a_A[2] = { &v_SA, &v_UA };
+		const vector_t* a_B[2] = { &v_SB, &v_UB };
+		vctset(&v_SA, a_BytesA);
+		vctset(&v_UA, a_BytesA);
+		vctset(&v_SB, a_BytesB);
+		vctset(&v_UB, a_BytesB);
+
+		for (size_t sz_Pair = 0; sz_Pair < 4; ++sz_Pair) {
+			const int cs32_UnsignedA = (int)(sz_Pair / 2), cs32_UnsignedB = (int)(sz_Pair % 2);
+			int64_t s64_Expected = 0;
+			int32_t s32_Dot;
+
+			for (size_t sz_Idx = 0; sz_Idx < csz_N; ++sz_Idx) {
+				const int64_t cs64_A = cs32_UnsignedA ? (int64_t)a_BytesA[sz_Idx] : (int64_t)(int8_t)a_BytesA[sz_Idx];
+				const int64_t cs64_B = cs32_UnsignedB ? (int64_t)a_BytesB[sz_Idx] : (int64_t)(int8_t)a_BytesB[sz_Idx];
+				s64_Expected += cs64_A * cs64_B;
+			}
+			CHECK(vctdots32(&s32_Dot, a_A[cs32_UnsignedA], a_B[cs32_UnsignedB]) == 0);
+			CHECK(s32_Dot == s64_Expected);
+		}
+
+		vctdstry(&v_SA);
+		vctdstry(&v_UA);
+		vctdstry(&v_SB);
+		vctdstry(&v_UB);
+	}
+}
+
+// Runs one plan under every flag combination and compares it with the unplanned vctadd/vctelemul result
+static void planmatches(vector_t* pv_Result, vector_t* pv_Expected, const vector_t* cpv_A, const vector_t* cpv_B, const int cs32_Operation) {
+	const int a_Flags[4] = { PLAN_FLAG_NONE, PLAN_FLAG_SERIAL, PLAN_FLAG_CALLBACK, PLAN_FLAG_CALLBACK | PLAN_FLAG_SERIAL };
+	vctplan_t vp_Plan;
+
+	if (cs32_Operation == PLAN_OP_ADD) {
+		vctadd(pv_Expected, cpv_A, cpv_B);
+	} else {
+		vctelemul(pv_Expected, cpv_A, cpv_B);
+	}
+
+	for (size_t sz_Flag = 0; sz_Flag < 4; ++sz_Flag) {
+		memset(pv_Result->p_StorageBuffer, 0, pv_Result->sz_ElementCount * pv_Result->sz_ElementSize);
+		CHECK(vctplancreate(&vp_Plan, cs32_Operation, cpv_A, cpv_B, pv_Result, a_Flags[sz_Flag]) == 0);
+		vctplanexec(&vp_Plan, pv_Result, cpv_A, cpv_B);
+		CHECK(memcmp(pv_Result->p_StorageBuffer, pv_Expected->p_StorageBuffer, pv_Result->sz_ElementCount * pv_Result->sz_ElementSize) == 0);
+	}
+}
+
+// Long enough to be split across threads, with 16-bit products that overflow int when promoted
+static void testplan(void) {
+	const size_t csz_Count = 3 * 65536 + 17;
+
+	MAKE_VECTOR_FAST(v_S16A, int16_t, csz_Count, S16)
+	MAKE_VECTOR_FAST(v_S16B, int16_t, csz_Count, S16)
+	MAKE_VECTOR_FAST(v_S16R, int16_t, csz_Count, S16)
+	MAKE_VECTOR_FAST(v_S16E, int16_t, csz_Count, S16)
+	MAKE_VECTOR_FAST(v_U16A, uint16_t, csz_Count, U16)
+	MAKE_VECTOR_FAST(v_U16B, uint16_t, csz_Count, U16)
+	MAKE_VECTOR_FAST(v_U16R, uint16_t, csz_Count, U16)
+	MAKE_VECTOR_FAST(v_U16E, uint16_t, csz_Count, U16)
+	MAKE_VECTOR_FAST(v_F32A, float, csz_Count, FP32)
+	MAKE_VECTOR_FAST(v_F32B, float, csz_Count, FP32)
+	MAKE_VECTOR_FAST(v_F32R, float, csz_Count, FP32)
+	MAKE_VECTOR_FAST(v_F32E, float, csz_Count, FP32)
+
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+		int16_t s16_A = (sz_Idx % 5 == 0) ? INT16_MIN : (int16_t)(uint16_t)(sz_Idx * 40503u);
+		int16_t s16_B = (sz_Idx % 7 == 0) ? INT16_MAX : (int16_t)(uint16_t)(sz_Idx * 2654435761u >> 16);
+		uint16_t u16_A = (sz_Idx % 3 == 0) ? UINT16_MAX : (uint16_t)(sz_Idx * 40503u);
+		uint16_t u16_B = (uint16_t)(sz_Idx * 2654435761u >> 16);
+		float f32_A = (float)(sz_Idx % 1000) * 0.25f - 100.0f;
+		float f32_B = (float)(sz_Idx % 37) * 1.5f + 0.5f;
+
+		vctwrite(&v_S16A, sz_Idx, &s16_A);
+		vctwrite(&v_S16B, sz_Idx, &s16_B);
+		vctwrite(&v_U16A, sz_Idx, &u16_A);
+		vctwrite(&v_U16B, sz_Idx, &u16_B);
+		vctwrite(&v_F32A, sz_Idx, &f32_A);
+		vctwrite(&v_F32B, sz_Idx, &f32_B);
+	}
+
+	planmatches(&v_S16R, &v_S16E, &v_S16A, &v_S16B, PLAN_OP_ADD);
+	planmatches(&v_S16R, &v_S16E, &v_S16A, &v_S16B, PLAN_OP_MUL);
+	planmatches(&v_U16R, &v_U16E, &v_U16A, &v_U16B, PLAN_OP_ADD);
+	planmatches(&v_U16R, &v_U16E, &v_U16A, &v_U16B, PLAN_OP_MUL);
+	planmatches(&v_F32R, &v_F32E, &v_F32A, &v_F32B, PLAN_OP_ADD);
+	planmatches(&v_F32R, &v_F32E, &v_F32A, &v_F32B, PLAN_OP_MUL);
+
+	// -32768 * 32767 and 65535 * x wrap to -32768 and -x in their own types
+	int16_t s16_Product;
+	uint16_t u16_Product;
+	vctread(&s16_Product, &v_S16R, 0);
+	CHECK(s16_Product == INT16_MIN);
+	vctread(&u16_Product, &v_U16R, 3);
+	CHECK(u16_Product == (uint16_t)(0u - (uint16_t)(3u * 2654435761u >> 16)));
+
+	vctplan_t vp_Plan;
+	CHECK(vctplancreate(&vp_Plan, PLAN_OP_ADD, &v_S16A, &v_U16B, &v_S16R, PLAN_FLAG_NONE) != 0);
+
+	vctdstry(&v_S16A);
+	vctdstry(&v_S16B);
+	vctdstry(&v_S16R);
+	vctdstry(&v_S16E);
+	vctdstry(&v_U16A);
+	vctdstry(&v_U16B);
+	vctdstry(&v_U16R);
+	vctdstry(&v_U16E);
+	vctdstry(&v_F32A);
+	vctdstry(&v_F32B);
+	vctdstry(&v_F32R);
+	vctdstry(&v_F32E);
+}
+
+// R^T R of an n x n column-major R against A^T A computed directly, relative to the largest entry of A^T A
+static double qrgramerror(const matrix_t* cpm_R, const matrix_t* cpm_A) {
+	double f64_Largest = 0.0, f64_Error = 0.0;
+
+	for (size_t sz_I = 0; sz_I < cpm_A->sz_Width; ++sz_I) {
+		for (size_t sz_J = 0; sz_J < cpm_A->sz_Width; ++sz_J) {
+			double f64_Gram = 0.0, f64_Product = 0.0;
+			for (size_t sz_Row = 0; sz_Row < cpm_A->sz_Height; ++sz_Row) {
+				double f64_Left, f64_Right;
+				mtxread(&f64_Left, cpm_A, sz_Row, sz_I);
+				mtxread(&f64_Right, cpm_A, sz_Row, sz_J);
+				f64_Gram += f64_Left * f64_Right;
+			}
+			for (size_t sz_K = 0; sz_K < cpm_R->sz_Height; ++sz_K) {
+				double f64_Left, f64_Right;
+				mtxread(&f64_Left, cpm_R, sz_K, sz_I);
+				mtxread(&f64_Right, cpm_R, sz_K, sz_J);
+				f64_Product += f64_Left * f64_Right;
+			}
+			f64_Largest = (fabs(f64_Gram) > f64_Largest) ? fabs(f64_Gram) : f64_Largest;
+			f64_Error = (fabs(f64_Gram - f64_Product) > f64_Error) ? fabs(f64_Gram - f64_Product) : f64_Error;
+		}
+	}
+	return f64_Error / f64_Largest;
+}
+
+static void testqr(void) {
+	const size_t csz_Threads = pargetthreads();
+	uint32_t u32_State = 30;
+
+	// mtxqr: applying the stored reflectors to R rebuilds A, across more than one QR_BLOCK panel
+	MAKE_MATRIX_FAST(m_Factored, double, 45, 70, FP64)
+	double a_Original[70 * 45];
+	double a_Tau[45];
+	for (size_t sz_Col = 0; sz_Col < 45; ++sz_Col) {
+		for (size_t sz_Row = 0; sz_Row < 70; ++sz_Row) {
+			a_Original[sz_Row + sz_Col * 70] = testnoise(&u32_State);
+			mtxwrite(&m_Factored, sz_Row, sz_Col, &a_Original[sz_Row + sz_Col * 70]);
+		}
+	}
+	CHECK(mtxqr(&m_Factored, a_Tau) == 0);
+	for (size_t sz_Col = 0; sz_Col < 45; ++sz_Col) {
+		double a_Column[70] = { 0 };
+		for (size_t sz_Row = 0; sz_Row <= sz_Col; ++sz_Row) {
+			mtxread(&a_Column[sz_Row], &m_Factored, sz_Row, sz_Col);
+		}
+		// Q R = H_0 (H_1 (... H_44 R))
+		for (size_t sz_I = 45; sz_I-- > 0;) {
+			double f64_Dot = a_Column[sz_I];
+			for (size_t sz_Row = sz_I + 1; sz_Row < 70; ++sz_Row) {
+				double f64_V;
+				mtxread(&f64_V, &m_Factored, sz_Row, sz_I);
+				f64_Dot += f64_V * a_Column[sz_Row];
+			}
+			a_Column[sz_I] -= a_Tau[sz_I] * f64_Dot;
+			for (size_t sz_Row = sz_I + 1; sz_Row < 70; ++sz_Row) {
+				double f64_V;
+				mtxread(&f64_V, &m_Factored, sz_Row, sz_I);
+				a_Column[sz_Row] -= a_Tau[sz_I] * f64_Dot * f64_V;
+			}
+		}
+		for (size_t sz_Row = 0; sz_Row < 70; ++sz_Row) {
+			CHECK_NEAR(a_Column[sz_Row], a_Original[sz_Row + sz_Col * 70], 1e-12);
+		}
+	}
+
+	// mtxtsqr: several QR_TSQR_ROWS blocks per thread and a ragged last block, so both TSQR levels run
+	parthreads(3);
+	MAKE_MATRIX_FAST(m_Tall, double, 9, 7 * 1024 + 100, FP64)
+	MAKE_MATRIX_FAST(m_R, double, 9, 9, FP64)
+	for (size_t sz_Col = 0; sz_Col < 9; ++sz_Col) {
+		for (size_t sz_Row = 0; sz_Row < m_Tall.sz_Height; ++sz_Row) {
+			double f64_Value = testnoise(&u32_State) + ((sz_Row % 9 == sz_Col) ? 2.0 : 0.0);
+			mtxwrite(&m_Tall, sz_Row, sz_Col, &f64_Value);
+		}
+	}
+	CHECK(mtxtsqr(&m_R, &m_Tall) == 0);
+	CHECK(qrgramerror(&m_R, &m_Tall) < 1e-13);
+	for (size_t sz_Col = 0; sz_Col < 9; ++sz_Col) {
+		for (size_t sz_Row = sz_Col + 1; sz_Row < 9; ++sz_Row) {
+			double f64_Below;
+			mtxread(&f64_Below, &m_R, sz_Row, sz_Col);
+			CHECK(f64_Below == 0.0);
+		}
+	}
+
+	// mtxlstsq: B = A X exactly, so the least-squares solution is X itself
+	MAKE_MATRIX_FAST(m_X, double, 3, 9, FP64)
+	MAKE_MATRIX_FAST(m_B, double, 3, m_Tall.sz_Height, FP64)
+	MAKE_MATRIX_FAST(m_Solved, double, 3, 9, FP64)
+	for (size_t sz_Col = 0; sz_Col < 3; ++sz_Col) {
+		for (size_t sz_Row = 0; sz_Row < 9; ++sz_Row) {
+			double f64_Value = (double)sz_Row - 4.0 + 0.5 * (double)sz_Col;
+			mtxwrite(&m_X, sz_Row, sz_Col, &f64_Value);
+		}
+	}
+	for (size_t sz_Row = 0; sz_Row < m_Tall.sz_Height; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 3; ++sz_Col) {
+			double f64_Sum = 0.0;
+			for (size_t sz_K = 0; sz_K < 9; ++sz_K) {
+				double f64_A, f64_X;
+				mtxread(&f64_A, &m_Tall, sz_Row, sz_K);
+				mtxread(&f64_X, &m_X, sz_K, sz_Col);
+				f64_Sum += f64_A * f64_X;
+			}
+			mtxwrite(&m_B, sz_Row, sz_Col, &f64_Sum);
+		}
+	}
+	CHECK(mtxlstsq(&m_Solved, &m_Tall, &m_B) == 0);
+	for (size_t sz_Col = 0; sz_Col < 3; ++sz_Col) {
+		for (size_t sz_Row = 0; sz_Row < 9; ++sz_Row) {
+			double f64_Solved, f64_Expected;
+			mtxread(&f64_Solved, &m_Solved, sz_Row, sz_Col);
+			mtxread(&f64_Expected, &m_X, sz_Row, sz_Col);
+			CHECK_NEAR(f64_Solved, f64_Expected, 1e-10);
+		}
+	}
+
+	// A 1000 x 7 matrix whose column 3 duplicates column 0 is refused rather than solved
+	MAKE_MATRIX_FAST(m_Deficient, double, 7, 1000, FP64)
+	MAKE_MATRIX_FAST(m_Rhs, double, 1, 1000, FP64)
+	MAKE_MATRIX_FAST(m_Unknown, double, 1, 7, FP64)
+	for (size_t sz_Row = 0; sz_Row < 1000; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 7; ++sz_Col) {
+			double f64_Value = testnoise(&u32_State);
+			if (sz_Col == 3) {
+				mtxread(&f64_Value, &m_Deficient, sz_Row, 0);
+			}
+			mtxwrite(&m_Deficient, sz_Row, sz_Col, &f64_Value);
+		}
+		double f64_Rhs = testnoise(&u32_State);
+		mtxwrite(&m_Rhs, sz_Row, 0, &f64_Rhs);
+	}
+	CHECK(mtxlstsq(&m_Unknown, &m_Deficient, &m_Rhs) == -1);
+
+	parthreads(csz_Threads);
+	mtxdstry(&m_Factored);
+	mtxdstry(&m_Tall);
+	mtxdstry(&m_R);
+	mtxdstry(&m_X);
+	mtxdstry(&m_B);
+	mtxdstry(&m_Solved);
+	mtxdstry(&m_Deficient);
+	mtxdstry(&m_Rhs);
+	mtxdstry(&m_Unknown);
+}
+
+// Every layout pairing takes either the tiled path or the contiguous-run path; the element type must match
+static void testtrans(void) {
+	MAKE_MATRIX_FAST(m_Source, float, 5, 3, FP32)
+	MAKE_MATRIX_FAST(m_Result, float, 3, 5, FP32)
+	MAKE_MATRIX_FAST(m_Bits, uint32_t, 3, 5, U32)
+	const int a_Layouts[3] = { MATRIX_LAYOUT_COLUMN_MAJOR, MATRIX_LAYOUT_ROW_MAJOR, MATRIX_LAYOUT_ROW_MAJOR };
+	const size_t a_LeadingDims[3] = { 0, 0, 7 };
+
+	for (size_t sz_Source = 0; sz_Source < 3; ++sz_Source) {
+		mtxrelayout(&m_Source, a_Layouts[sz_Source], a_LeadingDims[sz_Source]);
+		for (size_t sz_Row = 0; sz_Row < 3; ++sz_Row) {
+			for (size_t sz_Col = 0; sz_Col < 5; ++sz_Col) {
+				float f32_Value = (float)(sz_Row * 10 + sz_Col);
+				mtxwrite(&m_Source, sz_Row, sz_Col, &f32_Value);
+			}
+		}
+		for (size_t sz_Result = 0; sz_Result < 3; ++sz_Result) {
+			mtxrelayout(&m_Result, a_Layouts[sz_Result], a_LeadingDims[sz_Result]);
+			CHECK(mtxtrans(&m_Result, &m_Source) == 0);
+			for (size_t sz_Row = 0; sz_Row < 5; ++sz_Row) {
+				for (size_t sz_Col = 0; sz_Col < 3; ++sz_Col) {
+					float f32_Value;
+					mtxread(&f32_Value, &m_Result, sz_Row, sz_Col);
+					CHECK(f32_Value == (float)(sz_Col * 10 + sz_Row));
+				}
+			}
+		}
+	}
+
+	CHECK(mtxtrans(&m_Bits, &m_Source) != 0);
+
+	mtxdstry(&m_Source);
+	mtxdstry(&m_Result);
+	mtxdstry(&m_Bits);
+}
+
+static void testrank(void) {
+	const int a_Layouts[3] = { MATRIX_LAYOUT_COLUMN_MAJOR, MATRIX_LAYOUT_ROW_MAJOR, MATRIX_LAYOUT_ROW_MAJOR };
+	const size_t a_LeadingDims[3] = { 0, 0, 75 };
+	const size_t a_OuterDims[3] = { 0, 0, 7 };
+	uint32_t u32_State = 32;
+
+	// vctouter and mtxger on small integers, so every product is exact
+	MAKE_VECTOR_FAST(v_X, double, 4, FP64)
+	MAKE_VECTOR_FAST(v_Y, double, 6, FP64)
+	MAKE_MATRIX_FAST(m_Outer, double, 6, 4, FP64)
+	const double cf64_Alpha = 0.5;
+	for (size_t sz_Idx = 0; sz_Idx < 6; ++sz_Idx) {
+		double f64_X = (double)sz_Idx - 1.0, f64_Y = 2.0 * (double)sz_Idx + 1.0;
+		if (sz_Idx < 4) {
+			vctwrite(&v_X, sz_Idx, &f64_X);
+		}
+		vctwrite(&v_Y, sz_Idx, &f64_Y);
+	}
+	for (size_t sz_Layout = 0; sz_Layout < 3; ++sz_Layout) {
+		mtxrelayout(&m_Outer, a_Layouts[sz_Layout], a_OuterDims[sz_Layout]);
+		CHECK(vctouter(&m_Outer, &v_X, &v_Y) == 0);
+		CHECK(mtxger(&m_Outer, &cf64_Alpha, &v_X, &v_Y) == 0);
+		for (size_t sz_Row = 0; sz_Row < 4; ++sz_Row) {
+			for (size_t sz_Col = 0; sz_Col < 6; ++sz_Col) {
+				double f64_Value;
+				mtxread(&f64_Value, &m_Outer, sz_Row, sz_Col);
+				CHECK(f64_Value == 1.5 * ((double)sz_Row - 1.0) * (2.0 * (double)sz_Col + 1.0));
+			}
+		}
+	}
+	CHECK(vctouter(&m_Outer, &v_Y, &v_X) != 0);
+
+	// mtxsyrk across two SYRK_BLOCK block columns: one triangle gains alpha * X X^T, the other keeps its sentinel
+	MAKE_MATRIX_FAST(m_Samples, double, 5, 70, FP64)
+	MAKE_MATRIX_FAST(m_Scatter, double, 70, 70, FP64)
+	const double cf64_Scale = -2.0;
+	for (size_t sz_Row = 0; sz_Row < 70; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 5; ++sz_Col) {
+			double f64_Value = testnoise(&u32_State);
+			mtxwrite(&m_Samples, sz_Row, sz_Col, &f64_Value);
+		}
+	}
+	for (size_t sz_Layout = 0; sz_Layout < 3; ++sz_Layout) {
+		for (int s32_Triangle = MATRIX_TRIANGLE_UPPER; s32_Triangle <= MATRIX_TRIANGLE_LOWER; ++s32_Triangle) {
+			mtxrelayout(&m_Scatter, a_Layouts[sz_Layout], a_LeadingDims[sz_Layout]);
+			for (size_t sz_Row = 0; sz_Row < 70; ++sz_Row) {
+				for (size_t sz_Col = 0; sz_Col < 70; ++sz_Col) {
+					double f64_Initial = (double)(sz_Row + 100 * sz_Col);
+					mtxwrite(&m_Scatter, sz_Row, sz_Col, &f64_Initial);
+				}
+			}
+			CHECK(mtxsyrk(&m_Scatter, s32_Triangle, &cf64_Scale, &m_Samples) == 0);
+			for (size_t sz_Row = 0; sz_Row < 70; ++sz_Row) {
+				for (size_t sz_Col = 0; sz_Col < 70; ++sz_Col) {
+					const int cs32_Inside = (s32_Triangle == MATRIX_TRIANGLE_UPPER) ? sz_Row <= sz_Col : sz_Row >= sz_Col;
+					double f64_Expected = (double)(sz_Row + 100 * sz_Col), f64_Value;
+					for (size_t sz_K = 0; cs32_Inside && sz_K < 5; ++sz_K) {
+						double f64_Left, f64_Right;
+						mtxread(&f64_Left, &m_Samples, sz_Row, sz_K);
+						mtxread(&f64_Right, &m_Samples, sz_Col, sz_K);
+						f64_Expected += cf64_Scale * f64_Left * f64_Right;
+					}
+					mtxread(&f64_Value, &m_Scatter, sz_Row, sz_Col);
+					if (cs32_Inside) {
+						CHECK_NEAR(f64_Value, f64_Expected, 1e-12);
+					} else {
+						CHECK(f64_Value == f64_Expected);
+					}
+				}
+			}
+		}
+	}
+
+	// Types without a native GEMM go through the element callbacks
+	MAKE_MATRIX_FAST(m_SamplesS16, int16_t, 2, 3, S16)
+	MAKE_MATRIX_FAST(m_ScatterS16, int16_t, 3, 3, S16)
+	const int16_t cs16_Alpha = 3;
+	const int16_t a_Samples[3][2] = { { 1, -2 }, { 3, 0 }, { -1, 4 } };
+	for (size_t sz_Row = 0; sz_Row < 3; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 2; ++sz_Col) {
+			mtxwrite(&m_SamplesS16, sz_Row, sz_Col, (void*)&a_Samples[sz_Row][sz_Col]);
+		}
+	}
+	CHECK(mtxsyrk(&m_ScatterS16, MATRIX_TRIANGLE_LOWER, &cs16_Alpha, &m_SamplesS16) == 0);
+	for (size_t sz_Row = 0; sz_Row < 3; ++sz_Row) {
+		for (size_t sz_Col = 0; sz_Col < 3; ++sz_Col) {
+			int16_t s16_Value;
+			mtxread(&s16_Value, &m_ScatterS16, sz_Row, sz_Col);
+			const int16_t cs16_Expected = (sz_Row >= sz_Col) ?
+				(int16_t)(3 * (a_Samples[sz_Row][0] * a_Samples[sz_Col][0] + a_Samples[sz_Row][1] * a_Samples[sz_Col][1])) : 0;
+			CHECK(s16_Value == cs16_Expected);
+		}
+	}
+
+	vctdstry(&v_X);
+	vctdstry(&v_Y);
+	mtxdstry(&m_Outer);
+	mtxdstry(&m_Samples);
+	mtxdstry(&m_Scatter);
+	mtxdstry(&m_SamplesS16);
+	mtxdstry(&m_ScatterS16);
+}
+
+// Elements written by the capacity test are never zero, so zero-filled growth is visible
+static uint32_t capacityvalue(const size_t csz_Idx) {
+	return (uint32_t)(3 * csz_Idx + 1);
+}
+
+static int capacitymatches(const vector_t* cpv_Vector, const size_t csz_Count) {
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+		uint32_t u32_Value;
+		vctread(&u32_Value, cpv_Vector, sz_Idx);
+		if (u32_Value != capacityvalue(sz_Idx)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Runs once with the default callbacks and once with the map allocator, growing well past MAP_THRESHOLD
+static void testcapacity(void) {
+	const size_t csz_Count = 3 * MAP_THRESHOLD / sizeof(uint32_t) + 11;
+
+	for (int s32_Mapped = 0; s32_Mapped <= 1; ++s32_Mapped) {
+		vector_t v_Growing = {0};
+		v_Growing.s32_Type = TYPE_U32;
+		v_Growing.sz_ElementSize = sizeof(uint32_t);
+		if (s32_Mapped) {
+			USE_MAP_ALLOCATOR(v_Growing)
+		}
+
+		// A vector that was never created gets its buffer from vctreserve
+		CHECK(vctreserve(&v_Growing, 10) == 0);
+		CHECK(v_Growing.sz_ElementCount == 0 && v_Growing.sz_Capacity >= 10);
+
+		for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+			uint32_t u32_Value = capacityvalue(sz_Idx);
+			if (vctpush(&v_Growing, &u32_Value) != 0) {
+				CHECK(!"vctpush failed");
+				break;
+			}
+		}
+		CHECK(v_Growing.sz_ElementCount == csz_Count && v_Growing.sz_Capacity >= csz_Count);
+		CHECK(v_Growing.sz_ElementCount * sizeof(uint32_t) > MAP_THRESHOLD);
+		CHECK(capacitymatches(&v_Growing, csz_Count));
+
+		// Appending the vector's own tail forces a reallocation while the source is inside the buffer
+		CHECK(vctshrink(&v_Growing) == 0);
+		CHECK(v_Growing.sz_Capacity == csz_Count);
+		CHECK(vctappend(&v_Growing, (const uint32_t*)v_Growing.p_StorageBuffer + csz_Count - 100, 100) == 0);
+		CHECK(v_Growing.sz_ElementCount == csz_Count + 100 && capacitymatches(&v_Growing, csz_Count));
+		for (size_t sz_Idx = 0; sz_Idx < 100; ++sz_Idx) {
+			uint32_t u32_Value;
+			vctread(&u32_Value, &v_Growing, csz_Count + sz_Idx);
+			CHECK(u32_Value == capacityvalue(csz_Count - 100 + sz_Idx));
+		}
+
+		// Shrinking keeps the capacity, and growing again must not resurrect the old elements
+		const size_t csz_Capacity = v_Growing.sz_Capacity;
+		CHECK(vctresize(&v_Growing, 1000) == 0);
+		CHECK(v_Growing.sz_ElementCount == 1000 && v_Growing.sz_Capacity == csz_Capacity);
+		CHECK(vctresize(&v_Growing, csz_Count) == 0);
+		CHECK(capacitymatches(&v_Growing, 1000));
+		size_t sz_Dirty = 0;
+		for (size_t sz_Idx = 1000; sz_Idx < csz_Count; ++sz_Idx) {
+			uint32_t u32_Value;
+			vctread(&u32_Value, &v_Growing, sz_Idx);
+			sz_Dirty += (u32_Value != 0);
+		}
+		CHECK(sz_Dirty == 0);
+
+		// vctshrink releases the spare capacity and keeps the elements
+		CHECK(vctresize(&v_Growing, 1000) == 0);
+		CHECK(vctshrink(&v_Growing) == 0);
+		CHECK(v_Growing.sz_ElementCount == 1000 && v_Growing.sz_Capacity == 1000);
+		CHECK(capacitymatches(&v_Growing, 1000));
+		CHECK(vctresize(&v_Growing, 0) == 0);
+		CHECK(vctshrink(&v_Growing) == 0);
+		CHECK(v_Growing.sz_Capacity == 1);
+
+		vctdstry(&v_Growing);
+	}
+}
+
+static int fillkind(vector_t* pv_Vector, const int cs32_Kind) {
+	switch (cs32_Kind) {
+		case 0:  return vctuniform(pv_Vector, 34, -2.0, 5.0);
+		case 1:  return vctnormal(pv_Vector, 34, 1.0, 3.0);
+		default: return vctrandom(pv_Vector, 34);
+	}
+}
+
+// Random fills are numbered in packed column-major order, so the thread count and the layout never change the values
+static void testfill(void) {
+	const size_t csz_Threads = pargetthreads();
+	const size_t csz_Count = 3 * 65536 + 5;
+
+	MAKE_VECTOR_FAST(v_Serial, double, csz_Count, FP64)
+	MAKE_VECTOR_FAST(v_Parallel, double, csz_Count, FP64)
+	for (int s32_Kind = 0; s32_Kind < 3; ++s32_Kind) {
+		parthreads(1);
+		CHECK(fillkind(&v_Serial, s32_Kind) == 0);
+		parthreads(4);
+		CHECK(fillkind(&v_Parallel, s32_Kind) == 0);
+		CHECK(memcmp(v_Serial.p_StorageBuffer, v_Parallel.p_StorageBuffer, csz_Count * sizeof(double)) == 0);
+	}
+
+	// Every layout, packed or padded, holds the same values as a vector of as many elements
+	const int a_Layouts[4] = { MATRIX_LAYOUT_COLUMN_MAJOR, MATRIX_LAYOUT_COLUMN_MAJOR, MATRIX_LAYOUT_ROW_MAJOR, MATRIX_LAYOUT_ROW_MAJOR };
+	const size_t a_LeadingDims[4] = { 0, 133, 0, 603 };
+	const double cf64_Sentinel = -7.0, cf64_Constant = 0.25;
+	MAKE_MATRIX_FAST(m_Filled, double, 600, 130, FP64)
+	MAKE_VECTOR_FAST(v_Reference, double, 600 * 130, FP64)
+	CHECK(vctuniform(&v_Reference, 99, 0.0, 1.0) == 0);
+	for (size_t sz_Layout = 0; sz_Layout < 4; ++sz_Layout) {
+		mtxrelayout(&m_Filled, a_Layouts[sz_Layout], a_LeadingDims[sz_Layout]);
+		for (size_t sz_Raw = 0; sz_Raw < m_Filled.sz_BufferSize / sizeof(double); ++sz_Raw) {
+			mtxwriteraw(&m_Filled, sz_Raw, (void*)&cf64_Sentinel);
+		}
+
+		for (int s32_Constant = 0; s32_Constant <= 1; ++s32_Constant) {
+			CHECK((s32_Constant ? mtxfill(&m_Filled, &cf64_Constant) : mtxuniform(&m_Filled, 99, 0.0, 1.0)) == 0);
+			size_t sz_Wrong = 0;
+			for (size_t sz_Col = 0; sz_Col < 600; ++sz_Col) {
+				for (size_t sz_Row = 0; sz_Row < 130; ++sz_Row) {
+					double f64_Value, f64_Expected = cf64_Constant;
+					mtxread(&f64_Value, &m_Filled, sz_Row, sz_Col);
+					if (!s32_Constant) {
+						vctread(&f64_Expected, &v_Reference, sz_Col * 130 + sz_Row);
+					}
+					sz_Wrong += (f64_Value != f64_Expected);
+				}
+			}
+			CHECK(sz_Wrong == 0);
+		}
+
+		// Padding is never written
+		size_t sz_Padding = 0;
+		for (size_t sz_Raw = 0; sz_Raw < m_Filled.sz_BufferSize / sizeof(double); ++sz_Raw) {
+			double f64_Value;
+			mtxreadraw(&f64_Value, &m_Filled, sz_Raw);
+			sz_Padding += (f64_Value == cf64_Sentinel);
+		}
+		CHECK(sz_Padding == m_Filled.sz_BufferSize / sizeof(double) - 600 * 130);
+	}
+
+	// 16-bit sequences wrap in their own type instead of overflowing int in the index product
+	MAKE_VECTOR_FAST(v_Sequence, int16_t, csz_Count, S16)
+	const int16_t cs16_Start = 100, cs16_Step = 7919;
+	CHECK(vctiota(&v_Sequence, &cs16_Start, &cs16_Step) == 0);
+	size_t sz_Wrong = 0;
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+		int16_t s16_Value;
+		vctread(&s16_Value, &v_Sequence, sz_Idx);
+		sz_Wrong += (s16_Value != (int16_t)(uint16_t)(100u + (unsigned int)(sz_Idx * 7919u)));
+	}
+	CHECK(sz_Wrong == 0);
+
+	parthreads(csz_Threads);
+	vctdstry(&v_Serial);
+	vctdstry(&v_Parallel);
+	vctdstry(&v_Reference);
+	vctdstry(&v_Sequence);
+	mtxdstry(&m_Filled);
+}
+
+// Counts the non-zero bytes in [csz_Begin, csz_End) of a buffer
+static size_t numadirty(const void* cp_Buffer, const size_t csz_Begin, const size_t csz_End) {
+	size_t sz_Dirty = 0;
+	for (size_t sz_Idx = csz_Begin; sz_Idx < csz_End; ++sz_Idx) {
+		sz_Dirty += (((const uint8_t*)cp_Buffer)[sz_Idx] != 0);
+	}
+	return sz_Dirty;
+}
+
+// Placement is up to the kernel, so only the allocator contract is checked: zero-filled, resizable with maprealloc, released by mapfree
+static void testnuma(void) {
+	const size_t csz_Large = 2 * MAP_THRESHOLD + 4096 + 3;
+	const size_t a_Sizes[2] = { 100, csz_Large };
+	void* (*const a_Allocators[3])(size_t) = { numainterleave, numalocal, numatouch };
+
+	CHECK(numanodes() >= 1);
+
+	for (size_t sz_Allocator = 0; sz_Allocator < 3; ++sz_Allocator) {
+		for (size_t sz_Size = 0; sz_Size < 2; ++sz_Size) {
+			uint8_t* pu8_Buffer = (uint8_t*)a_Allocators[sz_Allocator](a_Sizes[sz_Size]);
+			CHECK(pu8_Buffer != NULL);
+			if (pu8_Buffer == NULL) {
+				continue;
+			}
+			CHECK(numadirty(pu8_Buffer, 0, a_Sizes[sz_Size]) == 0);
+			memset(pu8_Buffer, 0x5A, a_Sizes[sz_Size]);
+
+			// Growing across MAP_THRESHOLD (or further past it) keeps the contents and zero-fills the rest
+			uint8_t* pu8_Grown = (uint8_t*)maprealloc(pu8_Buffer, a_Sizes[sz_Size], 2 * csz_Large);
+			CHECK(pu8_Grown != NULL);
+			if (pu8_Grown == NULL) {
+				mapfree(pu8_Buffer);
+				continue;
+			}
+			size_t sz_Lost = 0;
+			for (size_t sz_Idx = 0; sz_Idx < a_Sizes[sz_Size]; ++sz_Idx) {
+				sz_Lost += (pu8_Grown[sz_Idx] != 0x5A);
+			}
+			CHECK(sz_Lost == 0);
+			CHECK(numadirty(pu8_Grown, a_Sizes[sz_Size], 2 * csz_Large) == 0);
+			mapfree(pu8_Grown);
+		}
+	}
+
+	// The attach macros route a vector's creation, growth and destruction through the same family
+	for (size_t sz_Allocator = 0; sz_Allocator < 3; ++sz_Allocator) {
+		vector_t v_Placed = {0};
+		v_Placed.s32_Type = TYPE_U8;
+		v_Placed.sz_ElementSize = sizeof(uint8_t);
+		v_Placed.sz_ElementCount = csz_Large;
+		if (sz_Allocator == 0) {
+			USE_NUMA_INTERLEAVE(v_Placed)
+		} else if (sz_Allocator == 1) {
+			USE_NUMA_LOCAL(v_Placed)
+		} else {
+			USE_NUMA_TOUCH(v_Placed)
+		}
+		v_Placed.pfn_Reallocate = maprealloc;
+
+		CHECK(vctcreate(&v_Placed, NULL, NULL) == 0);
+		CHECK(numadirty(v_Placed.p_StorageBuffer, 0, csz_Large) == 0);
+		memset(v_Placed.p_StorageBuffer, 0xA5, csz_Large);
+		CHECK(vctresize(&v_Placed, 3 * csz_Large) == 0);
+		CHECK(v_Placed.sz_ElementCount == 3 * csz_Large);
+		uint8_t u8_First, u8_Last, u8_Grown;
+		vctread(&u8_First, &v_Placed, 0);
+		vctread(&u8_Last, &v_Placed, csz_Large - 1);
+		vctread(&u8_Grown, &v_Placed, csz_Large);
+		CHECK(u8_First == 0xA5 && u8_Last == 0xA5 && u8_Grown == 0);
+		CHECK(numadirty(v_Placed.p_StorageBuffer, csz_Large, 3 * csz_Large) == 0);
+		vctdstry(&v_Placed);
+	}
+}
+
+// Determinant of an order-n column-major matrix by cofactor expansion along the first column
+static double tinydeterminant(const double* cp_A, const size_t csz_N) {
+	if (csz_N == 1) {
+		return cp_A[0];
+	}
+
+	double a_Minor[9], f64_Det = 0.0, f64_Sign = 1.0;
+	for (size_t sz_Skip = 0; sz_Skip < csz_N; ++sz_Skip) {
+		for (size_t sz_Col = 1; sz_Col < csz_N; ++sz_Col) {
+			for (size_t sz_Row = 0, sz_Out = 0; sz_Row < csz_N; ++sz_Row) {
+				if (sz_Row != sz_Skip) {
+					a_Minor[sz_Out++ + (sz_Col - 1) * (csz_N - 1)] = cp_A[sz_Row + sz_Col * csz_N];
+				}
+			}
+		}
+		f64_Det += f64_Sign * cp_A[sz_Skip] * tinydeterminant(a_Minor, csz_N - 1);
+		f64_Sign = -f64_Sign;
+	}
+	return f64_Det;
+}
+
+// Batches of 16k + 5 matrices end on a partial tile; the big batch is split across threads
+static void testtiny(void) {
+	int (*const a_MulBatch[3])(double*, const double*, const double*, const size_t) = { mtx2mulbatchFP64, mtx3mulbatchFP64, mtx4mulbatchFP64 };
+	int (*const a_MulVctBatch[3])(double*, const double*, const double*, const size_t) = { mtx2mulvctbatchFP64, mtx3mulvctbatchFP64, mtx4mulvctbatchFP64 };
+	int (*const a_DetBatch[3])(double*, const double*, const size_t) = { mtx2detbatchFP64, mtx3detbatchFP64, mtx4detbatchFP64 };
+	int (*const a_InvBatch[3])(double*, const double*, const size_t) = { mtx2invbatchFP64, mtx3invbatchFP64, mtx4invbatchFP64 };
+	int (*const a_Inv[3])(double*, const double*) = { mtx2invFP64, mtx3invFP64, mtx4invFP64 };
+	double (*const a_Det[3])(const double*) = { mtx2detFP64, mtx3detFP64, mtx4detFP64 };
+	const size_t csz_Threads = pargetthreads();
+	const size_t a_Counts[2] = { 16 * 3 + 5, 20000 + 5 };
+	uint32_t u32_State = 36;
+
+	parthreads(4);
+	for (size_t sz_Order = 0; sz_Order < 3; ++sz_Order) {
+		const size_t csz_N = sz_Order + 2, csz_Size = csz_N * csz_N;
+		for (size_t sz_Case = 0; sz_Case < 2; ++sz_Case) {
+			const size_t csz_Count = a_Counts[sz_Case];
+			double* pf64_A = (double*)malloc(sizeof(double) * csz_Count * csz_Size);
+			double* pf64_B = (double*)malloc(sizeof(double) * csz_Count * csz_Size);
+			double* pf64_Out = (double*)malloc(sizeof(double) * csz_Count * csz_Size);
+			if (pf64_A == NULL || pf64_B == NULL || pf64_Out == NULL) {
+				CHECK(!"out of memory");
+				free(pf64_A);
+				free(pf64_B);
+				free(pf64_Out);
+				continue;
+			}
+
+			// Diagonally dominant, so every matrix is comfortably invertible
+			for (size_t sz_Idx = 0; sz_Idx < csz_Count * csz_Size; ++sz_Idx) {
+				const size_t csz_Elem = sz_Idx % csz_Size;
+				pf64_A[sz_Idx] = testnoise(&u32_State) + ((csz_Elem % (csz_N + 1) == 0) ? 4.0 : 0.0);
+				pf64_B[sz_Idx] = testnoise(&u32_State);
+			}
+
+			size_t sz_Wrong = 0;
+			CHECK(a_MulBatch[sz_Order](pf64_Out, pf64_A, pf64_B, csz_Count) == 0);
+			for (size_t sz_Mat = 0; sz_Mat < csz_Count; ++sz_Mat) {
+				const double* cpf64_A = pf64_A + sz_Mat * csz_Size;
+				const double* cpf64_B = pf64_B + sz_Mat * csz_Size;
+				for (size_t sz_Row = 0; sz_Row < csz_N; ++sz_Row) {
+					for (size_t sz_Col = 0; sz_Col < csz_N; ++sz_Col) {
+						double f64_Sum = 0.0;
+						for (size_t sz_K = 0; sz_K < csz_N; ++sz_K) {
+							f64_Sum += cpf64_A[sz_Row + sz_K * csz_N] * cpf64_B[sz_K + sz_Col * csz_N];
+						}
+						sz_Wrong += fabs(pf64_Out[sz_Mat * csz_Size + sz_Row + sz_Col * csz_N] - f64_Sum) > 1e-12;
+					}
+				}
+			}
+			CHECK(sz_Wrong == 0);
+
+			sz_Wrong = 0;
+			CHECK(a_MulVctBatch[sz_Order](pf64_Out, pf64_A, pf64_B, csz_Count) == 0);
+			for (size_t sz_Mat = 0; sz_Mat < csz_Count; ++sz_Mat) {
+				for (size_t sz_Row = 0; sz_Row < csz_N; ++sz_Row) {
+					double f64_Sum = 0.0;
+					for (size_t sz_K = 0; sz_K < csz_N; ++sz_K) {
+						f64_Sum += pf64_A[sz_Mat * csz_Size + sz_Row + sz_K * csz_N] * pf64_B[sz_Mat * csz_N + sz_K];
+					}
+					sz_Wrong += fabs(pf64_Out[sz_Mat * csz_N + sz_Row] - f64_Sum) > 1e-12;
+				}
+			}
+			CHECK(sz_Wrong == 0);
+
+			sz_Wrong = 0;
+			CHECK(a_DetBatch[sz_Order](pf64_Out, pf64_A, csz_Count) == 0);
+			for (size_t sz_Mat = 0; sz_Mat < csz_Count; ++sz_Mat) {
+				const double cf64_Det = tinydeterminant(pf64_A + sz_Mat * csz_Size, csz_N);
+				sz_Wrong += fabs(pf64_Out[sz_Mat] - cf64_Det) > 1e-12 * (1.0 + fabs(cf64_Det));
+				sz_Wrong += fabs(a_Det[sz_Order](pf64_A + sz_Mat * csz_Size) - cf64_Det) > 1e-12 * (1.0 + fabs(cf64_Det));
+			}
+			CHECK(sz_Wrong == 0);
+
+			// Inverse in place, then A * A^-1 = I against the untouched copy in B
+			sz_Wrong = 0;
+			memcpy(pf64_B, pf64_A, sizeof(double) * csz_Count * csz_Size);
+			CHECK(a_InvBatch[sz_Order](pf64_A, pf64_A, csz_Count) == 0);
+			for (size_t sz_Mat = 0; sz_Mat < csz_Count; ++sz_Mat) {
+				for (size_t sz_Row = 0; sz_Row < csz_N; ++sz_Row) {
+					for (size_t sz_Col = 0; sz_Col < csz_N; ++sz_Col) {
+						double f64_Sum = 0.0;
+						for (size_t sz_K = 0; sz_K < csz_N; ++sz_K) {
+							f64_Sum += pf64_B[sz_Mat * csz_Size + sz_Row + sz_K * csz_N] * pf64_A[sz_Mat * csz_Size + sz_K + sz_Col * csz_N];
+						}
+						sz_Wrong += fabs(f64_Sum - ((sz_Row == sz_Col) ? 1.0 : 0.0)) > 1e-12;
+					}
+				}
+			}
+			CHECK(sz_Wrong == 0);
+
+			// A zero column in the last (partial) tile is reported, written as zeros, and leaves the others computed
+			memset(pf64_B + (csz_Count - 1) * csz_Size, 0, sizeof(double) * csz_N);
+			CHECK(a_InvBatch[sz_Order](pf64_Out, pf64_B, csz_Count) == -1);
+			sz_Wrong = 0;
+			for (size_t sz_Elem = 0; sz_Elem < csz_Size; ++sz_Elem) {
+				sz_Wrong += pf64_Out[(csz_Count - 1) * csz_Size + sz_Elem] != 0.0;
+				sz_Wrong += fabs(pf64_Out[sz_Elem] - pf64_A[sz_Elem]) > 1e-12;
+			}
+			CHECK(sz_Wrong == 0);
+			CHECK(a_Inv[sz_Order](pf64_Out, pf64_B + (csz_Count - 1) * csz_Size) == -1);
+			CHECK(a_Inv[sz_Order](pf64_Out, pf64_B) == 0);
+
+			free(pf64_A);
+			free(pf64_B);
+			free(pf64_Out);
+		}
+	}
+	parthreads(csz_Threads);
+
+	// Single precision shares the formulas; one product and one inverse are enough to catch a broken expansion
+	const float a_F32[4] = { 4.0f, 1.0f, 2.0f, 3.0f };
+	float a_Inverse[4], a_Product[4];
+	CHECK(mtx2invFP32(a_Inverse, a_F32) == 0);
+	mtx2mulFP32(a_Product, a_F32, a_Inverse);
+	CHECK_NEAR(a_Product[0], 1.0, 1e-6);
+	CHECK_NEAR(a_Product[1], 0.0, 1e-6);
+	CHECK_NEAR(a_Product[2], 0.0, 1e-6);
+	CHECK_NEAR(a_Product[3], 1.0, 1e-6);
+	CHECK(mtx2detFP32(a_F32) == 10.0f);
+	CHECK(mtx2mulbatchFP32(NULL, a_F32, a_F32, 1) == -1);
+}
+
+/**
+ * asyncstep_t - One node of a test graph.
+ *
+ * The executor publishes a finished operation before starting its dependents, so a node only ever
+ * sees s32_Ran set on every node in apt_After when the dependency order was respected.
+ */
+typedef struct __asyncstep_t {
+	struct __asyncstep_t* apt_After[2];
+	size_t sz_After;
+	int s32_Result;
+	int s32_Ran;
+	int s32_InOrder;
+	double f64_Work;
+} asyncstep_t;
+
+static int asyncstep(void* p_Context) {
+	asyncstep_t* pt_Step = (asyncstep_t*)p_Context;
+
+	// Some real work, so a dependent submitted right away would otherwise overtake this node
+	for (size_t sz_Idx = 0; sz_Idx < 200000; ++sz_Idx) {
+		pt_Step->f64_Work += sqrt((double)sz_Idx);
+	}
+
+	pt_Step->s32_InOrder = 1;
+	for (size_t sz_Dep = 0; sz_Dep < pt_Step->sz_After; ++sz_Dep) {
+		pt_Step->s32_InOrder &= pt_Step->apt_After[sz_Dep]->s32_Ran;
+	}
+	pt_Step->s32_Ran = 1;
+	return pt_Step->s32_Result;
+}
+
+// Submits the diamond top -> (left, right) -> bottom, with the top failing when cs32_TopResult is -1
+static void asyncdiamond(const int cs32_TopResult) {
+	asyncstep_t a_Steps[4];
+	asynctask_t* apa_Tasks[4];
+
+	memset(a_Steps, 0, sizeof(a_Steps));
+	a_Steps[0].s32_Result = cs32_TopResult;
+	a_Steps[1].apt_After[0] = &a_Steps[0];
+	a_Steps[1].sz_After = 1;
+	a_Steps[2].apt_After[0] = &a_Steps[0];
+	a_Steps[2].sz_After = 1;
+	a_Steps[3].apt_After[0] = &a_Steps[1];
+	a_Steps[3].apt_After[1] = &a_Steps[2];
+	a_Steps[3].sz_After = 2;
+
+	apa_Tasks[0] = asyncsubmit(asyncstep, &a_Steps[0], NULL, 0);
+	apa_Tasks[1] = asyncsubmit(asyncstep, &a_Steps[1], &apa_Tasks[0], 1);
+	apa_Tasks[2] = asyncsubmit(asyncstep, &a_Steps[2], &apa_Tasks[0], 1);
+	apa_Tasks[3] = asyncsubmit(asyncstep, &a_Steps[3], &apa_Tasks[1], 2);
+	CHECK(apa_Tasks[0] != NULL && apa_Tasks[1] != NULL && apa_Tasks[2] != NULL && apa_Tasks[3] != NULL);
+
+	// Waiting on the bottom alone must be enough for the whole diamond
+	CHECK(asyncwait(apa_Tasks[3]) == cs32_TopResult);
+	for (size_t sz_Task = 0; sz_Task < 4; ++sz_Task) {
+		CHECK(asyncpoll(apa_Tasks[sz_Task]) == 1);
+		CHECK(asyncwait(apa_Tasks[sz_Task]) == cs32_TopResult);
+	}
+
+	CHECK(a_Steps[0].s32_Ran == 1);
+	if (cs32_TopResult == 0) {
+		for (size_t sz_Step = 1; sz_Step < 4; ++sz_Step) {
+			CHECK(a_Steps[sz_Step].s32_Ran == 1 && a_Steps[sz_Step].s32_InOrder == 1);
+		}
+	} else {
+		// Dependents of a failed operation finish with -1 without running, transitively
+		for (size_t sz_Step = 1; sz_Step < 4; ++sz_Step) {
+			CHECK(a_Steps[sz_Step].s32_Ran == 0);
+		}
+	}
+
+	for (size_t sz_Task = 0; sz_Task < 4; ++sz_Task) {
+		asyncrelease(apa_Tasks[sz_Task]);
+	}
+}
+
+static void testasync(void) {
+	asyncthreads(3);
+	asyncdiamond(0);
+	asyncdiamond(-1);
+
+	// Changing the thread count stops the executor; the next submission must start it again
+	asyncthreads(1);
+	asyncdiamond(0);
+	asyncthreads(2);
+	asyncdiamond(0);
+
+	CHECK(asyncwait(NULL) == -1);
+	asyncdrain();
+	asyncthreads(0);
+}
+
+// Allocation callbacks that count their calls, so clones can be checked for balanced, allocator-routed bookkeeping
+static size_t sz_CountedAllocations = 0;
+static size_t sz_CountedFrees = 0;
+
+static void* countedalloc(size_t sz_Size) {
+	++sz_CountedAllocations;
+	return calloc(sz_Size, 1);
+}
+
+static void countedfree(void* p_Buffer) {
+	sz_CountedFrees += (p_Buffer != NULL);
+	free(p_Buffer);
+}
+
+// Non-zero when the first csz_Count elements of a float vector are 0, 1, 2, ...
+static int cowintact(const vector_t* cpv_Vector, const size_t csz_Count) {
+	if (cpv_Vector->sz_ElementCount != csz_Count) {
+		return 0;
+	}
+	for (size_t sz_Idx = 0; sz_Idx < csz_Count; ++sz_Idx) {
+		float f32_Value;
+		vctread(&f32_Value, cpv_Vector, sz_Idx);
+		if (f32_Value != (float)sz_Idx) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void testcow(void) {
+	const float cf32_Marker = -1.0f;
+	vector_t v_Source = {0};
+	v_Source.s32_Type = TYPE_FP32;
+	v_Source.sz_ElementSize = sizeof(float);
+	v_Source.sz_ElementCount = 8;
+	v_Source.pfn_ElementAdd = AddFP32;
+	v_Source.pfn_ElementSubtract = SubtractFP32;
+	v_Source.pfn_ElementMultiply = MultiplyFP32;
+	v_Source.pfn_ElementDivide = DivideFP32;
+	CHECK(vctcreate(&v_Source, countedalloc, countedfree) == 0);
+	for (size_t sz_Idx = 0; sz_Idx < 8; ++sz_Idx) {
+		float f32_Value = (float)sz_Idx;
+		vctwrite(&v_Source, sz_Idx, &f32_Value);
+	}
+
+	// The first clone allocates the shared count through the vector's own callbacks
+	const size_t csz_Unshared = sz_CountedAllocations;
+	vector_t v_First;
+	CHECK(vctclone(&v_First, &v_Source) == 0);
+	CHECK(sz_CountedAllocations == csz_Unshared + 1);
+	vctdstry(&v_First);
+
+	// Each writer gets its own copy; the source is unchanged and both orders of destruction free everything
+	for (int s32_Writer = 0; s32_Writer < 3; ++s32_Writer) {
+		for (int s32_SourceFirst = 0; s32_SourceFirst <= 1; ++s32_SourceFirst) {
+			vector_t v_Keeper, v_Clone;
+			CHECK(vctclone(&v_Keeper, &v_Source) == 0);
+			const size_t csz_Before = sz_CountedAllocations;
+			CHECK(vctclone(&v_Clone, &v_Keeper) == 0);
+			CHECK(v_Clone.p_StorageBuffer == v_Source.p_StorageBuffer);
+			CHECK(sz_CountedAllocations == csz_Before);
+
+			if (s32_Writer == 0) {
+				vctwrite(&v_Clone, 3, (void*)&cf32_Marker);
+			} else if (s32_Writer == 1) {
+				CHECK(vctpush(&v_Clone, &cf32_Marker) == 0);
+			} else {
+				CHECK(vctfill(&v_Clone, &cf32_Marker) == 0);
+			}
+			CHECK(v_Clone.p_StorageBuffer != v_Source.p_StorageBuffer);
+			CHECK(cowintact(&v_Source, 8) && cowintact(&v_Keeper, 8));
+
+			float f32_Value;
+			vctread(&f32_Value, &v_Clone, (s32_Writer == 1) ? 8 : 3);
+			CHECK(f32_Value == cf32_Marker);
+
+			if (s32_SourceFirst) {
+				vctdstry(&v_Keeper);
+				vctdstry(&v_Clone);
+			} else {
+				vctdstry(&v_Clone);
+				vctdstry(&v_Keeper);
+			}
+			CHECK(cowintact(&v_Source, 8));
+		}
+	}
+
+	// The source may be destroyed first, leaving the clone as the sole owner of the original buffer
+	vector_t v_Survivor;
+	CHECK(vctclone(&v_Survivor, &v_Source) == 0);
+	vctdstry(&v_Source);
+	CHECK(cowintact(&v_Survivor, 8));
+	vctwrite(&v_Survivor, 0, (void*)&cf32_Marker);
+	vctdstry(&v_Survivor);
+
+	// Matrices share the same bookkeeping
+	matrix_t m_Source = {0};
+	m_Source.s32_Type = TYPE_FP64;
+	m_Source.sz_ElementSize = sizeof(double);
+	m_Source.sz_Width = 3;
+	m_Source.sz_Height = 2;
+	CHECK(mtxcreate(&m_Source, countedalloc, countedfree) == 0);
+	const double cf64_Original = 2.5, cf64_Marker = -4.0;
+	CHECK(mtxfill(&m_Source, &cf64_Original) == 0);
+	for (int s32_SourceFirst = 0; s32_SourceFirst <= 1; ++s32_SourceFirst) {
+		matrix_t m_Clone;
+		CHECK(mtxclone(&m_Clone, &m_Source) == 0);
+		if (s32_SourceFirst) {
+			CHECK(mtxfill(&m_Clone, &cf64_Marker) == 0);
+		} else {
+			mtxwrite(&m_Clone, 1, 2, (void*)&cf64_Marker);
+		}
+		double f64_Source, f64_Clone;
+		mtxread(&f64_Source, &m_Source, 1, 2);
+		mtxread(&f64_Clone, &m_Clone, 1, 2);
+		CHECK(f64_Source == cf64_Original && f64_Clone == cf64_Marker);
+		mtxdstry(&m_Clone);
+	}
+	mtxdstry(&m_Source);
+
+	// A wrapped matrix keeps callbacks already set on the struct, so copying it on clone goes through them
+	double a_Wrapped[6] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+	matrix_t m_Wrapped = {0};
+	m_Wrapped.s32_Type = TYPE_FP64;
+	m_Wrapped.sz_ElementSize = sizeof(double);
+	m_Wrapped.sz_Width = 3;
+	m_Wrapped.sz_Height = 2;
+	m_Wrapped.pfn_Allocate = countedalloc;
+	m_Wrapped.pfn_Free = countedfree;
+	CHECK(mtxwrap(&m_Wrapped, a_Wrapped, NULL, NULL) == 0);
+	CHECK(m_Wrapped.pfn_Allocate == countedalloc && m_Wrapped.pfn_Free == countedfree);
+	const size_t csz_Before = sz_CountedAllocations;
+	matrix_t m_Copy;
+	CHECK(mtxclone(&m_Copy, &m_Wrapped) == 0);
+	CHECK(sz_CountedAllocations > csz_Before);
+	mtxdstry(&m_Copy);
+	mtxdstry(&m_Wrapped);
+
+	CHECK(sz_CountedAllocations == sz_CountedFrees);
+}
+
+// Element n of the full convolution (or, with cs32_Correlate, cross-correlation) of x and h, summed naively
+static double convreference(const double* cpf64_X, const size_t csz_N, const double* cpf64_H, const size_t csz_K, const size_t csz_Out, const int cs32_Correlate) {
+	double f64_Sum = 0.0;
+	for (size_t sz_J = 0; sz_J < csz_K; ++sz_J) {
+		// Full correlation index n lines t[j] up with x[n + j - (K - 1)], which is convolution with h reversed
+		const size_t csz_Tap = cs32_Correlate ? csz_K - 1 - sz_J : sz_J;
+		if (csz_Out >= sz_J && csz_Out - sz_J < csz_N) {
+			f64_Sum += cpf64_X[csz_Out - sz_J] * cpf64_H[csz_Tap];
+		}
+	}
+	return f64_Sum;
+}
+
+// One filter below and one above CONV_FFT_THRESHOLD, plus a filter longer than the signal, in every mode
+static void testconv(void) {
+	const size_t csz_N = 1000;
+	const size_t a_Filters[3] = { 7, 200, 1500 };
+	const int a_Modes[3] = { CONV_MODE_FULL, CONV_MODE_SAME, CONV_MODE_VALID };
+	uint32_t u32_State = 39;
+	double a_X[1000], a_H[1500];
+
+	for (size_t sz_Idx = 0; sz_Idx < 1500; ++sz_Idx) {
+		a_H[sz_Idx] = testnoise(&u32_State);
+		if (sz_Idx < csz_N) {
+			a_X[sz_Idx] = testnoise(&u32_State);
+		}
+	}
+
+	MAKE_VECTOR_FAST(v_Signal, double, csz_N, FP64)
+	vctset(&v_Signal, a_X);
+	for (size_t sz_Filter = 0; sz_Filter < 3; ++sz_Filter) {
+		const size_t csz_K = a_Filters[sz_Filter];
+		const size_t csz_Short = (csz_N < csz_K) ? csz_N : csz_K;
+		MAKE_VECTOR_FAST(v_Filter, double, csz_K, FP64)
+		vctset(&v_Filter, a_H);
+
+		for (size_t sz_Mode = 0; sz_Mode < 3; ++sz_Mode) {
+			const size_t a_Begin[3] = { 0, (csz_K - 1) / 2, csz_Short - 1 };
+			const size_t a_Count[3] = { csz_N + csz_K - 1, csz_N, csz_N + csz_K - 2 * csz_Short + 1 };
+			MAKE_VECTOR_FAST(v_Result, double, a_Count[sz_Mode], FP64)
+
+			for (int s32_Correlate = 0; s32_Correlate <= 1; ++s32_Correlate) {
+				const int cs32_Status = s32_Correlate ? vctcorr(&v_Result, &v_Signal, &v_Filter, a_Modes[sz_Mode]) :
+					vctconv(&v_Result, &v_Signal, &v_Filter, a_Modes[sz_Mode]);
+				CHECK(cs32_Status == 0);
+
+				// Errors are measured against the size of the operands, which is what bounds the FFT rounding
+				size_t sz_Wrong = 0;
+				for (size_t sz_Idx = 0; sz_Idx < a_Count[sz_Mode]; ++sz_Idx) {
+					double f64_Value;
+					vctread(&f64_Value, &v_Result, sz_Idx);
+					sz_Wrong += fabs(f64_Value - convreference(a_X, csz_N, a_H, csz_K, a_Begin[sz_Mode] + sz_Idx, s32_Correlate)) > 1e-10 * (double)csz_Short;
+				}
+				CHECK(sz_Wrong == 0);
+			}
+			vctdstry(&v_Result);
+		}
+
+		// One element too many for the full range, and an unknown mode
+		MAKE_VECTOR_FAST(v_Wrong, double, csz_N + csz_K, FP64)
+		CHECK(vctconv(&v_Wrong, &v_Signal, &v_Filter, CONV_MODE_FULL) == -1);
+		CHECK(vctcorr(&v_Wrong, &v_Signal, &v_Filter, CONV_MODE_FULL) == -1);
+		CHECK(vctconv(&v_Wrong, &v_Signal, &v_Filter, 7) == -1);
+		vctdstry(&v_Wrong);
+		vctdstry(&v_Filter);
+	}
+
+	// Single precision through the FFT path
+	MAKE_VECTOR_FAST(v_Signal32, float, 300, FP32)
+	MAKE_VECTOR_FAST(v_Filter32, float, 64, FP32)
+	MAKE_VECTOR_FAST(v_Result32, float, 300, FP32)
+	for (size_t sz_Idx = 0; sz_Idx < 300; ++sz_Idx) {
+		float f32_X = (float)a_X[sz_Idx];
+		vctwrite(&v_Signal32, sz_Idx, &f32_X);
+		if (sz_Idx < 64) {
+			float f32_H = (float)a_H[sz_Idx];
+			vctwrite(&v_Filter32, sz_Idx, &f32_H);
+		}
+	}
+	CHECK(vctconv(&v_Result32, &v_Signal32, &v_Filter32, CONV_MODE_SAME) == 0);
+	size_t sz_Wrong = 0;
+	for (size_t sz_Idx = 0; sz_Idx < 300; ++sz_Idx) {
+		float f32_Value;
+		double f64_Expected = 0.0;
+		vctread(&f32_Value, &v_Result32, sz_Idx);
+		for (size_t sz_J = 0; sz_J < 64; ++sz_J) {
+			const size_t csz_Out = sz_Idx + 31;
+			if (csz_Out >= sz_J && csz_Out - sz_J < 300) {
+				f64_Expected += (double)(float)a_X[csz_Out - sz_J] * (double)(float)a_H[sz_J];
+			}
+		}
+		sz_Wrong += fabs(f32_Value - f64_Expected) > 1e-4 * 64;
+	}
+	CHECK(sz_Wrong == 0);
+
+	vctdstry(&v_Signal);
+	vctdstry(&v_Signal32);
+	vctdstry(&v_Filter32);
+	vctdstry(&v_Result32);
+}
+
+// Row-major multi-index of flat position csz_Flat within a tensor's shape
+static void tnsindex(size_t* psz_Index, const tensor_t* cpt_Tensor, size_t sz_Flat) {
+	for (size_t sz_Axis = cpt_Tensor->sz_Rank; sz_Axis-- > 0;) {
+		psz_Index[sz_Axis] = sz_Flat % cpt_Tensor->a_Shape[sz_Axis];
+		sz_Flat /= cpt_Tensor->a_Shape[sz_Axis];
+	}
+}
+
+static void tnsnoise(tensor_t* pt_Tensor, uint32_t* pu32_State) {
+	size_t a_Index[TENSOR_MAX_RANK];
+	for (size_t sz_Flat = 0; sz_Flat < pt_Tensor->sz_ElementCount; ++sz_Flat) {
+		double f64_Value = testnoise(pu32_State);
+		tnsindex(a_Index, pt_Tensor, sz_Flat);
+		tnswrite(pt_Tensor, a_Index, &f64_Value);
+	}
+}
+
+static double tnsat(const tensor_t* cpt_Tensor, const size_t* csz_Index) {
+	double f64_Value;
+	tnsread(&f64_Value, cpt_Tensor, csz_Index);
+	return f64_Value;
+}
+
+static void testtensor(void) {
+	uint32_t u32_State = 40;
+
+	// Broadcasting { 3, 1, 5 } against { 4, 1 } into { 3, 4, 5 }, against a naive loop
+	const size_t a_ShapeA[3] = { 3, 1, 5 }, a_ShapeB[2] = { 4, 1 }, a_ShapeR[3] = { 3, 4, 5 };
+	MAKE_TENSOR_FAST(t_A, double, 3, a_ShapeA, FP64)
+	MAKE_TENSOR_FAST(t_B, double, 2, a_ShapeB, FP64)
+	MAKE_TENSOR_FAST(t_R, double, 3, a_ShapeR, FP64)
+	tnsnoise(&t_A, &u32_State);
+	tnsnoise(&t_B, &u32_State);
+	for (int s32_Multiply = 0; s32_Multiply <= 1; ++s32_Multiply) {
+		CHECK((s32_Multiply ? tnselemul(&t_R, &t_A, &t_B) : tnsadd(&t_R, &t_A, &t_B)) == 0);
+		size_t sz_Wrong = 0;
+		for (size_t sz_I = 0; sz_I < 3; ++sz_I) {
+			for (size_t sz_J = 0; sz_J < 4; ++sz_J) {
+				for (size_t sz_K = 0; sz_K < 5; ++sz_K) {
+					const size_t a_IdxA[3] = { sz_I, 0, sz_K }, a_IdxB[2] = { sz_J, 0 }, a_IdxR[3] = { sz_I, sz_J, sz_K };
+					const double cf64_Expected = s32_Multiply ? tnsat(&t_A, a_IdxA) * tnsat(&t_B, a_IdxB) : tnsat(&t_A, a_IdxA) + tnsat(&t_B, a_IdxB);
+					sz_Wrong += tnsat(&t_R, a_IdxR) != cf64_Expected;
+				}
+			}
+		}
+		CHECK(sz_Wrong == 0);
+	}
+	CHECK(tnsadd(&t_A, &t_A, &t_R) != 0);
+
+	// In place: R += B, broadcast over the first and last axes
+	MAKE_TENSOR_FAST(t_Before, double, 3, a_ShapeR, FP64)
+	CHECK(tnscopy(&t_Before, &t_R) == 0);
+	CHECK(tnsadd(&t_R, &t_R, &t_B) == 0);
+	size_t sz_Wrong = 0;
+	for (size_t sz_Flat = 0; sz_Flat < 60; ++sz_Flat) {
+		size_t a_Idx[3];
+		tnsindex(a_Idx, &t_R, sz_Flat);
+		const size_t a_IdxB[2] = { a_Idx[1], 0 };
+		sz_Wrong += tnsat(&t_R, a_Idx) != tnsat(&t_Before, a_Idx) + tnsat(&t_B, a_IdxB);
+	}
+	CHECK(sz_Wrong == 0);
+
+	// Views share storage: permute, slice and reshape read the source's elements at the mapped indices
+	const size_t a_Axes[3] = { 2, 0, 1 }, a_Flat[2] = { 12, 5 };
+	tensor_t t_Permuted, t_Sliced, t_Reshaped, t_Bad;
+	CHECK(tnspermute(&t_Permuted, &t_R, a_Axes) == 0);
+	CHECK(t_Permuted.a_Shape[0] == 5 && t_Permuted.a_Shape[1] == 3 && t_Permuted.a_Shape[2] == 4);
+	CHECK(tnsslice(&t_Sliced, &t_R, 1, 1, 2) == 0);
+	CHECK(t_Sliced.a_Shape[1] == 2 && t_Sliced.sz_ElementCount == 30);
+	CHECK(tnsreshape(&t_Reshaped, &t_R, 2, a_Flat) == 0);
+	CHECK(tnsreshape(&t_Bad, &t_Permuted, 2, a_Flat) != 0);
+	sz_Wrong = 0;
+	for (size_t sz_Flat = 0; sz_Flat < 60; ++sz_Flat) {
+		size_t a_Idx[3];
+		tnsindex(a_Idx, &t_R, sz_Flat);
+		const double cf64_Value = tnsat(&t_R, a_Idx);
+		const size_t a_IdxP[3] = { a_Idx[2], a_Idx[0], a_Idx[1] }, a_IdxF[2] = { sz_Flat / 5, sz_Flat % 5 };
+		sz_Wrong += tnsat(&t_Permuted, a_IdxP) != cf64_Value;
+		sz_Wrong += tnsat(&t_Reshaped, a_IdxF) != cf64_Value;
+		if (a_Idx[1] >= 1 && a_Idx[1] < 3) {
+			const size_t a_IdxS[3] = { a_Idx[0], a_Idx[1] - 1, a_Idx[2] };
+			sz_Wrong += tnsat(&t_Sliced, a_IdxS) != cf64_Value;
+		}
+	}
+	CHECK(sz_Wrong == 0);
+
+	// A write through a slice lands in the source
+	const double cf64_Marker = 123.0;
+	const size_t a_IdxS[3] = { 2, 0, 4 }, a_IdxSource[3] = { 2, 1, 4 };
+	tnswrite(&t_Sliced, a_IdxS, (void*)&cf64_Marker);
+	CHECK(tnsat(&t_R, a_IdxSource) == cf64_Marker);
+
+	// tnscontract over two axes with a permuted (non-flattenable) B: C[i][l] = sum A[i][j][k] * B'[j][k][l]
+	const size_t a_ShapeC1[3] = { 2, 3, 4 }, a_ShapeC2[3] = { 5, 4, 3 }, a_ShapeC[2] = { 2, 5 }, a_Reverse[3] = { 2, 1, 0 };
+	MAKE_TENSOR_FAST(t_Left, double, 3, a_ShapeC1, FP64)
+	MAKE_TENSOR_FAST(t_Right, double, 3, a_ShapeC2, FP64)
+	MAKE_TENSOR_FAST(t_Contracted, double, 2, a_ShapeC, FP64)
+	tnsnoise(&t_Left, &u32_State);
+	tnsnoise(&t_Right, &u32_State);
+	tensor_t t_RightT;
+	CHECK(tnspermute(&t_RightT, &t_Right, a_Reverse) == 0);
+	CHECK(tnscontract(&t_Contracted, &t_Left, &t_RightT, 2) == 0);
+	sz_Wrong = 0;
+	for (size_t sz_I = 0; sz_I < 2; ++sz_I) {
+		for (size_t sz_L = 0; sz_L < 5; ++sz_L) {
+			double f64_Sum = 0.0;
+			for (size_t sz_J = 0; sz_J < 3; ++sz_J) {
+				for (size_t sz_K = 0; sz_K < 4; ++sz_K) {
+					const size_t a_IdxL[3] = { sz_I, sz_J, sz_K }, a_IdxRt[3] = { sz_J, sz_K, sz_L };
+					f64_Sum += tnsat(&t_Left, a_IdxL) * tnsat(&t_RightT, a_IdxRt);
+				}
+			}
+			const size_t a_IdxC[2] = { sz_I, sz_L };
+			sz_Wrong += fabs(tnsat(&t_Contracted, a_IdxC) - f64_Sum) > 1e-12;
+		}
+	}
+	CHECK(sz_Wrong == 0);
+	CHECK(tnscontract(&t_Contracted, &t_Left, &t_Right, 2) != 0);
+
+	// tnsmatmul: batch { 2, 1 } against { 5 } broadcasts to { 2, 5 }, with B a transposed view of { 5, 6, 4 }
+	const size_t a_ShapeM1[4] = { 2, 1, 3, 4 }, a_ShapeM2[3] = { 5, 6, 4 }, a_ShapeM[4] = { 2, 5, 3, 6 }, a_Swap[3] = { 0, 2, 1 };
+	MAKE_TENSOR_FAST(t_Batch, double, 4, a_ShapeM1, FP64)
+	MAKE_TENSOR_FAST(t_Stored, double, 3, a_ShapeM2, FP64)
+	MAKE_TENSOR_FAST(t_Products, double, 4, a_ShapeM, FP64)
+	tnsnoise(&t_Batch, &u32_State);
+	tnsnoise(&t_Stored, &u32_State);
+	tensor_t t_Transposed;
+	CHECK(tnspermute(&t_Transposed, &t_Stored, a_Swap) == 0);
+	CHECK(tnsmatmul(&t_Products, &t_Batch, &t_Transposed) == 0);
+	sz_Wrong = 0;
+	for (size_t sz_Flat = 0; sz_Flat < t_Products.sz_ElementCount; ++sz_Flat) {
+		size_t a_Idx[4];
+		tnsindex(a_Idx, &t_Products, sz_Flat);
+		double f64_Sum = 0.0;
+		for (size_t sz_K = 0; sz_K < 4; ++sz_K) {
+			const size_t a_IdxA[4] = { a_Idx[0], 0, a_Idx[2], sz_K }, a_IdxB[3] = { a_Idx[1], sz_K, a_Idx[3] };
+			f64_Sum += tnsat(&t_Batch, a_IdxA) * tnsat(&t_Transposed, a_IdxB);
+		}
+		sz_Wrong += fabs(tnsat(&t_Products, a_Idx) - f64_Sum) > 1e-12;
+	}
+	CHECK(sz_Wrong == 0);
+	CHECK(tnsmatmul(&t_Products, &t_Batch, &t_Stored) != 0);
+
+	tnsdstry(&t_A);
+	tnsdstry(&t_B);
+	tnsdstry(&t_R);
+	tnsdstry(&t_Before);
+	tnsdstry(&t_Left);
+	tnsdstry(&t_Right);
+	tnsdstry(&t_Contracted);
+	tnsdstry(&t_Batch);
+	tnsdstry(&t_Stored);
+	tnsdstry(&t_Products);
+}
+
 int main(void) {
 	MAKE_VECTOR_FAST(vf32_MyVector, float, VECTOR_LEN, FP32)
 
 	vctdstry(&vf32_MyVector);
 
+	testknn();
+	testintegermodes();
+	testquant();
+	testqdots();
+	testplan();
+	testqr();
+	testtrans();
+	testrank();
+	testcapacity();
+	testfill();
+	testnuma();
+	testtiny();
+	testasync();
+	testcow();
+	testconv();
+	testtensor();
+
+	if (s32_Failures != 0) {
+		printf("%d CHECKS FAILED\n", s32_Failures);
+		return EXIT_FAILURE;
+	}
+
 	return EXIT_SUCCESS;
 }